@@ -0,0 +1,280 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// Throughput benchmark for the timeslice and microslice sources and sinks.
+/** In source mode, the items of the given source are drained into a null
+    sink. In sink mode, the given sink is fed from an in-memory generator
+    (synthetic timeslices or pattern generator microslices). The tool
+    reports the throughput in GB/s and items/s and the distribution of the
+    time spent per item (see ThroughputBenchmark). A chain of example
+    filters can be appended to a microslice source (see FilterChain). */
+
+#include "FilterChain.hpp"
+#include "FilterExamples.hpp"
+#include "FlesnetPatternGenerator.hpp"
+#include "MicrosliceInputArchive.hpp"
+#include "MicrosliceOutputArchive.hpp"
+#include "MicrosliceReceiver.hpp"
+#include "MicrosliceViewReceiver.hpp"
+#include "SyntheticTimesliceSource.hpp"
+#include "ThroughputBenchmark.hpp"
+#include "TimesliceInputArchive.hpp"
+#include "TimesliceMultiInputArchive.hpp"
+#include "TimesliceOutputArchive.hpp"
+#include "TimesliceReceiver.hpp"
+#include "TimesliceSubscriber.hpp"
+#include <boost/program_options.hpp>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace po = boost::program_options;
+
+namespace {
+
+const char* source_help =
+    "source to benchmark:\n"
+    "  synthetic             synthetic timeslices\n"
+    "  archive:<file>        timeslice archive (\"%n\": sequence)\n"
+    "  multi-archive:<files> several timeslice archives (';'-separated)\n"
+    "  shm:<id>[:<client>]   timeslice buffer in shared memory\n"
+    "  subscribe:<address>   timeslice publisher\n"
+    "  pattern               pattern generator microslices\n"
+    "  pattern-view          pattern generator microslices (zero-copy)\n"
+    "  ms-archive:<file>     microslice archive";
+
+const char* sink_help =
+    "sink to benchmark (fed from a generator):\n"
+    "  archive:<file>        timeslice archive (\"%n\": sequence)\n"
+    "  ms-archive:<file>     microslice archive (\"%n\": sequence)";
+
+/// Split a specification "type[:args]".
+std::pair<std::string, std::string> split_spec(const std::string& spec) {
+  auto pos = spec.find(':');
+  if (pos == std::string::npos) {
+    return {spec, std::string()};
+  }
+  return {spec.substr(0, pos), spec.substr(pos + 1)};
+}
+
+/// Pattern generator and microslice receiver as a microslice source.
+class PatternSource : public fles::MicrosliceSource {
+public:
+  explicit PatternSource(uint32_t microslice_size, bool zero_copy = false)
+      : generator_(data_buffer_size_exp,
+                   desc_buffer_size_exp,
+                   0,
+                   microslice_size,
+                   true) {
+    if (zero_copy) {
+      receiver_.reset(new fles::MicrosliceViewReceiver(generator_));
+    } else {
+      receiver_.reset(new fles::MicrosliceReceiver(generator_));
+    }
+  }
+
+  bool eos() const override { return receiver_->eos(); }
+
+private:
+  static constexpr std::size_t desc_buffer_size_exp = 19; // 512 ki entries
+  static constexpr std::size_t data_buffer_size_exp = 27; // 128 MiB
+
+  fles::Microslice* do_get() override { return receiver_->get().release(); }
+
+  FlesnetPatternGenerator generator_;
+  std::unique_ptr<fles::MicrosliceSource> receiver_;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    std::string source_spec;
+    std::string sink_spec;
+    uint64_t count = 0;
+    std::size_t batch_size = 1;
+    std::vector<std::string> filter_names;
+    std::size_t filter_queue = 0;
+    SyntheticTimesliceParameters synthetic;
+
+    po::options_description desc("Allowed options");
+    auto desc_add = desc.add_options();
+    desc_add("help,h", "produce help message");
+    desc_add("source,s",
+             po::value<std::string>(&source_spec)->value_name("<spec>"),
+             source_help);
+    desc_add("sink,o", po::value<std::string>(&sink_spec)->value_name("<spec>"),
+             sink_help);
+    desc_add("count,n", po::value<uint64_t>(&count)->value_name("<n>"),
+             "number of items to process (default: all, 1000 if generated)");
+    desc_add("batch,b",
+             po::value<std::size_t>(&batch_size)
+                 ->default_value(batch_size)
+                 ->value_name("<n>"),
+             "number of items per get_batch()/put_batch() call (1: use "
+             "get()/put())");
+
+    po::options_description gen_desc("Generator options");
+    auto gen_add = gen_desc.add_options();
+    gen_add("components,c",
+            po::value<uint32_t>(&synthetic.num_components)
+                ->default_value(synthetic.num_components)
+                ->value_name("<n>"),
+            "number of components per timeslice");
+    gen_add("microslice-size,m",
+            po::value<uint32_t>(&synthetic.microslice_size)
+                ->default_value(synthetic.microslice_size)
+                ->value_name("<bytes>"),
+            "content size of each microslice");
+    gen_add("core-microslices",
+            po::value<uint32_t>(&synthetic.core_microslices)
+                ->default_value(synthetic.core_microslices)
+                ->value_name("<n>"),
+            "number of core microslices per timeslice component");
+    gen_add("overlap",
+            po::value<uint32_t>(&synthetic.overlap_microslices)
+                ->default_value(synthetic.overlap_microslices)
+                ->value_name("<n>"),
+            "number of overlap microslices per timeslice component");
+    desc.add(gen_desc);
+
+    po::options_description filter_desc("Filter options");
+    auto filter_add = filter_desc.add_options();
+    filter_add("filter,f",
+               po::value<std::vector<std::string>>(&filter_names)
+                   ->value_name("<name>"),
+               "append a filter stage to a microslice source (override: "
+               "override the system id, combine: combine pairs of "
+               "microslices)");
+    filter_add("filter-queue",
+               po::value<std::size_t>(&filter_queue)
+                   ->default_value(filter_queue)
+                   ->value_name("<n>"),
+               "run each filter stage on a worker thread with a queue of the "
+               "given size (0: run all stages on the benchmark thread)");
+    desc.add(filter_desc);
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") != 0u ||
+        (source_spec.empty() == sink_spec.empty())) {
+      std::cout << "Usage: flesbench --source <spec> | --sink <spec> "
+                   "[options]\n"
+                << desc << std::endl;
+      return vm.count("help") != 0u ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    uint64_t generated_count = count != 0 ? count : 1000;
+    uint64_t max_items = count != 0 ? count : UINT64_MAX;
+    synthetic.num_timeslices = generated_count;
+
+    if (!source_spec.empty()) {
+      auto spec = split_spec(source_spec);
+      const std::string& type = spec.first;
+      const std::string& args = spec.second;
+
+      std::unique_ptr<fles::TimesliceSource> ts_source;
+      std::unique_ptr<fles::MicrosliceSource> ms_source;
+      if (type == "synthetic") {
+        ts_source.reset(new SyntheticTimesliceSource(synthetic));
+      } else if (type == "archive") {
+        if (args.find("%n") != std::string::npos) {
+          ts_source.reset(new fles::TimesliceInputArchiveSequence(args));
+        } else {
+          ts_source.reset(new fles::TimesliceInputArchive(args));
+        }
+      } else if (type == "multi-archive") {
+        ts_source.reset(new fles::TimesliceMultiInputArchive(args));
+      } else if (type == "shm") {
+        auto shm = split_spec(args);
+        int32_t client = shm.second.empty() ? -1 : std::stoi(shm.second);
+        ts_source.reset(new fles::TimesliceReceiver(shm.first, client));
+      } else if (type == "subscribe") {
+        ts_source.reset(new fles::TimesliceSubscriber(args));
+      } else if (type == "pattern" || type == "pattern-view") {
+        ms_source.reset(new PatternSource(synthetic.microslice_size,
+                                          type == "pattern-view"));
+        max_items = generated_count;
+      } else if (type == "ms-archive") {
+        if (args.find("%n") != std::string::npos) {
+          ms_source.reset(new fles::MicrosliceInputArchiveSequence(args));
+        } else {
+          ms_source.reset(new fles::MicrosliceInputArchive(args));
+        }
+      } else {
+        throw std::runtime_error("unknown source: " + type);
+      }
+
+      std::vector<std::unique_ptr<fles::MicrosliceFilter>> filters;
+      std::unique_ptr<fles::MicrosliceFilterChain> chain;
+      if (!filter_names.empty()) {
+        if (!ms_source) {
+          throw std::runtime_error("filters require a microslice source");
+        }
+        chain.reset(new fles::MicrosliceFilterChain(*ms_source));
+        for (const auto& name : filter_names) {
+          if (name == "override") {
+            filters.emplace_back(new fles::DescriptorOverrideFilter(
+                static_cast<uint8_t>(fles::SubsystemIdentifier::FLES),
+                static_cast<uint8_t>(
+                    fles::SubsystemFormatFLES::Uninitialized)));
+          } else if (name == "combine") {
+            filters.emplace_back(new fles::CombineContentsFilter());
+          } else {
+            throw std::runtime_error("unknown filter: " + name);
+          }
+          chain->add(*filters.back(), filter_queue);
+        }
+      }
+
+      ThroughputResult result;
+      if (ts_source) {
+        result = benchmark_source(*ts_source, max_items, batch_size);
+      } else if (chain) {
+        result = benchmark_source(*chain, max_items, batch_size);
+      } else {
+        result = benchmark_source(*ms_source, max_items, batch_size);
+      }
+      result.print(std::cout, "source " + source_spec);
+    } else {
+      auto spec = split_spec(sink_spec);
+      const std::string& type = spec.first;
+      const std::string& args = spec.second;
+      bool sequence = args.find("%n") != std::string::npos;
+
+      ThroughputResult result;
+      if (type == "archive") {
+        std::unique_ptr<fles::TimesliceSink> sink;
+        if (sequence) {
+          sink.reset(new fles::TimesliceOutputArchiveSequence(args));
+        } else {
+          sink.reset(new fles::TimesliceOutputArchive(args));
+        }
+        SyntheticTimesliceSource generator(synthetic);
+        result =
+            benchmark_sink(*sink, generator, generated_count, batch_size);
+      } else if (type == "ms-archive") {
+        std::unique_ptr<fles::MicrosliceSink> sink;
+        if (sequence) {
+          sink.reset(new fles::MicrosliceOutputArchiveSequence(args));
+        } else {
+          sink.reset(new fles::MicrosliceOutputArchive(args));
+        }
+        PatternSource generator(synthetic.microslice_size);
+        result =
+            benchmark_sink(*sink, generator, generated_count, batch_size);
+      } else {
+        throw std::runtime_error("unknown sink: " + type);
+      }
+      result.print(std::cout, "sink " + sink_spec);
+    }
+  } catch (std::exception& e) {
+    std::cerr << "FATAL: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
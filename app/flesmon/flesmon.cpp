@@ -0,0 +1,188 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// Terminal viewer for the shared memory telemetry (see Telemetry).
+/** Attaches read-only to the telemetry segments of all flib_server,
+    flesnet and tsclient processes on the node and periodically displays
+    the buffer occupancy, progress, rates and stall counters of their
+    channels. The observed processes are not affected. Rates are derived
+    from the difference between two consecutive samples. */
+
+#include "Telemetry.hpp"
+#include "Utility.hpp"
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace po = boost::program_options;
+
+namespace {
+
+volatile std::sig_atomic_t signal_status = 0;
+
+void signal_handler(int sig) { signal_status = sig; }
+
+/// Previous sample of a channel, used to calculate rates.
+struct Sample {
+  std::chrono::steady_clock::time_point time;
+  uint64_t items;
+  uint64_t bytes;
+};
+
+using SampleKey = std::pair<std::string, uint32_t>;
+
+std::string fill_bar(double fill) {
+  fill = std::min(std::max(fill, 0.0), 1.0);
+  std::ostringstream s;
+  s << "|" << bar_graph(std::vector<double>{fill, 1.0 - fill}, "#.", 10)
+    << "|" << std::setw(4) << static_cast<int>(std::round(fill * 100)) << "%";
+  return s.str();
+}
+
+void print_header() {
+  std::cout << std::left << std::setw(24) << "  channel" << std::right
+            << std::setw(17) << "data" << std::setw(17) << "desc"
+            << std::setw(12) << "items" << std::setw(12) << "items/s"
+            << std::setw(14) << "bytes/s" << std::setw(8) << "stalls"
+            << std::setw(8) << "queued" << std::setw(8) << "age/s"
+            << std::endl;
+}
+
+void print_channel(const TelemetryChannel& c,
+                   const SampleKey& key,
+                   std::map<SampleKey, Sample>& samples) {
+  auto now = std::chrono::steady_clock::now();
+  uint64_t items = c.items.load(std::memory_order_relaxed);
+  uint64_t bytes = c.bytes.load(std::memory_order_relaxed);
+
+  double item_rate = 0.0;
+  double byte_rate = 0.0;
+  auto it = samples.find(key);
+  if (it != samples.end()) {
+    double delta_t =
+        std::chrono::duration<double>(now - it->second.time).count();
+    if (delta_t > 0 && items >= it->second.items &&
+        bytes >= it->second.bytes) {
+      item_rate = static_cast<double>(items - it->second.items) / delta_t;
+      byte_rate = static_cast<double>(bytes - it->second.bytes) / delta_t;
+    }
+  }
+  samples[key] = Sample{now, items, bytes};
+
+  int64_t updated = c.updated.load(std::memory_order_relaxed);
+  int64_t system_now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+  double age = static_cast<double>(system_now - updated) * 1e-9;
+
+  std::cout << "  " << std::left << std::setw(22) << c.name << std::right
+            << std::setw(17)
+            << fill_bar(c.data.fill.load(std::memory_order_relaxed))
+            << std::setw(17)
+            << fill_bar(c.desc.fill.load(std::memory_order_relaxed))
+            << std::setw(12) << items << std::setw(12) << std::fixed
+            << std::setprecision(1) << item_rate << std::setw(14)
+            << human_readable_count(static_cast<uint64_t>(byte_rate))
+            << std::setw(8) << c.stalls.load(std::memory_order_relaxed)
+            << std::setw(8) << c.outstanding.load(std::memory_order_relaxed)
+            << std::setw(8) << std::setprecision(1) << age << std::endl;
+}
+
+/// Display all telemetry segments once.
+void display(int64_t pid,
+             bool remove_stale,
+             std::map<SampleKey, Sample>& samples) {
+  bool any = false;
+  for (const auto& name : Telemetry::segment_names()) {
+    if (pid != 0 && name != Telemetry::segment_name(pid)) {
+      continue;
+    }
+    try {
+      TelemetryView view(name);
+      const TelemetryHeader& h = view.header();
+      bool alive = view.alive();
+      if (!alive && remove_stale) {
+        boost::interprocess::shared_memory_object::remove(name.c_str());
+        continue;
+      }
+      any = true;
+      std::cout << std::endl
+                << h.process << " (pid " << h.pid << ")"
+                << (alive ? "" : " not running") << std::endl;
+      print_header();
+      for (uint32_t i = 0; i < view.num_channels(); ++i) {
+        print_channel(view.channel(i), SampleKey(name, i), samples);
+      }
+    } catch (std::exception& e) {
+      std::cerr << "warning: " << e.what() << std::endl;
+    }
+  }
+  if (!any) {
+    std::cout << "no telemetry segments found" << std::endl;
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    double interval = 1.0;
+    int64_t pid = 0;
+
+    po::options_description desc("Allowed options");
+    auto desc_add = desc.add_options();
+    desc_add("help,h", "produce help message");
+    desc_add("interval,i", po::value<double>(&interval)->value_name("<s>"),
+             "display update interval in seconds (default: 1)");
+    desc_add("pid,p", po::value<int64_t>(&pid)->value_name("<pid>"),
+             "only show the process with the given id");
+    desc_add("once,1", "display the current state once and exit");
+    desc_add("remove-stale",
+             "remove telemetry segments of processes no longer running");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") != 0u) {
+      std::cout << "Usage: flesmon [options]\n" << desc << std::endl;
+      return EXIT_SUCCESS;
+    }
+    if (interval <= 0) {
+      throw std::runtime_error("interval must be positive");
+    }
+    bool once = vm.count("once") != 0u;
+    bool remove_stale = vm.count("remove-stale") != 0u;
+
+    std::signal(SIGINT, signal_handler);
+    std::signal(SIGTERM, signal_handler);
+
+    std::map<SampleKey, Sample> samples;
+    if (once) {
+      display(pid, remove_stale, samples);
+      return EXIT_SUCCESS;
+    }
+    while (signal_status == 0) {
+      std::ostringstream title;
+      auto t = std::chrono::system_clock::to_time_t(
+          std::chrono::system_clock::now());
+      title << "flesmon - " << std::put_time(std::localtime(&t), "%F %T");
+      // clear screen and move the cursor home
+      std::cout << "\033[H\033[2J" << title.str() << std::endl;
+      display(pid, remove_stale, samples);
+      std::this_thread::sleep_for(std::chrono::duration<double>(interval));
+    }
+  } catch (std::exception& e) {
+    std::cerr << "error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
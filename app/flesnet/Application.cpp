@@ -3,23 +3,112 @@
 #include "Application.hpp"
 #include "ChildProcessManager.hpp"
 #include "FlesnetPatternGenerator.hpp"
+#include "NetworkRail.hpp"
+#include "SchedulingPolicy.hpp"
+#include "TimesliceSinkRegistry.hpp"
+#include "TraceRecorder.hpp"
 #include "Utility.hpp"
 #include "log.hpp"
 #include "shm_channel_client.hpp"
 #include <boost/algorithm/string.hpp>
 #include <boost/thread/future.hpp>
 #include <boost/thread/thread.hpp>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <functional>
 #include <random>
 #include <string>
+#include <utility>
+
+namespace {
+
+/// Records the CPU and wall-clock time of the calling thread from
+/// construction to destruction.
+class ThreadUsageRecorder {
+public:
+  explicit ThreadUsageRecorder(Application::ThreadUsage& usage)
+      : usage_(usage), cpu_begin_(thread_cpu_time()),
+        wall_begin_(std::chrono::steady_clock::now()) {}
+
+  ~ThreadUsageRecorder() {
+    usage_.cpu_time = thread_cpu_time() - cpu_begin_;
+    usage_.wall_time = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - wall_begin_)
+                           .count();
+  }
+
+  ThreadUsageRecorder(const ThreadUsageRecorder&) = delete;
+  void operator=(const ThreadUsageRecorder&) = delete;
+
+private:
+  static double thread_cpu_time() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) +
+           static_cast<double>(ts.tv_nsec) * 1e-9;
+  }
+
+  Application::ThreadUsage& usage_;
+  double cpu_begin_;
+  std::chrono::steady_clock::time_point wall_begin_;
+};
+
+/// Read the thread placement from the "cpu" and "node" parameters of an
+/// input or output specification.
+ThreadContainer::Placement placement(const InterfaceSpecification& spec) {
+  ThreadContainer::Placement p;
+  if (spec.param.count("cpu") != 0u) {
+    p.cpu = static_cast<int>(stou(spec.param.at("cpu")));
+  }
+  if (spec.param.count("node") != 0u) {
+    p.node = static_cast<int>(stou(spec.param.at("node")));
+  }
+  return p;
+}
+
+/// Create a trace recorder for a given component, if tracing is enabled.
+std::unique_ptr<TraceRecorder> trace_recorder(const Parameters& par,
+                                              const std::string& component) {
+  if (par.trace_prefix().empty()) {
+    return nullptr;
+  }
+  return std::unique_ptr<TraceRecorder>(
+      new TraceRecorder(TraceRecorder::filename(par.trace_prefix(), component),
+                        par.trace_sampling()));
+}
+
+} // namespace
 
 Application::Application(Parameters const& par,
                          volatile sig_atomic_t* signal_status)
     : par_(par), signal_status_(signal_status) {
+  for (const auto& uri : par_.metrics_uris()) {
+    metrics_exporters_.push_back(MetricsExporter::create(uri));
+  }
+
   zmq_context_ = std::unique_ptr<void, std::function<int(void*)>>(
       zmq_ctx_new(), zmq_ctx_destroy);
+  for (const auto& library : par_.processor_plugin_libraries()) {
+    TimesliceSinkRegistry::get().load_library(library);
+  }
+
+  bool placed = false;
+  for (unsigned i : par_.input_indexes()) {
+    input_placements_.push_back(placement(par_.inputs().at(i)));
+    placed = placed || !input_placements_.back().empty();
+  }
+  for (unsigned i : par_.output_indexes()) {
+    output_placements_.push_back(placement(par_.outputs().at(i)));
+    placed = placed || !output_placements_.back().empty();
+  }
+
   create_input_channel_senders();
   create_timeslice_buffers();
-  set_node();
+  // without explicit placement, keep the default memory binding
+  if (!placed) {
+    set_node();
+  }
 }
 
 Application::~Application() = default;
@@ -39,7 +128,8 @@ void Application::create_timeslice_buffers() {
     }
   }
 
-  for (unsigned i : par_.output_indexes()) {
+  for (size_t k = 0; k < par_.output_indexes().size(); ++k) {
+    unsigned i = par_.output_indexes().at(k);
     auto shm_identifier = par_.outputs().at(i).path.at(0);
     auto param = par_.outputs().at(i).param;
 
@@ -51,6 +141,15 @@ void Application::create_timeslice_buffers() {
     if (param.count("descsize") != 0u) {
       descsize = stou(param.at("descsize"));
     }
+    // optional per-consumer work item queues (0: single shared queue)
+    uint32_t consumers = 0;
+    if (param.count("consumers") != 0u) {
+      consumers = stou(param.at("consumers"));
+    }
+    uint32_t inflight = 0; // unlimited
+    if (param.count("inflight") != 0u) {
+      inflight = stou(param.at("inflight"));
+    }
 
     L_(info) << "timeslice buffer " << i
              << " size: " << human_readable_count(UINT64_C(1) << datasize)
@@ -59,11 +158,23 @@ void Application::create_timeslice_buffers() {
                     (UINT64_C(1) << descsize) *
                     sizeof(fles::TimesliceComponentDescriptor));
 
-    std::unique_ptr<TimesliceBuffer> tsb(
-        new TimesliceBuffer(shm_identifier, datasize, descsize, input_size));
+    const ThreadContainer::Placement& place = output_placements_.at(k);
+    L_(info) << "timeslice builder " << i << ": " << place.to_string();
 
-    start_processes(shm_identifier);
-    ChildProcessManager::get().allow_stop_processes(this);
+    set_preferred_node(place.effective_node());
+    std::unique_ptr<TimesliceBuffer> tsb(
+        new TimesliceBuffer(shm_identifier, datasize, descsize, input_size,
+                            consumers, inflight));
+    set_preferred_node(-1);
+    tsb->set_trace(trace_recorder(par_, "c" + std::to_string(i)));
+
+    if (!par_.processor_executable().empty()) {
+      start_processes(shm_identifier);
+      ChildProcessManager::get().allow_stop_processes(this);
+    }
+    if (!par_.processor_plugin().empty()) {
+      create_timeslice_processors(shm_identifier);
+    }
 
     if (par_.transport() == Transport::ZeroMQ) {
       std::unique_ptr<TimesliceBuilderZeromq> builder(
@@ -72,12 +183,19 @@ void Application::create_timeslice_buffers() {
                                      par_.max_timeslice_number(),
                                      signal_status_, zmq_context_.get()));
       timeslice_builders_zeromq_.push_back(std::move(builder));
+    } else if (par_.transport() == Transport::Shm) {
+      std::unique_ptr<TimesliceBuilderShm> builder(new TimesliceBuilderShm(
+          i, *tsb, *shm_transport_, par_.max_timeslice_number(),
+          signal_status_));
+      timeslice_builders_shm_.push_back(std::move(builder));
     } else if (par_.transport() == Transport::LibFabric) {
 #ifdef HAVE_LIBFABRIC
       std::unique_ptr<tl_libfabric::TimesliceBuilder> builder(
           new tl_libfabric::TimesliceBuilder(
               i, *tsb, par_.base_port() + i, input_size, par_.timeslice_size(),
-              signal_status_, false, par_.outputs().at(i).host));
+              signal_status_, false, par_.outputs().at(i).host,
+              SchedulingPolicy::create_announcer(par_.scheduling_policy(),
+                                                 output_size)));
       timeslice_builders_.push_back(std::move(builder));
 #else
       L_(fatal) << "flesnet built without LIBFABRIC support";
@@ -86,7 +204,9 @@ void Application::create_timeslice_buffers() {
 #ifdef HAVE_RDMA
       std::unique_ptr<TimesliceBuilder> builder(new TimesliceBuilder(
           i, *tsb, par_.base_port() + i, input_size, par_.timeslice_size(),
-          signal_status_, false, par_.monitor_uri()));
+          signal_status_, false, par_.monitor_uri(),
+          SchedulingPolicy::create_announcer(par_.scheduling_policy(),
+                                             output_size)));
       timeslice_builders_.push_back(std::move(builder));
 #else
       L_(fatal) << "flesnet built without RDMA support";
@@ -108,12 +228,29 @@ void Application::create_input_channel_senders() {
     output_services.push_back(std::to_string(par_.base_port() + i));
   }
 
+  std::vector<NetworkRail> rails;
+  for (const auto& rail : par_.rails()) {
+    rails.emplace_back(rail);
+  }
+
+  if (par_.transport() == Transport::Shm) {
+    // local_only() is ensured, so all inputs are part of this process
+    shm_transport_.reset(
+        new ShmTransport(static_cast<uint32_t>(par_.inputs().size()),
+                         static_cast<uint32_t>(par_.outputs().size()),
+                         par_.timeslice_size()));
+  }
+
   for (size_t c = 0; c < par_.input_indexes().size(); ++c) {
     unsigned index = par_.input_indexes().at(c);
 
     auto scheme = par_.inputs().at(index).scheme;
     auto param = par_.inputs().at(index).param;
 
+    // allocate the input buffer on the NUMA node of the input thread
+    const ThreadContainer::Placement& place = input_placements_.at(c);
+    set_preferred_node(place.effective_node());
+
     if (scheme == "shm") {
       auto shm_identifier = par_.inputs().at(index).path.at(0);
       auto channel = std::stoul(par_.inputs().at(index).path.at(1));
@@ -175,6 +312,14 @@ void Application::create_input_channel_senders() {
       L_(fatal) << "unknown input scheme: " << scheme;
     }
 
+    if (data_sources_.size() > c) {
+      L_(info) << "input " << index << ": " << place.to_string()
+               << ", buffer on NUMA node "
+               << NetworkRail::numa_node_of_memory(
+                      data_sources_.at(c)->data_buffer().ptr());
+    }
+    set_preferred_node(-1);
+
     uint32_t overlap_size = 1;
     if (param.count("overlap") != 0u) {
       overlap_size = stou(param.at("overlap"));
@@ -191,13 +336,21 @@ void Application::create_input_channel_senders() {
           par_.timeslice_size(), overlap_size, par_.max_timeslice_number(),
           signal_status_, zmq_context_.get()));
       component_senders_zeromq_.push_back(std::move(sender));
+    } else if (par_.transport() == Transport::Shm) {
+      shm_transport_->set_input(index, *data_sources_.at(c), overlap_size);
+      std::unique_ptr<ComponentSenderShm> sender(new ComponentSenderShm(
+          index, *shm_transport_, par_.max_timeslice_number(),
+          signal_status_));
+      component_senders_shm_.push_back(std::move(sender));
     } else if (par_.transport() == Transport::LibFabric) {
 #ifdef HAVE_LIBFABRIC
       std::unique_ptr<tl_libfabric::InputChannelSender> sender(
           new tl_libfabric::InputChannelSender(
               index, *(data_sources_.at(c).get()), output_hosts,
               output_services, par_.timeslice_size(), overlap_size,
-              par_.max_timeslice_number(), par_.inputs().at(c).host));
+              par_.max_timeslice_number(), par_.inputs().at(c).host,
+              par_.scheduling_policy(), rails));
+      sender->set_trace(trace_recorder(par_, "i" + std::to_string(index)));
       input_channel_senders_.push_back(std::move(sender));
 #else
       L_(fatal) << "flesnet built without LIBFABRIC support";
@@ -207,58 +360,137 @@ void Application::create_input_channel_senders() {
       std::unique_ptr<InputChannelSender> sender(new InputChannelSender(
           index, *(data_sources_.at(c).get()), output_hosts, output_services,
           par_.timeslice_size(), overlap_size, par_.max_timeslice_number(),
-          par_.monitor_uri()));
+          par_.monitor_uri(), par_.scheduling_policy(), rails));
+      sender->set_trace(trace_recorder(par_, "i" + std::to_string(index)));
       input_channel_senders_.push_back(std::move(sender));
 #else
       L_(fatal) << "flesnet built without RDMA support";
 #endif
     }
   }
+
+#if defined(HAVE_RDMA) || defined(HAVE_LIBFABRIC)
+  // distribute input channels over a given number of polling threads
+  uint32_t threads = par_.input_threads();
+  if (threads > 0 && !input_channel_senders_.empty()) {
+    std::vector<int> cpus = par_.input_thread_cpus();
+    for (uint32_t t = 0; t < threads && t < input_channel_senders_.size();
+         ++t) {
+      int cpu = cpus.empty() ? -1 : cpus.at(t);
+      input_channel_sender_groups_.emplace_back(new WorkerGroup(cpu));
+    }
+    for (size_t c = 0; c < input_channel_senders_.size(); ++c) {
+      input_channel_sender_groups_.at(c % threads)
+          ->add(*input_channel_senders_.at(c));
+    }
+    for (size_t t = 0; t < input_channel_sender_groups_.size(); ++t) {
+      L_(info) << "input thread " << t << ": "
+               << input_channel_sender_groups_[t]->size()
+               << " input channels"
+               << (cpus.empty() ? std::string()
+                                : ", CPU " + std::to_string(cpus.at(t)));
+    }
+  }
+#endif
 }
 
 void Application::run() {
+  bool benchmark = !par_.benchmark_result().empty();
+
 // Do not spawn additional thread if only one is needed, simplifies
 // debugging
 #if defined(HAVE_RDMA) || defined(HAVE_LIBFABRIC)
-  if (timeslice_builders_.size() == 1 && input_channel_senders_.empty()) {
+  if (!benchmark && timeslice_builders_.size() == 1 &&
+      input_channel_senders_.empty() && timeslice_processors_.empty()) {
     L_(debug) << "using existing thread for single timeslice builder";
+    set_placement(output_placements_.at(0));
     (*timeslice_builders_[0])();
     return;
   };
-  if (input_channel_senders_.size() == 1 && timeslice_builders_.empty()) {
+  if (!benchmark && input_channel_senders_.size() == 1 &&
+      timeslice_builders_.empty()) {
     L_(debug) << "using existing thread for single input channel sender";
+    set_placement(input_placements_.at(0));
     (*input_channel_senders_[0])();
     return;
   };
 #endif
 
-  // FIXME: temporary code, need to implement interrupt
-  boost::thread_group threads;
-  std::vector<boost::unique_future<void>> futures;
-  bool stop = false;
+  std::vector<std::pair<std::string, std::function<void()>>> workers;
+
+  // wrap a worker to run on its configured CPU and NUMA node
+  auto placed = [](std::function<void()> worker,
+                   ThreadContainer::Placement place) {
+    return std::function<void()>([worker, place]() {
+      set_placement(place);
+      worker();
+    });
+  };
 
 #if defined(HAVE_RDMA) || defined(HAVE_LIBFABRIC)
-  for (auto& buffer : timeslice_builders_) {
-    boost::packaged_task<void> task(std::ref(*buffer));
-    futures.push_back(task.get_future());
-    threads.add_thread(new boost::thread(std::move(task)));
+  for (size_t k = 0; k < timeslice_builders_.size(); ++k) {
+    workers.emplace_back(
+        "timeslice_builder",
+        placed(std::ref(*timeslice_builders_[k]), output_placements_.at(k)));
   }
 
-  for (auto& buffer : input_channel_senders_) {
-    boost::packaged_task<void> task(std::ref(*buffer));
-    futures.push_back(task.get_future());
-    threads.add_thread(new boost::thread(std::move(task)));
+  if (input_channel_sender_groups_.empty()) {
+    for (size_t c = 0; c < input_channel_senders_.size(); ++c) {
+      workers.emplace_back("input_channel_sender",
+                           placed(std::ref(*input_channel_senders_[c]),
+                                  input_placements_.at(c)));
+    }
+  } else {
+    for (auto& group : input_channel_sender_groups_) {
+      workers.emplace_back("input_channel_sender_group", std::ref(*group));
+    }
   }
 #endif
 
-  for (auto& buffer : timeslice_builders_zeromq_) {
-    boost::packaged_task<void> task(std::ref(*buffer));
-    futures.push_back(task.get_future());
-    threads.add_thread(new boost::thread(std::move(task)));
+  for (size_t k = 0; k < timeslice_builders_zeromq_.size(); ++k) {
+    workers.emplace_back("timeslice_builder",
+                         placed(std::ref(*timeslice_builders_zeromq_[k]),
+                                output_placements_.at(k)));
+  }
+
+  for (size_t c = 0; c < component_senders_zeromq_.size(); ++c) {
+    workers.emplace_back("component_sender",
+                         placed(std::ref(*component_senders_zeromq_[c]),
+                                input_placements_.at(c)));
+  }
+
+  for (size_t k = 0; k < timeslice_builders_shm_.size(); ++k) {
+    workers.emplace_back("timeslice_builder",
+                         placed(std::ref(*timeslice_builders_shm_[k]),
+                                output_placements_.at(k)));
+  }
+
+  for (size_t c = 0; c < component_senders_shm_.size(); ++c) {
+    workers.emplace_back("component_sender",
+                         placed(std::ref(*component_senders_shm_[c]),
+                                input_placements_.at(c)));
+  }
+
+  for (auto& processor : timeslice_processors_) {
+    workers.emplace_back("timeslice_processor", std::ref(*processor));
   }
 
-  for (auto& buffer : component_senders_zeromq_) {
-    boost::packaged_task<void> task(std::ref(*buffer));
+  // FIXME: temporary code, need to implement interrupt
+  boost::thread_group threads;
+  std::vector<boost::unique_future<void>> futures;
+  bool stop = false;
+
+  auto time_begin = std::chrono::steady_clock::now();
+
+  thread_usage_.resize(workers.size());
+  for (size_t i = 0; i < workers.size(); ++i) {
+    ThreadUsage* usage = &thread_usage_[i];
+    usage->name = workers[i].first;
+    std::function<void()> worker = workers[i].second;
+    boost::packaged_task<void> task([usage, worker]() {
+      ThreadUsageRecorder recorder(*usage);
+      worker();
+    });
     futures.push_back(task.get_future());
     threads.add_thread(new boost::thread(std::move(task)));
   }
@@ -280,6 +512,62 @@ void Application::run() {
   }
 
   threads.join_all();
+
+  if (benchmark) {
+    double runtime = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - time_begin)
+                         .count();
+    write_benchmark_result(par_.benchmark_result(), runtime);
+  }
+}
+
+void Application::write_benchmark_result(const std::string& filename,
+                                         double runtime) const {
+  std::ofstream out(filename);
+  if (!out) {
+    L_(error) << "cannot write benchmark result to " << filename;
+    return;
+  }
+
+  uint64_t timeslices = 0;
+  uint64_t bytes = 0;
+  LatencyHistogram latency;
+  for (const auto& tsb : timeslice_buffers_) {
+    timeslices += tsb->num_timeslices();
+    bytes += tsb->num_bytes();
+    latency += tsb->latency_histogram();
+  }
+  auto us = [&latency](double q) {
+    return std::chrono::duration<double, std::micro>(latency.quantile(q))
+        .count();
+  };
+
+  out << "{\n";
+  out << "  \"transport\": \"" << par_.transport() << "\",\n";
+  out << "  \"inputs\": " << par_.input_indexes().size() << ",\n";
+  out << "  \"outputs\": " << par_.output_indexes().size() << ",\n";
+  out << "  \"timeslice_size\": " << par_.timeslice_size() << ",\n";
+  out << "  \"runtime_s\": " << runtime << ",\n";
+  out << "  \"timeslices\": " << timeslices << ",\n";
+  out << "  \"bytes\": " << bytes << ",\n";
+  out << "  \"timeslice_rate_hz\": "
+      << static_cast<double>(timeslices) / runtime << ",\n";
+  out << "  \"throughput_bytes_per_s\": "
+      << static_cast<double>(bytes) / runtime << ",\n";
+  out << "  \"latency_us\": {\"p50\": " << us(0.5) << ", \"p90\": " << us(0.9)
+      << ", \"p99\": " << us(0.99) << ", \"p999\": " << us(0.999)
+      << ", \"max\": " << us(1.0) << "},\n";
+  out << "  \"threads\": [";
+  for (size_t i = 0; i < thread_usage_.size(); ++i) {
+    const ThreadUsage& t = thread_usage_[i];
+    double utilization = t.wall_time > 0 ? t.cpu_time / t.wall_time : 0;
+    out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << t.name
+        << "\", \"cpu_s\": " << t.cpu_time << ", \"wall_s\": " << t.wall_time
+        << ", \"utilization\": " << utilization << "}";
+  }
+  out << "\n  ]\n}\n";
+
+  L_(info) << "benchmark result written to " << filename;
 }
 
 void Application::start_processes(const std::string& shared_memory_identifier) {
@@ -300,3 +588,20 @@ void Application::start_processes(const std::string& shared_memory_identifier) {
     ChildProcessManager::get().start_process(cp);
   }
 }
+
+void Application::create_timeslice_processors(
+    const std::string& shared_memory_identifier) {
+  // consumer indexes following those of the external processor instances
+  uint32_t first_index = 0;
+  if (!par_.processor_executable().empty()) {
+    first_index = par_.processor_instances();
+  }
+  for (uint32_t i = 0; i < par_.processor_threads(); ++i) {
+    uint32_t index = first_index + i;
+    std::unique_ptr<TimesliceProcessor> processor(new TimesliceProcessor(
+        shared_memory_identifier, index, par_.processor_plugin()));
+    timeslice_processors_.push_back(std::move(processor));
+  }
+  L_(info) << "in-process timeslice processor: " << par_.processor_plugin()
+           << " (" << par_.processor_threads() << " threads)";
+}
@@ -1,12 +1,18 @@
 // Copyright 2012-2016 Jan de Cuveland <cmail@cuveland.de>
 #pragma once
 
+#include "ComponentSenderShm.hpp"
 #include "ComponentSenderZeromq.hpp"
 #include "ConnectionGroupWorker.hpp"
+#include "MetricsExporter.hpp"
 #include "Parameters.hpp"
 #include "ThreadContainer.hpp"
+#include "ShmTransport.hpp"
 #include "TimesliceBuffer.hpp"
+#include "TimesliceBuilderShm.hpp"
 #include "TimesliceBuilderZeromq.hpp"
+#include "TimesliceProcessor.hpp"
+#include "WorkerGroup.hpp"
 #include "shm_device_client.hpp"
 #if defined(HAVE_RDMA)
 #include "fles_rdma/InputChannelSender.hpp"
@@ -19,6 +25,8 @@
 #include <csignal>
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 /// %Application base class.
 /** The Application object represents an instance of the running
@@ -38,6 +46,13 @@ public:
   Application(const Application&) = delete;
   void operator=(const Application&) = delete;
 
+  /// CPU usage of a worker thread.
+  struct ThreadUsage {
+    std::string name;
+    double cpu_time = 0;  ///< CPU time in seconds
+    double wall_time = 0; ///< Wall-clock time in seconds
+  };
+
 private:
   void create_timeslice_buffers();
   void create_input_channel_senders();
@@ -46,6 +61,9 @@ private:
   Parameters const& par_;
   volatile sig_atomic_t* signal_status_;
 
+  /// The metrics exporters (destroyed last to publish the final values).
+  std::vector<std::unique_ptr<MetricsExporter>> metrics_exporters_;
+
   // Input node application
   std::map<std::string, std::shared_ptr<flib_shm_device_client>> shm_devices_;
 
@@ -57,6 +75,9 @@ private:
   /// The application's RDMA or libfabric transport objects
   std::vector<std::unique_ptr<ConnectionGroupWorker>> timeslice_builders_;
   std::vector<std::unique_ptr<ConnectionGroupWorker>> input_channel_senders_;
+
+  /// The threads driving several input channel senders each (if configured)
+  std::vector<std::unique_ptr<WorkerGroup>> input_channel_sender_groups_;
 #endif
 
   /// The application's ZeroMQ context
@@ -67,5 +88,28 @@ private:
       timeslice_builders_zeromq_;
   std::vector<std::unique_ptr<ComponentSenderZeromq>> component_senders_zeromq_;
 
+  /// The application's intra-node transport objects
+  std::unique_ptr<ShmTransport> shm_transport_;
+  std::vector<std::unique_ptr<TimesliceBuilderShm>> timeslice_builders_shm_;
+  std::vector<std::unique_ptr<ComponentSenderShm>> component_senders_shm_;
+
+  /// The application's in-process timeslice processors
+  std::vector<std::unique_ptr<TimesliceProcessor>> timeslice_processors_;
+
   void start_processes(const std::string& shared_memory_identifier);
+
+  void create_timeslice_processors(const std::string& shared_memory_identifier);
+
+  /// Thread placement of the local inputs (in order of input_indexes()).
+  std::vector<Placement> input_placements_;
+
+  /// Thread placement of the local outputs (in order of output_indexes()).
+  std::vector<Placement> output_placements_;
+
+  /// Per-thread CPU usage, recorded when the worker threads finish.
+  std::vector<ThreadUsage> thread_usage_;
+
+  /// Write throughput, latency and CPU usage as JSON to a file.
+  void write_benchmark_result(const std::string& filename,
+                              double runtime) const;
 };
@@ -3,6 +3,8 @@
 #include "Parameters.hpp"
 #include "GitRevision.hpp"
 #include "MicrosliceDescriptor.hpp"
+#include "NetworkRail.hpp"
+#include "SchedulingPolicy.hpp"
 #include "TimesliceComponentDescriptor.hpp"
 #include "Utility.hpp"
 #include "log.hpp"
@@ -27,6 +29,8 @@ std::istream& operator>>(std::istream& in, Transport& transport) {
     transport = Transport::LibFabric;
   } else if (token == "zeromq" || token == "z") {
     transport = Transport::ZeroMQ;
+  } else if (token == "shm" || token == "s") {
+    transport = Transport::Shm;
   } else {
     throw po::invalid_option_value(token);
   }
@@ -44,6 +48,9 @@ std::ostream& operator<<(std::ostream& out, const Transport& transport) {
   case Transport::ZeroMQ:
     out << "ZeroMQ";
     break;
+  case Transport::Shm:
+    out << "Shm";
+    break;
   }
   return out;
 }
@@ -96,6 +103,12 @@ void Parameters::parse_options(int argc, char* argv[]) {
               po::value<std::string>(&monitor_uri_)
                   ->implicit_value("http://login:8086/"),
               "publish flesnet status to InfluxDB");
+  generic_add("metrics",
+              po::value<std::vector<std::string>>(&metrics_uris_)
+                  ->multitoken()
+                  ->value_name("<uri> ..."),
+              "export metrics (http://<address>:<port>, "
+              "udp://<host>:<port> or file://<path>)");
   generic_add("help,h", "display this help and exit");
   generic_add("version,V", "output version information and exit");
 
@@ -136,6 +149,34 @@ void Parameters::parse_options(int argc, char* argv[]) {
                  ->default_value(processor_instances_)
                  ->value_name("<n>"),
              "number of instances of the timeslice processor executable");
+  config_add("processor-plugin",
+             po::value<std::string>(&processor_plugin_)
+                 ->value_name("<name>[:<args>]"),
+             "name of the timeslice sink to run in-process as timeslice "
+             "processor");
+  config_add("processor-plugin-library",
+             po::value<std::vector<std::string>>(&processor_plugin_libraries_)
+                 ->multitoken()
+                 ->value_name("<path> ..."),
+             "load timeslice sink plugins from shared library");
+  config_add("processor-threads",
+             po::value<uint32_t>(&processor_threads_)
+                 ->default_value(processor_threads_)
+                 ->value_name("<n>"),
+             "number of threads running the in-process timeslice processor");
+  config_add("input-threads",
+             po::value<uint32_t>(&input_threads_)
+                 ->default_value(input_threads_)
+                 ->value_name("<n>"),
+             "number of threads driving the input channel senders, input "
+             "channel i is served by thread i mod n (RDMA, LibFabric; 0: one "
+             "thread per input channel)");
+  config_add("input-thread-cpus",
+             po::value<std::vector<int>>(&input_thread_cpus_)
+                 ->multitoken()
+                 ->value_name("<cpu> ..."),
+             "CPUs to pin the input channel sender threads to (with "
+             "--input-threads)");
   config_add("base-port",
              po::value<uint32_t>(&base_port_)
                  ->default_value(base_port_)
@@ -146,7 +187,34 @@ void Parameters::parse_options(int argc, char* argv[]) {
                  ->default_value(transport_)
                  ->value_name("<id>"),
              "select transport implementation; possible values "
-             "(case-insensitive) are: RDMA, LibFabric, ZeroMQ");
+             "(case-insensitive) are: RDMA, LibFabric, ZeroMQ, Shm "
+             "(intra-node, all inputs and outputs in this process)");
+  config_add("scheduling-policy",
+             po::value<std::string>(&scheduling_policy_)
+                 ->default_value(scheduling_policy_)
+                 ->value_name("<policy>"),
+             "assignment of timeslices to compute nodes (RDMA, LibFabric); "
+             "possible values are: round-robin, weighted:<w0>,<w1>,..., "
+             "occupancy");
+  config_add("rail",
+             po::value<std::vector<std::string>>(&rails_)
+                 ->multitoken()
+                 ->value_name("<address>[@<numa node>] ..."),
+             "local addresses of the network interfaces to distribute "
+             "compute node connections over (RDMA, LibFabric)");
+  config_add("benchmark-result",
+             po::value<std::string>(&benchmark_result_)->value_name("<file>"),
+             "write throughput, timeslice latency and per-thread CPU usage "
+             "as JSON to file when done");
+  config_add("trace",
+             po::value<std::string>(&trace_prefix_)->value_name("<prefix>"),
+             "record per-timeslice trace points to files named "
+             "<prefix>.<component>.trace (see tstrace)");
+  config_add("trace-sampling",
+             po::value<uint64_t>(&trace_sampling_)
+                 ->default_value(trace_sampling_)
+                 ->value_name("<n>"),
+             "trace only every n-th timeslice");
 
   po::options_description cmdline_options("Allowed options");
   cmdline_options.add(generic).add(config);
@@ -258,7 +326,38 @@ void Parameters::parse_options(int argc, char* argv[]) {
     }
   }
 
-  if (!outputs_.empty() && processor_executable_.empty()) {
+  if (transport_ == Transport::Shm && !local_only()) {
+    throw ParametersException(
+        "shm transport requires all inputs and outputs in this process");
+  }
+
+  try {
+    SchedulingPolicy::create(scheduling_policy_,
+                             static_cast<uint32_t>(outputs_.size()));
+  } catch (std::exception& e) {
+    throw ParametersException(e.what());
+  }
+
+  if (!input_thread_cpus_.empty() &&
+      input_thread_cpus_.size() != input_threads_) {
+    throw ParametersException(
+        "number of input thread CPUs does not match number of input threads");
+  }
+
+  if (trace_sampling_ == 0) {
+    throw ParametersException("trace sampling must be at least 1");
+  }
+
+  for (const auto& rail : rails_) {
+    try {
+      NetworkRail{rail};
+    } catch (std::exception& e) {
+      throw ParametersException(e.what());
+    }
+  }
+
+  if (!outputs_.empty() && processor_executable_.empty() &&
+      processor_plugin_.empty()) {
     throw ParametersException("processor executable not specified");
   }
 
@@ -283,6 +382,7 @@ void Parameters::parse_options(int argc, char* argv[]) {
     if (input_index == 0) {
       L_(info) << "timeslice size: " << timeslice_size_ << " microslices";
       L_(info) << "number of timeslices: " << max_timeslice_number_;
+      L_(info) << "scheduling policy: " << scheduling_policy_;
     }
   }
 }
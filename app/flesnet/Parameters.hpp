@@ -26,7 +26,7 @@ struct InterfaceSpecification {
 };
 
 /// Transport implementation enum.
-enum class Transport { RDMA, LibFabric, ZeroMQ };
+enum class Transport { RDMA, LibFabric, ZeroMQ, Shm };
 
 std::istream& operator>>(std::istream& in, Transport& transport);
 std::ostream& operator<<(std::ostream& out, const Transport& transport);
@@ -45,6 +45,9 @@ public:
 
   std::string monitor_uri() const { return monitor_uri_; }
 
+  /// Retrieve the list of metrics exporter URIs.
+  std::vector<std::string> metrics_uris() const { return metrics_uris_; }
+
   /// Retrieve the global timeslice size in number of microslices.
   uint32_t timeslice_size() const { return timeslice_size_; }
 
@@ -57,12 +60,44 @@ public:
   /// Retrieve the number of instances of the timeslice processor executable.
   uint32_t processor_instances() const { return processor_instances_; }
 
+  /// Retrieve the specification of the in-process timeslice processor.
+  std::string processor_plugin() const { return processor_plugin_; }
+
+  /// Retrieve the list of timeslice processor plugin libraries.
+  std::vector<std::string> processor_plugin_libraries() const {
+    return processor_plugin_libraries_;
+  }
+
+  /// Retrieve the number of in-process timeslice processor threads.
+  uint32_t processor_threads() const { return processor_threads_; }
+
+  /// Retrieve the number of threads driving the input channel senders.
+  uint32_t input_threads() const { return input_threads_; }
+
+  /// Retrieve the list of CPUs to pin the input channel sender threads to.
+  std::vector<int> input_thread_cpus() const { return input_thread_cpus_; }
+
   /// Retrieve the global base port.
   uint32_t base_port() const { return base_port_; }
 
   /// Retrieve the selected transport implementation.
   Transport transport() const { return transport_; }
 
+  /// Retrieve the timeslice scheduling policy specification.
+  std::string scheduling_policy() const { return scheduling_policy_; }
+
+  /// Retrieve the list of local network rail specifications.
+  std::vector<std::string> rails() const { return rails_; }
+
+  /// Retrieve the name of the file to write benchmark results to.
+  std::string benchmark_result() const { return benchmark_result_; }
+
+  /// Retrieve the file name prefix for timeslice traces (empty: disabled).
+  std::string trace_prefix() const { return trace_prefix_; }
+
+  /// Retrieve the timeslice trace sampling factor.
+  uint64_t trace_sampling() const { return trace_sampling_; }
+
   /// Retrieve the list of participating inputs.
   std::vector<InterfaceSpecification> inputs() const { return inputs_; }
 
@@ -86,6 +121,9 @@ private:
 
   std::string monitor_uri_;
 
+  /// The list of metrics exporter URIs.
+  std::vector<std::string> metrics_uris_;
+
   /// The global timeslice size in number of microslices.
   uint32_t timeslice_size_ = 100;
 
@@ -98,12 +136,43 @@ private:
   /// The number of instances of the timeslice processor executable.
   uint32_t processor_instances_ = 1;
 
+  /// The specification of the in-process timeslice processor.
+  std::string processor_plugin_;
+
+  /// The list of timeslice processor plugin libraries.
+  std::vector<std::string> processor_plugin_libraries_;
+
+  /// The number of in-process timeslice processor threads.
+  uint32_t processor_threads_ = 1;
+
+  /// The number of threads driving the input channel senders (0: one thread
+  /// per input channel).
+  uint32_t input_threads_ = 0;
+
+  /// The list of CPUs to pin the input channel sender threads to.
+  std::vector<int> input_thread_cpus_;
+
   /// The global base port.
   uint32_t base_port_ = 20079;
 
   /// The selected transport implementation.
   Transport transport_ = Transport::RDMA;
 
+  /// The timeslice scheduling policy specification.
+  std::string scheduling_policy_ = "round-robin";
+
+  /// The list of local network rail specifications.
+  std::vector<std::string> rails_;
+
+  /// The name of the file to write benchmark results to.
+  std::string benchmark_result_;
+
+  /// The file name prefix for timeslice traces.
+  std::string trace_prefix_;
+
+  /// The timeslice trace sampling factor.
+  uint64_t trace_sampling_ = 1;
+
   /// The list of participating inputs.
   std::vector<InterfaceSpecification> inputs_;
 
@@ -1,11 +1,28 @@
 // Copyright 2015 Dirk Hutter
 
 #include "ChildProcessManager.hpp"
+#include "emu_device.hpp"
 #include "log.hpp"
 #include "parameters.hpp"
 #include "shm_device_server.hpp"
 #include <boost/algorithm/string.hpp>
 #include <csignal>
+#ifdef HAVE_PDA
+#include "flib_device_flesin.hpp"
+#endif
+
+#ifdef HAVE_PDA
+using flib_shm_device_server =
+    shm_device_server<fles::MicrosliceDescriptor,
+                      uint8_t,
+                      flib::flib_device,
+                      flib::flib_link>;
+#endif
+
+using emu_shm_device_server = shm_device_server<fles::MicrosliceDescriptor,
+                                                uint8_t,
+                                                flib::emu_device,
+                                                flib::emu_link>;
 
 namespace {
 volatile std::sig_atomic_t signal_status = 0;
@@ -26,6 +43,17 @@ void start_exec(const std::string& executable,
   ChildProcessManager::get().start_process(cp);
 }
 
+template <typename T_SERVER, typename T_DEVICE>
+void run_server(T_DEVICE* flib, parameters& par) {
+  T_SERVER server(flib, par.shm(), par.data_buffer_size_exp(),
+                  par.desc_buffer_size_exp(), par.etcd(), &signal_status);
+  if (!par.exec().empty()) {
+    start_exec(par.exec(), par.shm());
+    ChildProcessManager::get().allow_stop_processes(nullptr);
+  }
+  server.run();
+}
+
 int main(int argc, char* argv[]) {
 
   std::signal(SIGINT, signal_handler);
@@ -35,6 +63,15 @@ int main(int argc, char* argv[]) {
 
     parameters par(argc, argv);
 
+    if (par.emu_links() != 0) {
+      std::unique_ptr<flib::emu_device> flib(
+          new flib::emu_device(par.emu_links(), par.emu_config()));
+      L_(info) << "using FLIB: " << flib->print_devinfo();
+      run_server<emu_shm_device_server>(flib.get(), par);
+      return EXIT_SUCCESS;
+    }
+
+#ifdef HAVE_PDA
     std::unique_ptr<flib::flib_device> flib;
     if (par.flib_autodetect()) {
       flib = std::unique_ptr<flib::flib_device_flesin>(
@@ -45,16 +82,10 @@ int main(int argc, char* argv[]) {
                                        par.flib_addr().func));
     }
     L_(info) << "using FLIB: " << flib->print_devinfo();
-
-    // create server
-    flib_shm_device_server server(
-        flib.get(), par.shm(), par.data_buffer_size_exp(),
-        par.desc_buffer_size_exp(), par.etcd(), &signal_status);
-    if (!par.exec().empty()) {
-      start_exec(par.exec(), par.shm());
-      ChildProcessManager::get().allow_stop_processes(nullptr);
-    }
-    server.run();
+    run_server<flib_shm_device_server>(flib.get(), par);
+#else
+    throw ParametersException("built without PDA, only --emulate is available");
+#endif
 
   } catch (std::exception const& e) {
     L_(fatal) << "exception: " << e.what();
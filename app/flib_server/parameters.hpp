@@ -4,7 +4,7 @@
 
 #include "MicrosliceDescriptor.hpp"
 #include "Utility.hpp"
-#include "flib.h"
+#include "emu_dma_channel.hpp"
 #include "log.hpp"
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/program_options.hpp>
@@ -79,6 +79,8 @@ public:
   size_t desc_buffer_size_exp() { return _desc_buffer_size_exp; }
   etcd_config_t etcd() const { return _etcd; }
   std::string exec() const { return _exec; }
+  size_t emu_links() const { return _emu_links; }
+  flib::emu_link_config emu_config() const { return _emu_config; }
 
   std::string print_buffer_info() {
     std::stringstream ss;
@@ -140,6 +142,18 @@ private:
                "base path for this instance, leave empty to not use etcd");
     config_add("exec,e", po::value<std::string>(&_exec)->value_name("<string>"),
                "name of an executable to run after startup");
+    config_add("emulate", po::value<size_t>(&_emu_links)->value_name("<n>"),
+               "use a software emulation with <n> links instead of a FLIB");
+    config_add("emu-content-size",
+               po::value<uint32_t>(&_emu_config.content_size)
+                   ->default_value(_emu_config.content_size)
+                   ->value_name("<n>"),
+               "content size of emulated microslices in bytes");
+    config_add("emu-rate",
+               po::value<double>(&_emu_config.rate)
+                   ->default_value(_emu_config.rate)
+                   ->value_name("<r>"),
+               "emulated microslices per second and link (0: unlimited)");
 
     po::options_description cmdline_options("Allowed options");
     cmdline_options.add(generic).add(config);
@@ -178,7 +192,12 @@ private:
                           static_cast<severity_level>(log_syslog));
     }
 
-    if (vm.count("flib-addr") != 0u) {
+    if (_emu_links != 0) {
+      if (vm.count("flib-addr") != 0u) {
+        throw ParametersException("flib-addr cannot be used with emulate");
+      }
+      L_(info) << "FLIB emulation: " << _emu_links << " links";
+    } else if (vm.count("flib-addr") != 0u) {
       _flib_addr = vm["flib-addr"].as<pci_addr>();
       _flib_autodetect = false;
       L_(debug) << "FLIB address: " << std::hex << std::setw(2)
@@ -206,4 +225,6 @@ private:
   size_t _desc_buffer_size_exp;
   etcd_config_t _etcd;
   std::string _exec;
+  size_t _emu_links = 0;
+  flib::emu_link_config _emu_config;
 };
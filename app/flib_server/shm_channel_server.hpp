@@ -2,7 +2,7 @@
 
 #pragma once
 
-#include "flib_link.hpp"
+#include "Telemetry.hpp"
 #include "log.hpp"
 #include "shm_channel.hpp"
 #include "shm_device.hpp"
@@ -14,18 +14,21 @@
 
 namespace ip = boost::interprocess;
 
-template <typename T_DESC, typename T_DATA> class shm_channel_server {
+template <typename T_DESC, typename T_DATA, typename T_LINK>
+class shm_channel_server {
 
 public:
   shm_channel_server(ip::managed_shared_memory* shm,
                      shm_device* shm_dev,
                      size_t index,
-                     flib::flib_link* flib_link,
+                     T_LINK* flib_link,
                      size_t data_buffer_size_exp,
                      size_t desc_buffer_size_exp)
       : m_shm(shm), m_shm_dev(shm_dev), m_index(index), m_flib_link(flib_link),
         m_data_buffer_size_exp(data_buffer_size_exp),
-        m_desc_buffer_size_exp(desc_buffer_size_exp) {
+        m_desc_buffer_size_exp(desc_buffer_size_exp),
+        m_telemetry(Telemetry::get().add_channel("channel " +
+                                                 std::to_string(index))) {
 
     // allocate buffers
     void* data_buffer_raw = alloc_buffer(data_buffer_size_exp, data_item_size);
@@ -60,10 +63,10 @@ public:
   }
 
   ~shm_channel_server() {
+    publish_write_index();
+    m_shm_ch->set_eof(true);
     try {
-      ip::scoped_lock<ip::interprocess_mutex> lock(m_shm_dev->m_mutex);
-      update_write_index(lock);
-      m_shm_ch->set_eof(lock, true);
+      notify_waiters();
     } catch (ip::interprocess_exception const& e) {
       L_(error) << "Failed to shut down channel: " << e.what();
     }
@@ -71,38 +74,38 @@ public:
     // TODO destroy channel object and deallocate buffers if it is worth to do
   }
 
-  bool check_pending_req(ip::scoped_lock<ip::interprocess_mutex>& lock) {
-    assert(lock); // ensure mutex is really owned
-    return m_shm_ch->req_read_index(lock) || m_shm_ch->req_write_index(lock);
-  }
-
-  void try_handle_req(ip::scoped_lock<ip::interprocess_mutex>& lock) {
-    assert(lock); // ensure mutex is really owned
+  // Apply a changed read index to the hardware and publish the current write
+  // index. Returns true if any of the indices has changed.
+  bool poll() {
+    bool activity = false;
 
-    if (m_shm_ch->req_read_index(lock)) {
-      DualIndex read_index = m_shm_ch->read_index(lock);
-      // reset req before releasing lock ensures not to miss last req
-      m_shm_ch->set_req_read_index(lock, false);
-      lock.unlock();
+    // release buffer space according to the slowest required reader
+    DualIndex read_index = m_shm_ch->update_read_index();
+    if (!(read_index == m_read_index)) {
       L_(trace) << "updating read_index: data " << read_index.data << " desc "
                 << read_index.desc;
-
       m_flib_link->channel()->set_sw_read_pointers(
           hw_pointer(read_index.data, m_data_buffer_size_exp, data_item_size,
                      m_dma_transfer_size),
           hw_pointer(read_index.desc, m_desc_buffer_size_exp, desc_item_size));
-      lock.lock();
+      m_read_index = read_index;
+      activity = true;
+    }
+
+    if (publish_write_index()) {
+      activity = true;
     }
+    notify_waiters();
 
-    if (m_shm_ch->req_write_index(lock)) {
-      update_write_index(lock);
+    if (activity) {
+      publish_telemetry();
     }
+
+    return activity;
   }
 
 private:
-  void update_write_index(ip::scoped_lock<ip::interprocess_mutex>& lock) {
-    m_shm_ch->set_req_write_index(lock, false);
-    lock.unlock();
+  bool publish_write_index() {
     // fill write indices
     TimedDualIndex write_index;
     write_index.index.desc = m_flib_link->channel()->get_desc_index();
@@ -110,10 +113,43 @@ private:
         m_desc_buffer_view->at(write_index.index.desc - 1).offset +
         m_desc_buffer_view->at(write_index.index.desc - 1).size;
     write_index.updated = boost::posix_time::microsec_clock::universal_time();
-    L_(trace) << "fetching write_index: data " << write_index.index.data
-              << " desc " << write_index.index.desc;
-    lock.lock();
-    m_shm_ch->set_write_index(lock, write_index);
+    m_shm_ch->set_write_index(write_index);
+
+    bool changed = !(write_index.index == m_write_index);
+    if (changed) {
+      L_(trace) << "publishing write_index: data " << write_index.index.data
+                << " desc " << write_index.index.desc;
+      m_write_index = write_index.index;
+    }
+    return changed;
+  }
+
+  // Publish the buffer occupancy for external monitoring. Each transition
+  // into a (nearly) full buffer is counted as a stall.
+  void publish_telemetry() {
+    size_t data_size = UINT64_C(1) << m_data_buffer_size_exp;
+    size_t desc_size = UINT64_C(1) << m_desc_buffer_size_exp;
+    m_telemetry.data.set(m_read_index.data, m_write_index.data, data_size);
+    m_telemetry.desc.set(m_read_index.desc, m_write_index.desc, desc_size);
+    m_telemetry.items.store(m_write_index.desc, std::memory_order_relaxed);
+    m_telemetry.bytes.store(m_write_index.data, std::memory_order_relaxed);
+
+    bool full = m_write_index.desc - m_read_index.desc >= desc_size ||
+                m_write_index.data - m_read_index.data + m_dma_transfer_size >=
+                    data_size;
+    if (full && !m_full) {
+      m_telemetry.stalls.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_full = full;
+    m_telemetry.touch();
+  }
+
+  void notify_waiters() {
+    // only take the lock if a client is actually waiting
+    if (m_shm_ch->has_waiters()) {
+      ip::scoped_lock<ip::interprocess_mutex> lock(m_shm_dev->m_mutex);
+      m_shm_ch->notify_write_index(lock);
+    }
   }
 
   // Convert index into byte pointer for hardware
@@ -142,14 +178,23 @@ private:
   ip::managed_shared_memory* m_shm;
   shm_device* m_shm_dev;
   size_t m_index;
-  flib::flib_link* m_flib_link;
+  T_LINK* m_flib_link;
   size_t m_dma_transfer_size;
 
+  // last values applied to / read from the hardware
+  DualIndex m_read_index{0, 0};
+  DualIndex m_write_index{0, 0};
+
   shm_channel* m_shm_ch;
   std::unique_ptr<RingBufferView<T_DATA>> m_data_buffer_view;
   std::unique_ptr<RingBufferView<T_DESC>> m_desc_buffer_view;
   size_t m_data_buffer_size_exp;
   size_t m_desc_buffer_size_exp;
+
+  // occupancy published for external monitoring
+  TelemetryChannel& m_telemetry;
+  bool m_full = false;
+
   constexpr static size_t data_item_size = sizeof(T_DATA);
   constexpr static size_t desc_item_size = sizeof(T_DESC);
 };
@@ -4,8 +4,6 @@
 
 #include "etcd/Client.hpp"
 #include "etcd/Watcher.hpp"
-#include "flib_device.hpp"
-#include "flib_link.hpp"
 #include "log.hpp"
 #include "shm_channel_server.hpp"
 #include "shm_device.hpp"
@@ -23,12 +21,19 @@
 
 namespace ip = boost::interprocess;
 
-template <typename T_DESC, typename T_DATA> class shm_device_server {
+/// Shared memory server for the links of a FLIB device.
+/** The device type T_DEVICE is either a hardware flib::flib_device or a
+    software flib::emu_device, T_LINK is the corresponding link type. */
+template <typename T_DESC,
+          typename T_DATA,
+          typename T_DEVICE,
+          typename T_LINK>
+class shm_device_server {
 
 public:
-  using shm_channel_server_type = shm_channel_server<T_DESC, T_DATA>;
+  using shm_channel_server_type = shm_channel_server<T_DESC, T_DATA, T_LINK>;
 
-  shm_device_server(flib::flib_device* flib,
+  shm_device_server(T_DEVICE* flib,
                     std::string shm_identifier,
                     size_t data_buffer_size_exp,
                     size_t desc_buffer_size_exp,
@@ -53,13 +58,13 @@ public:
           });
     }
 
-    std::vector<flib::flib_link*> flib_links = m_flib->links();
+    std::vector<T_LINK*> flib_links = m_flib->links();
 
     // delete deactivated links from vector
     flib_links.erase(
         std::remove_if(std::begin(flib_links), std::end(flib_links),
                        [](decltype(flib_links[0]) link) {
-                         return link->data_sel() == flib::flib_link::rx_disable;
+                         return link->data_sel() == T_LINK::rx_disable;
                        }),
         std::end(flib_links));
     L_(info) << "enabled flib links detected: " << flib_links.size();
@@ -80,7 +85,7 @@ public:
 
     // create channels for active flib links
     size_t idx = 0;
-    for (flib::flib_link* link : flib_links) {
+    for (T_LINK* link : flib_links) {
       m_shm_ch_vec.push_back(std::unique_ptr<shm_channel_server_type>(
           new shm_channel_server_type(m_shm.get(), m_shm_dev, idx, link,
                                       data_buffer_size_exp,
@@ -102,32 +107,22 @@ public:
       }
       L_(info) << "flib server started and running";
       while (m_run) {
-        // claim lock at start-up
-        ip::scoped_lock<ip::interprocess_mutex> lock(m_shm_dev->m_mutex);
-
-        // check nothing is pending everytime before sleeping
-        // INFO: need to loop over all individual requests,
-        // alternative would be global request cue.
-        bool pending_req = false;
+        // indices are exchanged lock-free, poll all channels
+        bool activity = false;
         for (const std::unique_ptr<shm_channel_server_type>& shm_ch :
              m_shm_ch_vec) {
-          pending_req |= shm_ch->check_pending_req(lock);
-        }
-        if (!pending_req) {
-          // sleep if nothing is pending
-          auto const abs_time =
-              boost::posix_time::microsec_clock::universal_time() +
-              boost::posix_time::milliseconds(100);
-          m_shm_dev->m_cond_req.timed_wait(lock, abs_time);
+          activity |= shm_ch->poll();
         }
         if (*m_signal_status != 0) {
           stop();
         }
-
-        // try to handle requests
-        for (const std::unique_ptr<shm_channel_server_type>& shm_ch :
-             m_shm_ch_vec) {
-          shm_ch->try_handle_req(lock);
+        if (!activity) {
+          // sleep briefly if nothing has changed, clients may wake us up
+          ip::scoped_lock<ip::interprocess_mutex> lock(m_shm_dev->m_mutex);
+          auto const abs_time =
+              boost::posix_time::microsec_clock::universal_time() +
+              m_idle_interval;
+          m_shm_dev->m_cond_req.timed_wait(lock, abs_time);
         }
       }
     }
@@ -161,7 +156,7 @@ private:
   }
 
   // Members
-  flib::flib_device* m_flib;
+  T_DEVICE* m_flib;
   std::string m_shm_identifier;
   etcd_config_t m_etcd_config;
   volatile std::sig_atomic_t* m_signal_status;
@@ -172,7 +167,8 @@ private:
   std::shared_ptr<etcd::Watcher> m_signal_watcher;
 
   bool m_run = false;
-};
 
-using flib_shm_device_server =
-    shm_device_server<fles::MicrosliceDescriptor, uint8_t>;
+  // maximum sleep time when no index has changed
+  const boost::posix_time::time_duration m_idle_interval =
+      boost::posix_time::microseconds(100);
+};
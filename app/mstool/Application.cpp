@@ -7,100 +7,241 @@
 #include "MicrosliceOutputArchive.hpp"
 #include "MicrosliceReceiver.hpp"
 #include "MicrosliceTransmitter.hpp"
+#include "MicrosliceViewReceiver.hpp"
 #include "TimesliceDebugger.hpp"
 #include "log.hpp"
 #include "shm_channel_client.hpp"
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <iterator>
 #include <thread>
+#include <vector>
+
+Application::Channel::Channel(size_t i,
+                              MetricCounter& microslices,
+                              MetricCounter& b)
+    : index(i), microslices_metric(microslices), bytes_metric(b) {}
 
 Application::Application(Parameters const& par) : par_(par) {
+  for (const auto& uri : par_.metrics_uris) {
+    metrics_exporters_.push_back(MetricsExporter::create(uri));
+  }
+
+  std::vector<size_t> indices = par_.channels;
 
-  // Source setup
   if (!par_.input_shm.empty()) {
     L_(info) << "using shared memory as data source: " << par_.input_shm;
 
     shm_device_ = std::make_shared<flib_shm_device_client>(par_.input_shm);
 
-    if (par_.channel_idx < shm_device_->num_channels()) {
-      data_source_.reset(
-          new flib_shm_channel_client(shm_device_, par_.channel_idx));
-
-    } else {
-      throw std::runtime_error("shared memory channel not available");
+    if (par_.all_channels) {
+      indices.clear();
+      for (size_t i = 0; i < shm_device_->num_channels(); ++i) {
+        indices.push_back(i);
+      }
+    }
+    for (size_t index : indices) {
+      if (index >= shm_device_->num_channels()) {
+        throw std::runtime_error("shared memory channel not available");
+      }
     }
   } else if (par_.use_pattern_generator) {
     L_(info) << "using pattern generator as data source";
+  }
+
+  if (indices.size() > 1 && !par_.input_archive.empty() &&
+      par_.input_archive.find("%c") == std::string::npos) {
+    throw std::runtime_error(
+        "input archive name needs placeholder %c for several channels");
+  }
+
+  if (!par_.output_shm.empty()) {
+    L_(info) << "providing output in shared memory: " << par_.output_shm;
+
+    constexpr std::size_t desc_buffer_size_exp = 19; // 512 ki entries
+    constexpr std::size_t data_buffer_size_exp = 27; // 128 MiB
+
+    output_shm_device_.reset(new flib_shm_device_provider(
+        par_.output_shm, indices.size(), data_buffer_size_exp,
+        desc_buffer_size_exp));
+  }
+
+  multi_channel_ = indices.size() > 1 || par_.all_channels;
+  for (size_t index : indices) {
+    add_channel(index);
+  }
+  if (indices.size() > 1) {
+    L_(info) << "processing " << indices.size() << " channels";
+  }
+}
+
+Application::~Application() {
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+  for (const auto& channel : channels_) {
+    if (multi_channel_) {
+      L_(info) << "channel " << channel->index << ": " << channel->count
+               << " microslices, " << channel->bytes << " bytes";
+    }
+    count += channel->count;
+    bytes += channel->bytes;
+  }
+  double runtime =
+      std::chrono::duration<double>(stop_time_ - start_time_).count();
+  if (runtime > 0) {
+    L_(info) << "aggregated rate: " << static_cast<double>(count) / runtime
+             << " microslices/s, "
+             << static_cast<double>(bytes) / runtime * 1e-6 << " MB/s";
+  }
+  L_(info) << "total microslices processed: " << count;
+}
+
+void Application::add_channel(size_t index) {
+  size_t position = channels_.size();
+  std::string label = std::to_string(index);
+  channels_.emplace_back(new Channel(
+      index,
+      MetricsRegistry::get().counter("mstool_microslices_total",
+                                     {{"channel", label}},
+                                     "Number of microslices processed"),
+      MetricsRegistry::get().counter(
+          "mstool_bytes_total", {{"channel", label}},
+          "Number of microslice content bytes processed")));
+  Channel& channel = *channels_.back();
 
+  // Source setup
+  if (shm_device_) {
+    channel.data_source.reset(
+        new flib_shm_channel_client(shm_device_, index, par_.lossy));
+  } else if (par_.use_pattern_generator) {
     constexpr uint32_t typical_content_size = 10000;
     constexpr std::size_t desc_buffer_size_exp = 19; // 512 ki entries
     constexpr std::size_t data_buffer_size_exp = 27; // 128 MiB
 
-    data_source_.reset(new FlesnetPatternGenerator(
-        data_buffer_size_exp, desc_buffer_size_exp, par_.channel_idx,
+    channel.data_source.reset(new FlesnetPatternGenerator(
+        data_buffer_size_exp, desc_buffer_size_exp, index,
         typical_content_size, true, true));
   }
 
-  if (data_source_) {
-    source_.reset(new fles::MicrosliceReceiver(*data_source_));
+  if (channel.data_source && par_.lossy) {
+    // a lossy source may overwrite data still in use, so copy it
+    channel.source.reset(new fles::MicrosliceReceiver(*channel.data_source));
+  } else if (channel.data_source) {
+    channel.source.reset(
+        new fles::MicrosliceViewReceiver(*channel.data_source));
   } else if (!par_.input_archive.empty()) {
-    source_.reset(new fles::MicrosliceInputArchive(par_.input_archive));
+    channel.source.reset(new fles::MicrosliceInputArchive(
+        channel_filename(par_.input_archive, index)));
   }
 
   // Sink setup
+  std::ostream* out = &std::cout;
+  std::string output_prefix;
+  if (multi_channel_) {
+    // each channel thread needs its own output stream
+    channel.log.reset(new logging::OstreamLog(status));
+    out = &channel.log->stream;
+    output_prefix = "c" + label + ": ";
+  }
+
   if (par_.analyze) {
-    sinks_.push_back(std::unique_ptr<fles::MicrosliceSink>(
-        new MicrosliceAnalyzer(100000, 3, std::cout, "", par_.channel_idx)));
+    channel.sinks.push_back(std::unique_ptr<fles::MicrosliceSink>(
+        new MicrosliceAnalyzer(100000, 3, *out, output_prefix, index)));
   }
 
   if (par_.dump_verbosity > 0) {
-    sinks_.push_back(std::unique_ptr<fles::MicrosliceSink>(
-        new MicrosliceDumper(std::cout, par_.dump_verbosity)));
+    channel.sinks.push_back(std::unique_ptr<fles::MicrosliceSink>(
+        new MicrosliceDumper(*out, par_.dump_verbosity)));
   }
 
   if (!par_.output_archive.empty()) {
-    sinks_.push_back(std::unique_ptr<fles::MicrosliceSink>(
-        new fles::MicrosliceOutputArchive(par_.output_archive)));
+    std::string filename = par_.output_archive;
+    // append channel index to file name if missing
+    if (multi_channel_ && filename.find("%c") == std::string::npos) {
+      filename += ".%c";
+    }
+    channel.sinks.push_back(std::unique_ptr<fles::MicrosliceSink>(
+        new fles::MicrosliceOutputArchive(channel_filename(filename, index))));
   }
 
-  if (!par_.output_shm.empty()) {
-    L_(info) << "providing output in shared memory: " << par_.output_shm;
-
-    constexpr std::size_t desc_buffer_size_exp = 19; // 512 ki entries
-    constexpr std::size_t data_buffer_size_exp = 27; // 128 MiB
-
-    output_shm_device_.reset(new flib_shm_device_provider(
-        par_.output_shm, 1, data_buffer_size_exp, desc_buffer_size_exp));
-    InputBufferWriteInterface* data_sink = output_shm_device_->channels().at(0);
-    sinks_.push_back(std::unique_ptr<fles::MicrosliceSink>(
+  if (output_shm_device_) {
+    InputBufferWriteInterface* data_sink =
+        output_shm_device_->channels().at(position);
+    channel.sinks.push_back(std::unique_ptr<fles::MicrosliceSink>(
         new fles::MicrosliceTransmitter(*data_sink)));
   }
 }
 
-Application::~Application() {
-  L_(info) << "total microslices processed: " << count_;
-}
-
 void Application::run() {
-  uint64_t limit = par_.maximum_number;
+  start_time_ = std::chrono::steady_clock::now();
+  for (auto& channel : channels_) {
+    Channel& c = *channel;
+    c.thread = std::thread([this, &c] { run_channel(c); });
+  }
+  for (auto& channel : channels_) {
+    channel->thread.join();
+  }
+  stop_time_ = std::chrono::steady_clock::now();
 
-  while (auto microslice = source_->get()) {
-    std::shared_ptr<const fles::Microslice> ms(std::move(microslice));
-    for (auto& sink : sinks_) {
-      sink->put(ms);
+  for (auto& channel : channels_) {
+    if (channel->error) {
+      std::rethrow_exception(channel->error);
     }
-    ++count_;
-    if (count_ == limit) {
-      break;
-    }
-  }
-  for (auto& sink : sinks_) {
-    sink->end_stream();
   }
+
   if (output_shm_device_) {
     L_(info) << "waiting until output shared memory is empty";
-    while (!output_shm_device_->channels().at(0)->empty()) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    for (auto* output_channel : output_shm_device_->channels()) {
+      while (!output_channel->empty()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      }
     }
   }
 }
+
+void Application::run_channel(Channel& channel) {
+  try {
+    uint64_t limit = par_.maximum_number;
+
+    // process the microslices in batches to reduce the per-item overhead
+    constexpr uint64_t batch_size = 64;
+    std::vector<std::unique_ptr<fles::Microslice>> microslices;
+    std::vector<std::shared_ptr<const fles::Microslice>> batch;
+
+    while (!stop_ && channel.count < limit) {
+      microslices.clear();
+      uint64_t max_items = std::min(batch_size, limit - channel.count);
+      if (channel.source->get_batch(microslices, max_items) == 0) {
+        break;
+      }
+      batch.assign(std::make_move_iterator(microslices.begin()),
+                   std::make_move_iterator(microslices.end()));
+      for (auto& sink : channel.sinks) {
+        sink->put_batch(batch);
+      }
+      uint64_t bytes = 0;
+      for (const auto& ms : batch) {
+        bytes += ms->desc().size;
+      }
+      batch.clear();
+      channel.microslices_metric.add(microslices.size());
+      channel.bytes_metric.add(bytes);
+      channel.bytes += bytes;
+      channel.count += microslices.size();
+    }
+    for (auto& sink : channel.sinks) {
+      sink->end_stream();
+    }
+  } catch (...) {
+    channel.error = std::current_exception();
+    stop_ = true;
+    L_(error) << "channel " << channel.index << " failed, stopping";
+  }
+}
+
+std::string Application::channel_filename(const std::string& name,
+                                          size_t index) {
+  return boost::replace_all_copy(name, "%c", std::to_string(index));
+}
@@ -2,15 +2,25 @@
 #pragma once
 
 #include "DualRingBuffer.hpp"
+#include "Metrics.hpp"
+#include "MetricsExporter.hpp"
 #include "MicrosliceSource.hpp"
 #include "Parameters.hpp"
 #include "Sink.hpp"
+#include "log.hpp"
 #include "shm_device_client.hpp"
 #include "shm_device_provider.hpp"
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <memory>
+#include <string>
+#include <thread>
 #include <vector>
 
 /// %Application base class.
+/** Each microslice channel has its own source and sinks and is processed
+    by a separate thread. */
 class Application {
 public:
   explicit Application(Parameters const& par);
@@ -23,14 +33,57 @@ public:
   void run();
 
 private:
+  /// A microslice channel and its worker thread.
+  struct Channel {
+    Channel(size_t index, MetricCounter& microslices, MetricCounter& bytes);
+
+    /// Channel/component index.
+    size_t index;
+
+    std::unique_ptr<InputBufferReadInterface> data_source;
+    std::unique_ptr<fles::MicrosliceSource> source;
+    std::vector<std::unique_ptr<fles::MicrosliceSink>> sinks;
+
+    /// Output stream of the sinks if several channels are processed.
+    std::unique_ptr<logging::OstreamLog> log;
+
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> bytes{0};
+
+    MetricCounter& microslices_metric;
+    MetricCounter& bytes_metric;
+
+    /// Exception thrown while processing the channel.
+    std::exception_ptr error;
+
+    std::thread thread;
+  };
+
+  /// Set up the source and sinks of a channel.
+  void add_channel(size_t index);
+
+  /// The channel thread main function.
+  void run_channel(Channel& channel);
+
+  /// Replace the placeholder "%c" in a file name by a channel index.
+  static std::string channel_filename(const std::string& name, size_t index);
+
   Parameters const& par_;
 
   std::shared_ptr<flib_shm_device_client> shm_device_;
   std::unique_ptr<flib_shm_device_provider> output_shm_device_;
-  std::unique_ptr<InputBufferReadInterface> data_source_;
 
-  std::unique_ptr<fles::MicrosliceSource> source_;
-  std::vector<std::unique_ptr<fles::MicrosliceSink>> sinks_;
+  std::vector<std::unique_ptr<Channel>> channels_;
+
+  /// Several channels are processed, with per-channel file names and
+  /// output streams.
+  bool multi_channel_ = false;
+
+  /// Stop all channels (e.g., after an error in one of them).
+  std::atomic<bool> stop_{false};
+
+  std::chrono::steady_clock::time_point start_time_;
+  std::chrono::steady_clock::time_point stop_time_;
 
-  uint64_t count_ = 0;
+  std::vector<std::unique_ptr<MetricsExporter>> metrics_exporters_;
 };
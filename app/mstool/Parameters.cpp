@@ -34,17 +34,33 @@ void Parameters::parse_options(int argc, char* argv[]) {
               "unlimited)");
   general_add("exec,e", po::value<std::string>(&exec)->value_name("<string>"),
               "name of an executable to run after startup");
+  general_add("metrics",
+              po::value<std::vector<std::string>>(&metrics_uris)
+                  ->multitoken()
+                  ->value_name("<uri> ..."),
+              "export metrics (http://<address>:<port>, "
+              "udp://<host>:<port> or file://<path>)");
 
   po::options_description source("Source options");
   auto source_add = source.add_options();
   source_add("pattern-generator,p", po::value<uint32_t>(&pattern_generator),
              "use pattern generator to produce timeslices");
-  source_add("channel,c", po::value<size_t>(&channel_idx),
-             "use given channel/component index for source/sink");
+  source_add("channel,c",
+             po::value<std::vector<size_t>>(&channels)
+                 ->multitoken()
+                 ->value_name("<n> ..."),
+             "use given channel/component indices for source/sink, each "
+             "processed by a separate thread (default: 0)");
+  source_add("all-channels,A",
+             po::value<bool>(&all_channels)->implicit_value(true),
+             "use all channels of the input shared memory");
   source_add("input-shm,I", po::value<std::string>(&input_shm),
              "name of a shared memory to use as data source");
+  source_add("lossy", po::value<bool>(&lossy)->implicit_value(true),
+             "read shared memory as lossy monitoring tap (never hold back "
+             "other readers)");
   source_add("input-archive,i", po::value<std::string>(&input_archive),
-             "name of an input file archive to read");
+             "name of an input file archive to read (\"%c\": channel index)");
 
   po::options_description sink("Sink options");
   auto sink_add = sink.add_options();
@@ -55,7 +71,8 @@ void Parameters::parse_options(int argc, char* argv[]) {
   sink_add("output-shm,O", po::value<std::string>(&output_shm),
            "name of a shared memory to write to");
   sink_add("output-archive,o", po::value<std::string>(&output_archive),
-           "name of an output file archive to write");
+           "name of an output file archive to write (\"%c\": channel "
+           "index)");
 
   po::options_description desc;
   desc.add(general).add(source).add(sink);
@@ -95,4 +112,15 @@ void Parameters::parse_options(int argc, char* argv[]) {
   if (input_sources > 1) {
     throw ParametersException("more than one input source specified");
   }
+
+  if (all_channels) {
+    if (input_shm.empty()) {
+      throw ParametersException("all channels require input shared memory");
+    }
+    if (!channels.empty()) {
+      throw ParametersException("channels and all channels specified");
+    }
+  } else if (channels.empty()) {
+    channels.push_back(0);
+  }
 }
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 /// Run parameters exception class.
 class ParametersException : public std::runtime_error {
@@ -20,12 +21,15 @@ struct Parameters {
   // general options
   uint64_t maximum_number = UINT64_MAX;
   std::string exec;
+  std::vector<std::string> metrics_uris;
 
   // source selection
   uint32_t pattern_generator = 0;
   bool use_pattern_generator = false;
-  size_t channel_idx = 0;
+  std::vector<size_t> channels;
+  bool all_channels = false;
   std::string input_shm;
+  bool lossy = false;
   std::string input_archive;
 
   // sink selection
@@ -0,0 +1,255 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// Simulation of timeslice scheduling policies with skewed compute nodes.
+/** Each input sends one timeslice per tick to the compute node selected by
+    its own instance of the scheduling policy, provided the compute node
+    buffer has space. A compute node processes completely received
+    timeslices at its configured speed (timeslices per tick). Schedule
+    announcements reach the inputs after a configurable delay. */
+
+#include "SchedulingPolicy.hpp"
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace po = boost::program_options;
+
+namespace {
+
+struct ComputeNode {
+  double speed;
+  std::unique_ptr<ScheduleAnnouncer> announcer;
+  /// Number of timeslices received from each input.
+  std::vector<uint64_t> received;
+  /// Timeslice index per buffer position (as sent by the first input).
+  std::deque<uint64_t> ts_at_pos;
+  uint64_t pos_offset = 0;
+  uint64_t completely_written = 0;
+  uint64_t processed = 0;
+  double credit = 0;
+  /// Announcements in flight to the inputs.
+  std::deque<ScheduleAnnouncement> in_flight;
+};
+
+struct Result {
+  uint64_t ticks = 0;
+  bool stalled = false;
+  std::vector<uint64_t> processed;
+};
+
+Result simulate(const std::string& policy,
+                uint32_t num_inputs,
+                const std::vector<double>& speeds,
+                uint64_t buffer_size,
+                uint64_t timeslices,
+                uint64_t delay) {
+  const auto num_cn = static_cast<uint32_t>(speeds.size());
+
+  std::vector<std::unique_ptr<SchedulingPolicy>> policies;
+  std::vector<uint64_t> next_ts(num_inputs, 0);
+  for (uint32_t i = 0; i < num_inputs; ++i) {
+    policies.push_back(SchedulingPolicy::create(policy, num_cn));
+  }
+
+  std::vector<ComputeNode> cns(num_cn);
+  for (uint32_t c = 0; c < num_cn; ++c) {
+    cns[c].speed = speeds[c];
+    cns[c].announcer = SchedulingPolicy::create_announcer(policy, num_cn);
+    cns[c].received.assign(num_inputs, 0);
+  }
+
+  Result result;
+  uint64_t total_processed = 0;
+  uint64_t last_progress = 0;
+
+  while (total_processed < timeslices) {
+    ++result.ticks;
+
+    // inputs: deliver delayed announcements, send one timeslice each
+    for (uint32_t i = 0; i < num_inputs; ++i) {
+      for (uint32_t c = 0; c < num_cn; ++c) {
+        if (cns[c].in_flight.size() > delay) {
+          policies[i]->on_announcement(c, cns[c].in_flight.front());
+        }
+      }
+      if (next_ts[i] >= timeslices) {
+        continue;
+      }
+      int target = policies[i]->target(next_ts[i]);
+      if (target < 0) {
+        continue;
+      }
+      ComputeNode& cn = cns[static_cast<uint32_t>(target)];
+      if (cn.received[i] - cn.processed >= buffer_size) {
+        continue;
+      }
+      uint64_t pos = cn.received[i]++;
+      if (pos - cn.pos_offset >= cn.ts_at_pos.size()) {
+        cn.ts_at_pos.push_back(next_ts[i]);
+      } else if (cn.ts_at_pos[pos - cn.pos_offset] != next_ts[i]) {
+        throw std::runtime_error("inputs disagree on timeslice assignment");
+      }
+      ++next_ts[i];
+      last_progress = result.ticks;
+    }
+
+    // compute nodes: build and process timeslices, announce weights
+    for (auto& cn : cns) {
+      if (cn.in_flight.size() > delay) {
+        cn.in_flight.pop_front();
+      }
+      uint64_t written =
+          *std::min_element(cn.received.begin(), cn.received.end());
+      if (written > cn.completely_written && cn.announcer) {
+        double fill_level = static_cast<double>(written - cn.processed) /
+                            static_cast<double>(buffer_size);
+        cn.announcer->update(cn.ts_at_pos[written - 1 - cn.pos_offset],
+                             fill_level);
+      }
+      cn.completely_written = written;
+
+      cn.credit = std::min(cn.credit + cn.speed, std::max(cn.speed, 1.0));
+      while (cn.credit >= 1.0 && cn.processed < cn.completely_written) {
+        ++cn.processed;
+        ++total_processed;
+        cn.credit -= 1.0;
+        last_progress = result.ticks;
+      }
+      while (cn.pos_offset < cn.processed) {
+        cn.ts_at_pos.pop_front();
+        ++cn.pos_offset;
+      }
+
+      cn.in_flight.push_back(cn.announcer ? cn.announcer->announcement()
+                                          : ScheduleAnnouncement());
+    }
+
+    if (result.ticks - last_progress > 100000) {
+      result.stalled = true;
+      break;
+    }
+  }
+
+  for (auto& cn : cns) {
+    result.processed.push_back(cn.processed);
+  }
+  return result;
+}
+
+std::vector<double> parse_speeds(const std::string& s) {
+  std::vector<double> speeds;
+  std::istringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    speeds.push_back(std::stod(item));
+  }
+  if (speeds.empty() ||
+      *std::min_element(speeds.begin(), speeds.end()) <= 0.0) {
+    throw std::runtime_error("invalid compute node speeds: " + s);
+  }
+  return speeds;
+}
+
+/// Weights proportional to the compute node speeds.
+std::string speed_weights(const std::vector<double>& speeds) {
+  double min_speed = *std::min_element(speeds.begin(), speeds.end());
+  std::ostringstream s;
+  s << "weighted:";
+  for (size_t c = 0; c < speeds.size(); ++c) {
+    s << (c != 0 ? "," : "") << std::lround(speeds[c] / min_speed);
+  }
+  return s.str();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    uint32_t num_inputs = 4;
+    std::string speeds_spec = "0.5,0.5,0.5,0.1";
+    uint64_t buffer_size = 16;
+    uint64_t timeslices = 100000;
+    uint64_t delay = 2;
+    std::vector<std::string> policies;
+
+    po::options_description desc("Allowed options");
+    auto desc_add = desc.add_options();
+    desc_add("help,h", "produce help message");
+    desc_add("inputs,i", po::value<uint32_t>(&num_inputs)
+                             ->default_value(num_inputs)
+                             ->value_name("<n>"),
+             "number of input channels (one timeslice per tick each)");
+    desc_add("speeds,s", po::value<std::string>(&speeds_spec)
+                             ->default_value(speeds_spec)
+                             ->value_name("<s0>,<s1>,..."),
+             "compute node speeds in timeslices per tick");
+    desc_add("buffer,b", po::value<uint64_t>(&buffer_size)
+                             ->default_value(buffer_size)
+                             ->value_name("<n>"),
+             "compute node buffer size in timeslices");
+    desc_add("timeslices,n", po::value<uint64_t>(&timeslices)
+                                 ->default_value(timeslices)
+                                 ->value_name("<n>"),
+             "number of timeslices to simulate");
+    desc_add("delay,d", po::value<uint64_t>(&delay)
+                            ->default_value(delay)
+                            ->value_name("<n>"),
+             "status message delay in ticks");
+    desc_add("policy,p",
+             po::value<std::vector<std::string>>(&policies)
+                 ->value_name("<policy>"),
+             "scheduling policy to simulate (default: round-robin, "
+             "weighted by speed, occupancy)");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") != 0u) {
+      std::cout << desc << std::endl;
+      return EXIT_SUCCESS;
+    }
+
+    std::vector<double> speeds = parse_speeds(speeds_spec);
+    if (policies.empty()) {
+      policies = {"round-robin", speed_weights(speeds), "occupancy"};
+    }
+
+    double capacity = 0;
+    for (double s : speeds) {
+      capacity += s;
+    }
+    std::cout << num_inputs << " inputs, " << speeds.size()
+              << " compute nodes (" << speeds_spec << "), ideal throughput "
+              << std::min(capacity, 1.0) << " timeslices/tick" << std::endl;
+
+    for (const auto& policy : policies) {
+      Result r = simulate(policy, num_inputs, speeds, buffer_size, timeslices,
+                          delay);
+      std::cout << std::left << std::setw(24) << policy << std::right
+                << " throughput " << std::fixed << std::setprecision(3)
+                << static_cast<double>(timeslices) /
+                       static_cast<double>(r.ticks)
+                << " timeslices/tick, share";
+      for (auto p : r.processed) {
+        std::cout << " " << std::setprecision(2)
+                  << static_cast<double>(p) / static_cast<double>(timeslices);
+      }
+      if (r.stalled) {
+        std::cout << " (stalled)";
+      }
+      std::cout << std::endl;
+    }
+  } catch (std::exception& e) {
+    std::cerr << "error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
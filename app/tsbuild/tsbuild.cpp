@@ -0,0 +1,132 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// Offline timeslice builder (see OfflineTimesliceBuilder).
+/** Reads a microslice archive per input link, aligns the microslices by
+    their index and writes the timeslices built from them to a timeslice
+    archive, as flesnet would have produced them. */
+
+#include "MicrosliceInputArchive.hpp"
+#include "OfflineTimesliceBuilder.hpp"
+#include "TimesliceOutputArchive.hpp"
+#include "log.hpp"
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace po = boost::program_options;
+
+int main(int argc, char* argv[]) {
+  try {
+    std::vector<std::string> inputs;
+    std::string output_archive;
+    size_t output_archive_items = SIZE_MAX;
+    size_t output_archive_bytes = SIZE_MAX;
+    uint64_t timeslice_size = 100;
+    uint64_t overlap_size = 1;
+    uint64_t microslice_length = 0;
+    uint32_t num_workers = std::max(std::thread::hardware_concurrency(), 1u);
+    uint64_t max_timeslices = UINT64_MAX;
+    unsigned log_level = 2;
+
+    po::options_description desc("Allowed options");
+    auto desc_add = desc.add_options();
+    desc_add("help,h", "produce help message");
+    desc_add("log-level,l",
+             po::value<unsigned>(&log_level)
+                 ->default_value(log_level)
+                 ->value_name("<n>"),
+             "set the log level (all:0)");
+    desc_add("input-archive,i",
+             po::value<std::vector<std::string>>(&inputs)->value_name(
+                 "<file>"),
+             "microslice archive of an input link, one per timeslice "
+             "component (also as positional arguments, \"%n\": sequence)");
+    desc_add("output-archive,o",
+             po::value<std::string>(&output_archive)->value_name("<file>"),
+             "name of the timeslice archive to write");
+    desc_add("output-archive-items",
+             po::value<size_t>(&output_archive_items),
+             "limit number of timeslices per file to given number, create "
+             "sequence of output archive files (use placeholder %n in "
+             "output-archive parameter)");
+    desc_add("output-archive-bytes",
+             po::value<size_t>(&output_archive_bytes),
+             "limit number of bytes per file to given number, create "
+             "sequence of output archive files (use placeholder %n in "
+             "output-archive parameter)");
+    desc_add("timeslice-size,s",
+             po::value<uint64_t>(&timeslice_size)
+                 ->default_value(timeslice_size)
+                 ->value_name("<n>"),
+             "number of core microslices per timeslice");
+    desc_add("overlap-size",
+             po::value<uint64_t>(&overlap_size)
+                 ->default_value(overlap_size)
+                 ->value_name("<n>"),
+             "number of overlap microslices per timeslice");
+    desc_add("microslice-length",
+             po::value<uint64_t>(&microslice_length)->value_name("<n>"),
+             "difference of the indices of consecutive microslices "
+             "(default: detect from the first input)");
+    desc_add("workers,w",
+             po::value<uint32_t>(&num_workers)
+                 ->default_value(num_workers)
+                 ->value_name("<n>"),
+             "number of timeslice assembly threads");
+    desc_add("max-timeslice-number,n",
+             po::value<uint64_t>(&max_timeslices)->value_name("<n>"),
+             "build at most the given number of timeslices");
+
+    po::positional_options_description pos_desc;
+    pos_desc.add("input-archive", -1);
+
+    po::variables_map vm;
+    po::store(po::command_line_parser(argc, argv)
+                  .options(desc)
+                  .positional(pos_desc)
+                  .run(),
+              vm);
+    po::notify(vm);
+
+    if (vm.count("help") != 0u || inputs.empty() || output_archive.empty()) {
+      std::cout << "Usage: tsbuild [options] -o <output file> <input file> "
+                   "...\n"
+                << desc << std::endl;
+      return vm.count("help") != 0u ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    logging::add_console(static_cast<severity_level>(log_level));
+
+    std::vector<std::unique_ptr<fles::MicrosliceSource>> sources;
+    for (const auto& input : inputs) {
+      if (input.find("%n") != std::string::npos) {
+        sources.emplace_back(new fles::MicrosliceInputArchiveSequence(input));
+      } else {
+        sources.emplace_back(new fles::MicrosliceInputArchive(input));
+      }
+    }
+
+    std::unique_ptr<fles::TimesliceSink> output;
+    if (output_archive_items == SIZE_MAX && output_archive_bytes == SIZE_MAX) {
+      output.reset(new fles::TimesliceOutputArchive(output_archive));
+    } else {
+      output.reset(new fles::TimesliceOutputArchiveSequence(
+          output_archive, output_archive_items, output_archive_bytes));
+    }
+
+    OfflineTimesliceBuilder builder(std::move(sources), *output,
+                                    timeslice_size, overlap_size,
+                                    microslice_length, num_workers);
+    builder.run(max_timeslices);
+    builder.log_statistics();
+  } catch (std::exception& e) {
+    L_(fatal) << e.what();
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
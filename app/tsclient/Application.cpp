@@ -12,11 +12,69 @@
 #include "TimesliceSubscriber.hpp"
 
 #include "Utility.hpp"
+#include <sstream>
 #include <thread>
+#include <utility>
+
+namespace {
+/// Sink adapter writing the TOF unpacker output after each timeslice
+/// (unless the output of all timeslices is merged).
+class UnpackerSink : public fles::TimesliceSink {
+public:
+  UnpackerSink(TimesliceUnpacker* unpacker,
+               bool merge_output,
+               std::string output_filename)
+      : unpacker_(unpacker), merge_output_(merge_output),
+        output_filename_(std::move(output_filename)) {}
+
+  void put(std::shared_ptr<const fles::Timeslice> timeslice) override {
+    uint64_t index = timeslice->index();
+    unpacker_->put(std::move(timeslice));
+    if (!merge_output_) {
+      std::stringstream ss;
+      ss << output_filename_ << "_ts" << index;
+      unpacker_->set_tof_unpacker_output_filename(ss.str());
+      unpacker_->saveTofDigiVectorToDisk();
+    }
+  }
+
+private:
+  std::unique_ptr<TimesliceUnpacker> unpacker_;
+  bool merge_output_;
+  std::string output_filename_;
+};
+} // namespace
+
+Application::Application(Parameters const& par)
+    : par_(par),
+      timeslices_metric_(MetricsRegistry::get().counter(
+          "tsclient_timeslices_total",
+          {{"client", std::to_string(par.client_index())}},
+          "Number of timeslices processed")),
+      bytes_metric_(MetricsRegistry::get().counter(
+          "tsclient_bytes_total",
+          {{"client", std::to_string(par.client_index())}},
+          "Number of timeslice bytes processed")),
+      sink_latency_metric_(MetricsRegistry::get().histogram(
+          "tsclient_sink_latency_seconds",
+          {{"client", std::to_string(par.client_index())}},
+          "Time to pass a timeslice to all sinks")),
+      telemetry_(Telemetry::get().add_channel(
+          "consumer " + std::to_string(par.client_index()))) {
+  for (const auto& uri : par_.metrics_uris()) {
+    metrics_exporters_.push_back(MetricsExporter::create(uri));
+  }
+
+  if (!par_.trace_prefix().empty()) {
+    trace_.reset(new TraceRecorder(
+        TraceRecorder::filename(par_.trace_prefix(),
+                                "t" + std::to_string(par_.client_index())),
+        par_.trace_sampling()));
+  }
 
-Application::Application(Parameters const& par) : par_(par) {
   if (!par_.shm_identifier().empty()) {
-    source_.reset(new fles::TimesliceReceiver(par_.shm_identifier()));
+    source_.reset(new fles::TimesliceReceiver(par_.shm_identifier(),
+                                              par_.client_index()));
   } else if (!par_.input_archive().empty()) {
     if (par_.input_archive_cycles() <= 1) {
       if (par_.multi_input()) {
@@ -45,24 +103,34 @@ Application::Application(Parameters const& par) : par_(par) {
   }
 
   if (par_.analyze()) {
-    std::string output_prefix = std::to_string(par_.client_index()) + ": ";
-    if (par_.histograms()) {
-      sinks_.push_back(
-          std::unique_ptr<fles::TimesliceSink>(new TimesliceAnalyzer(
-              1000, status_log_.stream, output_prefix, &std::cout)));
+    auto analyzer = [this](uint32_t worker) {
+      std::string output_prefix = std::to_string(par_.client_index()) + ": ";
+      if (par_.workers() > 1) {
+        output_prefix += "w" + std::to_string(worker) + ": ";
+      }
+      return std::unique_ptr<fles::TimesliceSink>(
+          new TimesliceAnalyzer(1000, sink_log(status), output_prefix,
+                                par_.histograms() ? &std::cout : nullptr));
+    };
+    if (par_.workers() > 1) {
+      worker_pool_ = new fles::TimesliceWorkerPool(par_.workers(), analyzer,
+                                                   par_.reorder_window());
+      add_sink(std::unique_ptr<fles::TimesliceSink>(worker_pool_),
+               "analyzer");
     } else {
-      sinks_.push_back(
-          std::unique_ptr<fles::TimesliceSink>(new TimesliceAnalyzer(
-              1000, status_log_.stream, output_prefix, nullptr)));
+      add_sink(analyzer(0), "analyzer");
     }
   }
 
   if (par_.unpack()) {
     std::string output_prefix = std::to_string(par_.client_index()) + ": ";
     timeslice_unpacker_ =
-        new TimesliceUnpacker(1000, status_log_.stream, output_prefix, nullptr);
+        new TimesliceUnpacker(1000, sink_log(status), output_prefix, nullptr);
 
-    sinks_.push_back(std::unique_ptr<fles::TimesliceSink>(timeslice_unpacker_));
+    add_sink(std::unique_ptr<fles::TimesliceSink>(new UnpackerSink(
+                 timeslice_unpacker_, par_.tof_unpacker_merge_output(),
+                 par_.tof_unpacker_output_filename())),
+             "unpacker");
 
     timeslice_unpacker_->set_tof_unpacker_mapping_file(
         par_.tof_unpacker_mapping());
@@ -73,27 +141,45 @@ Application::Application(Parameters const& par) : par_(par) {
   }
 
   if (par_.verbosity() > 0) {
-    sinks_.push_back(std::unique_ptr<fles::TimesliceSink>(
-        new TimesliceDumper(debug_log_.stream, par_.verbosity())));
+    add_sink(std::unique_ptr<fles::TimesliceSink>(
+                 new TimesliceDumper(sink_log(debug), par_.verbosity())),
+             "dumper");
   }
 
   if (!par_.output_archive().empty()) {
+    std::unique_ptr<fles::TimesliceSink> archive;
     if (par_.output_archive_items() == SIZE_MAX &&
         par_.output_archive_bytes() == SIZE_MAX) {
-      sinks_.push_back(std::unique_ptr<fles::TimesliceSink>(
-          new fles::TimesliceOutputArchive(par_.output_archive())));
+      archive.reset(new fles::TimesliceOutputArchive(par_.output_archive()));
+    } else {
+      archive.reset(new fles::TimesliceOutputArchiveSequence(
+          par_.output_archive(), par_.output_archive_items(),
+          par_.output_archive_bytes()));
+    }
+    if (worker_pool_ != nullptr) {
+      // write the analyzed timeslices in their original order
+      worker_pool_->set_ordered_sink(std::move(archive));
     } else {
-      sinks_.push_back(std::unique_ptr<fles::TimesliceSink>(
-          new fles::TimesliceOutputArchiveSequence(
-              par_.output_archive(), par_.output_archive_items(),
-              par_.output_archive_bytes())));
+      add_sink(std::move(archive), "archive");
     }
   }
 
   if (!par_.publish_address().empty()) {
-    sinks_.push_back(
-        std::unique_ptr<fles::TimesliceSink>(new fles::TimeslicePublisher(
-            par_.publish_address(), par_.publish_hwm())));
+    add_sink(std::unique_ptr<fles::TimesliceSink>(new fles::TimeslicePublisher(
+                 par_.publish_address(), par_.publish_hwm())),
+             "publisher");
+  }
+
+  if (par_.sink_queue_size() != 0 && !sinks_.empty()) {
+    // run each sink in its own thread
+    pipeline_ = new TimesliceSinkPipeline(
+        par_.sink_queue_size(), "tsclient",
+        {{"client", std::to_string(par_.client_index())}});
+    for (size_t i = 0; i < sinks_.size(); ++i) {
+      pipeline_->add(std::move(sinks_[i]), sink_names_[i]);
+    }
+    sinks_.clear();
+    sinks_.push_back(std::unique_ptr<fles::TimesliceSink>(pipeline_));
   }
 
   if (par_.benchmark()) {
@@ -140,25 +226,61 @@ void Application::run() {
 
   while (auto timeslice = source_->get()) {
     std::shared_ptr<const fles::Timeslice> ts(std::move(timeslice));
+    if (trace_) {
+      trace_->record(ts->index(), TraceStage::ConsumerReceived,
+                     static_cast<uint32_t>(par_.client_index()));
+      if (trace_->should_flush()) {
+        trace_->flush();
+      }
+    }
     if (par_.rate_limit() != 0.0) {
       rate_limit_delay();
     }
+    auto put_begin = std::chrono::steady_clock::now();
     for (auto& sink : sinks_) {
       sink->put(ts);
     }
-    if (!par_.tof_unpacker_merge_output()) {
-      std::stringstream ss;
-      ss << par_.tof_unpacker_output_filename() << "_ts" << ts->index();
-      timeslice_unpacker_->set_tof_unpacker_output_filename(ss.str());
-      timeslice_unpacker_->saveTofDigiVectorToDisk();
+    sink_latency_metric_.observe(std::chrono::steady_clock::now() -
+                                 put_begin);
+    uint64_t bytes = 0;
+    for (uint64_t c = 0; c < ts->num_components(); ++c) {
+      bytes += ts->size_component(c);
     }
+    timeslices_metric_.add();
+    bytes_metric_.add(bytes);
+    telemetry_.add(bytes);
+    telemetry_.touch();
     ++count_;
     if (count_ == limit) {
       break;
     }
   }
 
-  if (par_.tof_unpacker_merge_output()) {
+  if (pipeline_ != nullptr) {
+    pipeline_->close();
+    pipeline_->log_statistics(std::to_string(par_.client_index()) + ": ");
+  }
+
+  if (worker_pool_ != nullptr) {
+    worker_pool_->close();
+    L_(info) << par_.client_index() << ": " << worker_pool_->size()
+             << " analysis workers, max reorder depth "
+             << worker_pool_->max_reorder_depth() << "/"
+             << par_.reorder_window();
+  }
+
+  if (timeslice_unpacker_ != nullptr && par_.tof_unpacker_merge_output()) {
     timeslice_unpacker_->saveTofDigiVectorToDisk();
   }
 }
+
+std::ostream& Application::sink_log(severity_level level) {
+  sink_logs_.emplace_back(new logging::OstreamLog(level));
+  return sink_logs_.back()->stream;
+}
+
+void Application::add_sink(std::unique_ptr<fles::TimesliceSink> sink,
+                           const std::string& name) {
+  sinks_.push_back(std::move(sink));
+  sink_names_.push_back(name);
+}
@@ -2,12 +2,18 @@
 #pragma once
 
 #include "Benchmark.hpp"
+#include "Metrics.hpp"
+#include "MetricsExporter.hpp"
 #include "Parameters.hpp"
 #include "Sink.hpp"
+#include "TimesliceSinkPipeline.hpp"
 #include "TimesliceSource.hpp"
+#include "TraceRecorder.hpp"
+#include "WorkerPoolSink.hpp"
 #include "log.hpp"
 #include <chrono>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "TimesliceUnpacker.hpp"
@@ -28,17 +34,40 @@ private:
   Parameters const& par_;
 
   std::unique_ptr<fles::TimesliceSource> source_;
+  /// Log streams of the sinks (must outlive the sinks).
+  std::vector<std::unique_ptr<logging::OstreamLog>> sink_logs_;
+
   std::vector<std::unique_ptr<fles::TimesliceSink>> sinks_;
+  std::vector<std::string> sink_names_;
+
+  /// The parallel sink pipeline (owned by sinks_, nullptr if disabled).
+  TimesliceSinkPipeline* pipeline_ = nullptr;
+
+  /// The analysis worker pool (owned by a sink, nullptr if disabled).
+  fles::TimesliceWorkerPool* worker_pool_ = nullptr;
   std::unique_ptr<Benchmark> benchmark_;
 
-  TimesliceUnpacker* timeslice_unpacker_;
+  TimesliceUnpacker* timeslice_unpacker_ = nullptr;
 
   uint64_t count_ = 0;
 
-  logging::OstreamLog status_log_{status};
-  logging::OstreamLog debug_log_{debug};
+  std::vector<std::unique_ptr<MetricsExporter>> metrics_exporters_;
+  MetricCounter& timeslices_metric_;
+  MetricCounter& bytes_metric_;
+  MetricHistogram& sink_latency_metric_;
+  TelemetryChannel& telemetry_;
+
+  std::unique_ptr<TraceRecorder> trace_;
 
   std::chrono::high_resolution_clock::time_point time_begin_;
 
   void rate_limit_delay() const;
+
+  /// Create a log stream for a sink. The sinks may run in parallel (in
+  /// the sink pipeline or the worker pool), so they cannot share one.
+  std::ostream& sink_log(severity_level level);
+
+  /// Add a sink with a given name (used in the pipeline statistics).
+  void add_sink(std::unique_ptr<fles::TimesliceSink> sink,
+                const std::string& name);
 };
@@ -93,6 +93,25 @@ void Parameters::parse_options(int argc, char* argv[]) {
            "unlimited)");
   desc_add("rate-limit", po::value<double>(&rate_limit_),
            "limit the item rate to given frequency (in Hz)");
+  desc_add("sink-queue", po::value<size_t>(&sink_queue_size_),
+           "number of timeslices queued per sink, each sink runs in its own "
+           "thread (default: 8, 0: run all sinks sequentially)");
+  desc_add("workers", po::value<uint32_t>(&workers_),
+           "number of threads for the timeslice analysis (default: 1); the "
+           "output archive then receives the timeslices in order after "
+           "analysis");
+  desc_add("reorder-window", po::value<size_t>(&reorder_window_),
+           "maximum number of timeslices in the worker pool, including "
+           "those waiting to be passed on in order (default: 16)");
+  desc_add("metrics",
+           po::value<std::vector<std::string>>(&metrics_uris_)->multitoken(),
+           "export metrics (http://<address>:<port>, udp://<host>:<port> or "
+           "file://<path>)");
+  desc_add("trace", po::value<std::string>(&trace_prefix_),
+           "record per-timeslice trace points to file "
+           "<prefix>.t<client index>.trace (see tstrace)");
+  desc_add("trace-sampling", po::value<uint64_t>(&trace_sampling_),
+           "trace only every n-th timeslice (default: 1)");
 
   po::variables_map vm;
   po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -127,6 +146,13 @@ void Parameters::parse_options(int argc, char* argv[]) {
     throw ParametersException("more than one input source specified");
   }
 
+  if (workers_ == 0) {
+    throw ParametersException("number of workers must be at least 1");
+  }
+  if (workers_ > 1 && histograms_) {
+    throw ParametersException("histogram output requires a single worker");
+  }
+
   // if no mapping file parameter given fallback to mapping.par in CWD
   if (vm.count("tof-unpacker-mapping") < 1) {
     tof_unpacker_mapping_ = "mapping.par";
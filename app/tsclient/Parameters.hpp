@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 /// Run parameter exception class.
 class ParametersException : public std::runtime_error {
@@ -71,6 +72,18 @@ public:
 
   double rate_limit() const { return rate_limit_; }
 
+  size_t sink_queue_size() const { return sink_queue_size_; }
+
+  uint32_t workers() const { return workers_; }
+
+  size_t reorder_window() const { return reorder_window_; }
+
+  std::vector<std::string> metrics_uris() const { return metrics_uris_; }
+
+  std::string trace_prefix() const { return trace_prefix_; }
+
+  uint64_t trace_sampling() const { return trace_sampling_; }
+
 private:
   void parse_options(int argc, char* argv[]);
 
@@ -98,4 +111,10 @@ private:
   uint32_t subscribe_hwm_ = 1;
   uint64_t maximum_number_ = UINT64_MAX;
   double rate_limit_ = 0.0;
+  size_t sink_queue_size_ = 8;
+  uint32_t workers_ = 1;
+  size_t reorder_window_ = 16;
+  std::vector<std::string> metrics_uris_;
+  std::string trace_prefix_;
+  uint64_t trace_sampling_ = 1;
 };
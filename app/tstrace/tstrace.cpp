@@ -0,0 +1,239 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// Analysis of per-timeslice trace files (see TraceRecorder).
+/** The trace records of all given files are joined by timeslice index.
+    For each timeslice and stage, the time of the last component reaching
+    the stage is used (e.g., a timeslice is written to the input buffers
+    when the slowest input has written its component). The tool reports
+    the latency distribution of each stage relative to the previous one,
+    the end-to-end latency, and the latencies per compute node and
+    consumer, marking the slowest of each. */
+
+#include "LatencyHistogram.hpp"
+#include "TraceRecorder.hpp"
+#include <boost/program_options.hpp>
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace po = boost::program_options;
+
+namespace {
+
+constexpr int64_t no_time = std::numeric_limits<int64_t>::min();
+constexpr uint32_t no_component = UINT32_MAX;
+
+/// The trace points of a single timeslice.
+struct TimesliceTrace {
+  TimesliceTrace() {
+    time.fill(no_time);
+    component.fill(no_component);
+  }
+
+  bool has(TraceStage stage) const {
+    return time[static_cast<size_t>(stage)] != no_time;
+  }
+
+  int64_t at(TraceStage stage) const {
+    return time[static_cast<size_t>(stage)];
+  }
+
+  uint32_t component_at(TraceStage stage) const {
+    return component[static_cast<size_t>(stage)];
+  }
+
+  /// Time of the last component reaching each stage.
+  std::array<int64_t, num_trace_stages> time;
+  /// Component that reached each stage last.
+  std::array<uint32_t, num_trace_stages> component;
+};
+
+/// Latency histogram with a count of negative (clock skew) values.
+struct Latencies {
+  void add(int64_t from, int64_t to) {
+    if (to < from) {
+      ++negative;
+    }
+    histogram.add(std::chrono::nanoseconds(to - from));
+  }
+
+  LatencyHistogram histogram;
+  uint64_t negative = 0;
+};
+
+double us(std::chrono::nanoseconds ns) {
+  return static_cast<double>(ns.count()) * 1e-3;
+}
+
+void print_header(const std::string& caption) {
+  std::cout << std::left << std::setw(40) << caption << std::right
+            << std::setw(10) << "count" << std::setw(12) << "p50/us"
+            << std::setw(12) << "p90/us" << std::setw(12) << "p99/us"
+            << std::setw(12) << "max/us" << std::endl;
+}
+
+void print_line(const std::string& name,
+                const Latencies& l,
+                const std::string& note = std::string()) {
+  const LatencyHistogram& h = l.histogram;
+  std::cout << std::left << std::setw(40) << name << std::right
+            << std::setw(10) << h.count() << std::fixed
+            << std::setprecision(1) << std::setw(12) << us(h.quantile(0.5))
+            << std::setw(12) << us(h.quantile(0.9)) << std::setw(12)
+            << us(h.quantile(0.99)) << std::setw(12) << us(h.max());
+  if (l.negative != 0) {
+    std::cout << "  (" << l.negative << " negative, clocks unsynchronized?)";
+  }
+  std::cout << note << std::endl;
+}
+
+/// Print per-component latencies and mark the one with the highest p99.
+void print_components(const std::string& caption,
+                      const std::string& prefix,
+                      const std::map<uint32_t, Latencies>& latencies) {
+  if (latencies.empty()) {
+    return;
+  }
+  uint32_t slowest = latencies.begin()->first;
+  for (const auto& l : latencies) {
+    if (l.second.histogram.quantile(0.99) >
+        latencies.at(slowest).histogram.quantile(0.99)) {
+      slowest = l.first;
+    }
+  }
+  std::cout << std::endl;
+  print_header(caption);
+  for (const auto& l : latencies) {
+    std::string name = l.first == no_component
+                           ? prefix + " (shared queue)"
+                           : prefix + " " + std::to_string(l.first);
+    print_line(name, l.second,
+               (latencies.size() > 1 && l.first == slowest) ? "  <- slowest"
+                                                            : "");
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    std::vector<std::string> files;
+
+    po::options_description desc("Allowed options");
+    auto desc_add = desc.add_options();
+    desc_add("help,h", "produce help message");
+    desc_add("trace-file",
+             po::value<std::vector<std::string>>(&files)->value_name("<file>"),
+             "trace file to analyze (also as positional arguments)");
+
+    po::positional_options_description pos_desc;
+    pos_desc.add("trace-file", -1);
+
+    po::variables_map vm;
+    po::store(po::command_line_parser(argc, argv)
+                  .options(desc)
+                  .positional(pos_desc)
+                  .run(),
+              vm);
+    po::notify(vm);
+
+    if (vm.count("help") != 0u || files.empty()) {
+      std::cout << "Usage: tstrace [options] <trace file> ...\n"
+                << desc << std::endl;
+      return files.empty() && vm.count("help") == 0u ? EXIT_FAILURE
+                                                     : EXIT_SUCCESS;
+    }
+
+    // join the records of all files by timeslice index
+    std::map<uint64_t, TimesliceTrace> traces;
+    uint64_t num_records = 0;
+    for (const auto& file : files) {
+      for (const TraceRecord& r : TraceRecorder::read(file)) {
+        if (r.stage >= num_trace_stages) {
+          continue;
+        }
+        TimesliceTrace& t = traces[r.timeslice];
+        if (r.time > t.time[r.stage]) {
+          t.time[r.stage] = r.time;
+          t.component[r.stage] = r.component;
+        }
+        ++num_records;
+      }
+    }
+    std::cout << num_records << " records of " << traces.size()
+              << " timeslices from " << files.size() << " files" << std::endl;
+
+    std::array<Latencies, num_trace_stages> stage_latencies;
+    Latencies total;
+    std::map<uint32_t, Latencies> transfer_per_cn;
+    std::map<uint32_t, Latencies> processing_per_cn;
+    std::map<uint32_t, Latencies> per_consumer;
+    std::map<uint32_t, uint64_t> last_input;
+
+    for (const auto& entry : traces) {
+      const TimesliceTrace& t = entry.second;
+      for (size_t s = 1; s < num_trace_stages; ++s) {
+        if (t.time[s] != no_time && t.time[s - 1] != no_time) {
+          stage_latencies[s].add(t.time[s - 1], t.time[s]);
+        }
+      }
+      if (t.has(TraceStage::InputWritten) &&
+          t.has(TraceStage::CompletionReturned)) {
+        total.add(t.at(TraceStage::InputWritten),
+                  t.at(TraceStage::CompletionReturned));
+      }
+      if (t.has(TraceStage::InputWritten)) {
+        ++last_input[t.component_at(TraceStage::InputWritten)];
+      }
+      if (t.has(TraceStage::BuilderComplete)) {
+        uint32_t cn = t.component_at(TraceStage::BuilderComplete);
+        if (t.has(TraceStage::SendPosted)) {
+          transfer_per_cn[cn].add(t.at(TraceStage::SendPosted),
+                                  t.at(TraceStage::BuilderComplete));
+        }
+        if (t.has(TraceStage::CompletionReturned)) {
+          processing_per_cn[cn].add(t.at(TraceStage::BuilderComplete),
+                                    t.at(TraceStage::CompletionReturned));
+        }
+      }
+      if (t.has(TraceStage::WorkItemQueued) &&
+          t.has(TraceStage::CompletionReturned)) {
+        per_consumer[t.component_at(TraceStage::CompletionReturned)].add(
+            t.at(TraceStage::WorkItemQueued),
+            t.at(TraceStage::CompletionReturned));
+      }
+    }
+
+    std::cout << std::endl;
+    print_header("stage (latency from previous stage)");
+    for (size_t s = 1; s < num_trace_stages; ++s) {
+      print_line(trace_stage_name(static_cast<TraceStage>(s)),
+                 stage_latencies[s]);
+    }
+    print_line("end-to-end", total);
+
+    print_components("compute node (send posted..complete)", "compute node",
+                     transfer_per_cn);
+    print_components("compute node (complete..completion)", "compute node",
+                     processing_per_cn);
+    print_components("consumer (queued..completion)", "consumer",
+                     per_consumer);
+
+    if (last_input.size() > 1) {
+      std::cout << std::endl << "last input to write a timeslice:";
+      for (const auto& l : last_input) {
+        std::cout << " input " << l.first << ": " << l.second;
+      }
+      std::cout << std::endl;
+    }
+  } catch (std::exception& e) {
+    std::cerr << "error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
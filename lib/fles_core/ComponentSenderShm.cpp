@@ -0,0 +1,105 @@
+// Copyright 2026 agent <agent@local>
+
+#include "ComponentSenderShm.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include "Utility.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <thread>
+
+ComponentSenderShm::ComponentSenderShm(uint64_t input_index,
+                                       ShmTransport& transport,
+                                       uint32_t max_timeslice_number,
+                                       volatile sig_atomic_t* signal_status)
+    : input_index_(input_index), transport_(transport),
+      input_(transport.input(input_index)), data_source_(input_.data_source),
+      max_timeslice_number_(max_timeslice_number),
+      signal_status_(signal_status),
+      min_acked_({data_source_.desc_buffer().size() / 4,
+                  data_source_.data_buffer().size() / 4}) {
+  acked_ = cached_acked_ = input_.start_index;
+}
+
+void ComponentSenderShm::operator()() {
+  data_source_.proceed();
+  time_begin_ = std::chrono::high_resolution_clock::now();
+  scheduler_.add_periodic(report_metrics_timer_, std::chrono::seconds(1));
+
+  while (acked_ts_ < max_timeslice_number_ && *signal_status_ == 0) {
+    if (!run_cycle()) {
+      std::this_thread::yield();
+    }
+    scheduler_.timer();
+  }
+
+  sync_data_source();
+  time_end_ = std::chrono::high_resolution_clock::now();
+
+  double runtime =
+      std::chrono::duration<double>(time_end_ - time_begin_).count();
+  uint64_t bytes = acked_.data - input_.start_index.data;
+  L_(info) << "[i" << input_index_ << "] " << acked_ts_
+           << " timeslices, " << human_readable_count(bytes) << " ("
+           << human_readable_count(
+                  static_cast<uint64_t>(static_cast<double>(bytes) / runtime),
+                  true, "B/s")
+           << ")";
+}
+
+bool ComponentSenderShm::run_cycle() {
+  bool active = false;
+
+  data_source_.proceed();
+  uint64_t write_index_desc = data_source_.get_write_index().desc;
+  if (write_index_desc != write_index_desc_) {
+    write_index_desc_ = write_index_desc;
+    input_.write_index_desc.store(write_index_desc_,
+                                  std::memory_order_release);
+    active = true;
+  }
+
+  uint64_t acked_ts =
+      std::min<uint64_t>(transport_.acked_timeslices(), max_timeslice_number_);
+  if (acked_ts > acked_ts_) {
+    DualIndex previous = acked_;
+    uint64_t previous_ts = acked_ts_;
+    acked_ts_ = acked_ts;
+    acked_.desc =
+        acked_ts_ * transport_.timeslice_size() + input_.start_index.desc;
+    acked_.data = data_source_.desc_buffer().at(acked_.desc - 1).offset +
+                  data_source_.desc_buffer().at(acked_.desc - 1).size;
+    metrics_.add_timeslice(acked_.data - previous.data +
+                               (acked_.desc - previous.desc) *
+                                   sizeof(fles::MicrosliceDescriptor),
+                           acked_ts_ - previous_ts);
+    if (acked_.data >= cached_acked_.data + min_acked_.data ||
+        acked_.desc >= cached_acked_.desc + min_acked_.desc) {
+      cached_acked_ = acked_;
+      data_source_.set_read_index(cached_acked_);
+    }
+    active = true;
+  }
+
+  return active;
+}
+
+void ComponentSenderShm::sync_data_source() {
+  if (acked_.data > cached_acked_.data || acked_.desc > cached_acked_.desc) {
+    cached_acked_ = acked_;
+    data_source_.set_read_index(cached_acked_);
+  }
+}
+
+void ComponentSenderShm::report_metrics() {
+  DualIndex written = data_source_.get_write_index();
+  metrics_.set_buffer_fill(
+      static_cast<double>(written.data - cached_acked_.data) /
+          static_cast<double>(data_source_.data_buffer().size()),
+      static_cast<double>(written.desc - cached_acked_.desc) /
+          static_cast<double>(data_source_.desc_buffer().size()));
+  metrics_.telemetry().data.set(cached_acked_.data, written.data,
+                                data_source_.data_buffer().size());
+  metrics_.telemetry().desc.set(cached_acked_.desc, written.desc,
+                                data_source_.desc_buffer().size());
+  metrics_.update_rates();
+}
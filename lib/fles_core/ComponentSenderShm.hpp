@@ -0,0 +1,90 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "DualRingBuffer.hpp"
+#include "Metrics.hpp"
+#include "Scheduler.hpp"
+#include "ShmTransport.hpp"
+#include <chrono>
+#include <csignal>
+
+/// Input channel of the intra-node transport.
+/** A ComponentSenderShm object drives an input buffer (filled by a FLIB
+    or pattern generator) for the timeslice builders of the same process.
+    It publishes the buffer's write index to the builders and frees buffer
+    space once all builders have copied the respective timeslices. No
+    data is moved by this object, see TimesliceBuilderShm. */
+
+class ComponentSenderShm {
+public:
+  /// The ComponentSenderShm constructor.
+  ComponentSenderShm(uint64_t input_index,
+                     ShmTransport& transport,
+                     uint32_t max_timeslice_number,
+                     volatile sig_atomic_t* signal_status);
+
+  ComponentSenderShm(const ComponentSenderShm&) = delete;
+  void operator=(const ComponentSenderShm&) = delete;
+
+  /// The thread main function.
+  void operator()();
+
+private:
+  /// This component's index in the list of input components.
+  const uint64_t input_index_;
+
+  /// The shared state of the intra-node transport.
+  ShmTransport& transport_;
+
+  /// This component's shared state.
+  ShmTransport::Input& input_;
+
+  /// Data source (e.g., FLIB via shared memory).
+  InputBufferReadInterface& data_source_;
+
+  /// Number of timeslices after which this run shall end.
+  const uint32_t max_timeslice_number_;
+
+  /// Pointer to global signal status variable.
+  volatile sig_atomic_t* signal_status_;
+
+  /// Number of timeslices copied by all timeslice builders.
+  uint64_t acked_ts_ = 0;
+
+  /// Indexes of acknowledged microslices (i.e., read indexes).
+  DualIndex acked_;
+
+  /// Hysteresis for writing read indexes to data source.
+  const DualIndex min_acked_;
+
+  /// Read indexes last written to data source.
+  DualIndex cached_acked_;
+
+  /// Write index last published to the timeslice builders.
+  uint64_t write_index_desc_ = 0;
+
+  /// Begin of operation (for performance statistics).
+  std::chrono::high_resolution_clock::time_point time_begin_;
+
+  /// End of operation (for performance statistics).
+  std::chrono::high_resolution_clock::time_point time_end_;
+
+  /// Progress and buffer metrics of this component sender.
+  ComponentMetrics metrics_{"input", input_index_};
+
+  /// Scheduler for periodic events.
+  Scheduler scheduler_;
+
+  /// Timer for the periodic metrics update.
+  Scheduler::Timer report_metrics_timer_{[this] { report_metrics(); }};
+
+  /// Publish new data and update read indexes, return true if anything
+  /// has changed.
+  bool run_cycle();
+
+  /// Force writing read indexes to data source.
+  void sync_data_source();
+
+  /// Update the buffer fill level and rate metrics.
+  void report_metrics();
+};
@@ -13,4 +13,20 @@ public:
   /// The "main" function of an IBConnectionGroup & ConnectionGroup decendant.
   virtual void operator()() = 0;
   virtual ~ConnectionGroupWorker() = default;
+
+  /// Stepwise operation, allows several workers to share a single thread
+  /// (see WorkerGroup). The default implementation runs the main function
+  /// to completion in the first step.
+
+  /// Connect and prepare the main loop.
+  virtual void start() {}
+
+  /// Perform one iteration of the main loop, return false when done.
+  virtual bool step() {
+    operator()();
+    return false;
+  }
+
+  /// Disconnect and report results.
+  virtual void stop() {}
 };
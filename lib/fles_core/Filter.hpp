@@ -9,6 +9,7 @@
 #include <deque>
 #include <memory>
 #include <queue>
+#include <type_traits>
 #include <utility>
 
 namespace fles {
@@ -21,6 +22,14 @@ public:
   virtual filter_output_t
   exchange_item(std::shared_ptr<const Input> item = nullptr) = 0;
 
+  /// Exchange an item with the filter, transferring its ownership.
+  /** A filter that can reuse the item (e.g., modify it in place instead of
+      copying it) overrides this. By default, the item is passed on to
+      exchange_item(). */
+  virtual filter_output_t take_item(std::unique_ptr<Input> item) {
+    return exchange_item(std::shared_ptr<const Input>(std::move(item)));
+  }
+
   virtual ~Filter() = default;
 };
 
@@ -53,8 +62,19 @@ protected:
   virtual void process() = 0;
 };
 
-template <class Input, class Output = Input>
-class FilteredSource : public Source<Output> {
+/**
+ * \brief The FilteredSource class applies a filter to the items of a source.
+ *
+ * The items are handed over to the filter with their ownership, and the
+ * items produced by the filter are passed on without a copy. The items are
+ * delivered as Item, which may be a base class of Output (e.g., to chain
+ * several Filter<Microslice, StorableMicroslice> stages).
+ */
+template <class Input, class Output = Input, class Item = Output>
+class FilteredSource : public Source<Item> {
+  static_assert(std::is_convertible<Output*, Item*>::value,
+                "Output must be Item or derived from it");
+
 public:
   using source_t = Source<Input>;
   using filter_t = Filter<Input, Output>;
@@ -73,7 +93,7 @@ private:
 
   using filter_output_t = typename Filter<Input, Output>::filter_output_t;
 
-  Output* do_get() override {
+  Item* do_get() override {
     if (eos_flag) {
       return nullptr;
     }
@@ -81,19 +101,17 @@ private:
     filter_output_t filter_output;
     if (more) {
       filter_output = filter.exchange_item();
-    } else {
-      do {
-        auto item = source.get();
-        if (!item) {
-          eos_flag = true;
-          return nullptr;
-        }
-        filter_output = filter.exchange_item(std::move(item));
-      } while (!filter_output.first);
+    }
+    while (!filter_output.first) {
+      auto item = source.get();
+      if (!item) {
+        eos_flag = true;
+        return nullptr;
+      }
+      filter_output = filter.take_item(std::move(item));
     }
     more = filter_output.second;
-    return new Output(*filter_output.first);
-    // TODO(Jan): Solve this without the additional alloc/copy operation
+    return filter_output.first.release();
   }
 };
 
@@ -0,0 +1,68 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::FilterChain class.
+#pragma once
+
+#include "Filter.hpp"
+#include "Source.hpp"
+#include "ThreadedSource.hpp"
+#include <memory>
+#include <vector>
+
+namespace fles {
+
+/**
+ * \brief The FilterChain class applies a sequence of filters to a source.
+ *
+ * Each filter stage runs on the thread of the previous stage, or on a
+ * worker thread of its own (see ThreadedSource) if it is added with a queue
+ * capacity. The items are handed over from stage to stage with their
+ * ownership, so a filter working in place (see Filter::take_item()) does not
+ * copy them. The filters are not owned by the chain and have to be added
+ * before the first get().
+ */
+template <class Input, class Output = Input>
+class FilterChain : public Source<Input> {
+public:
+  using source_t = Source<Input>;
+  using filter_t = Filter<Input, Output>;
+
+  /// Construct FilterChain reading from a given source
+  explicit FilterChain(source_t& source) : last_(&source) {}
+
+  FilterChain(const FilterChain&) = delete;
+  void operator=(const FilterChain&) = delete;
+
+  ~FilterChain() override {
+    // stop the worker threads from downstream to upstream
+    while (!stages_.empty()) {
+      stages_.pop_back();
+    }
+  }
+
+  /// Append a filter stage. With a queue_capacity above 0, the stage runs on
+  /// a worker thread and reads ahead up to queue_capacity items.
+  void add(filter_t& filter, size_t queue_capacity = 0) {
+    stages_.emplace_back(
+        new FilteredSource<Input, Output, Input>(*last_, filter));
+    last_ = stages_.back().get();
+    if (queue_capacity > 0) {
+      stages_.emplace_back(new ThreadedSource<Input>(*last_, queue_capacity));
+      last_ = stages_.back().get();
+    }
+  }
+
+  bool eos() const override { return last_->eos(); }
+
+private:
+  Input* do_get() override { return last_->get().release(); }
+
+  std::vector<std::unique_ptr<source_t>> stages_;
+  source_t* last_;
+};
+
+class Microslice;
+class StorableMicroslice;
+using MicrosliceFilterChain = FilterChain<Microslice, StorableMicroslice>;
+
+} // namespace fles
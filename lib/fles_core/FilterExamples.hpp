@@ -6,6 +6,9 @@
 #include "Filter.hpp"
 #include "Microslice.hpp"
 #include "StorableMicroslice.hpp"
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace fles {
 
@@ -32,6 +35,21 @@ public:
 
     return std::make_pair(std::unique_ptr<StorableMicroslice>(m), false);
   }
+
+  std::pair<std::unique_ptr<StorableMicroslice>, bool>
+  take_item(std::unique_ptr<Microslice> item) override {
+    auto* storable = dynamic_cast<StorableMicroslice*>(item.get());
+    if (storable == nullptr) {
+      return exchange_item(std::move(item));
+    }
+    // Modify the microslice in place instead of copying it
+    std::unique_ptr<StorableMicroslice> m(storable);
+    item.release();
+    m->desc().sys_id = sys_id_;
+    m->desc().sys_ver = sys_ver_;
+
+    return std::make_pair(std::move(m), false);
+  }
 };
 
 // Example filter 2: Combine microslices
@@ -0,0 +1,66 @@
+// Copyright 2026 agent <agent@local>
+
+#include "LatencyHistogram.hpp"
+#include <algorithm>
+#include <cmath>
+
+void LatencyHistogram::add(std::chrono::nanoseconds latency) {
+  uint64_t value = latency.count() > 0 ? static_cast<uint64_t>(latency.count())
+                                       : 0;
+  ++bins_[bin(value)];
+  ++count_;
+  max_ = std::max(max_, value);
+}
+
+LatencyHistogram& LatencyHistogram::operator+=(const LatencyHistogram& other) {
+  for (size_t i = 0; i < num_bins; ++i) {
+    bins_[i] += other.bins_[i];
+  }
+  count_ += other.count_;
+  max_ = std::max(max_, other.max_);
+  return *this;
+}
+
+void LatencyHistogram::update_max(std::chrono::nanoseconds value) {
+  if (value.count() > 0) {
+    max_ = std::max(max_, static_cast<uint64_t>(value.count()));
+  }
+}
+
+std::chrono::nanoseconds LatencyHistogram::quantile(double q) const {
+  if (count_ == 0) {
+    return std::chrono::nanoseconds(0);
+  }
+  auto rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(count_)));
+  rank = std::max<uint64_t>(rank, 1);
+  uint64_t sum = 0;
+  for (size_t i = 0; i < num_bins; ++i) {
+    sum += bins_[i];
+    if (sum >= rank) {
+      return std::chrono::nanoseconds(std::min(bin_end(i), max_));
+    }
+  }
+  return std::chrono::nanoseconds(max_);
+}
+
+size_t LatencyHistogram::bin(uint64_t value) {
+  if (value < sub_bins) {
+    return static_cast<size_t>(value);
+  }
+  // position of the most significant bit
+  unsigned msb = 63 - static_cast<unsigned>(__builtin_clzll(value));
+  unsigned shift = msb - sub_bin_bits;
+  return (shift + 1) * sub_bins +
+         static_cast<size_t>((value >> shift) - sub_bins);
+}
+
+uint64_t LatencyHistogram::bin_end(size_t index) {
+  if (index < sub_bins) {
+    return index + 1;
+  }
+  size_t shift = index / sub_bins - 1;
+  uint64_t begin = (sub_bins + index % sub_bins) << shift;
+  // saturate the end of the topmost bin
+  uint64_t width = UINT64_C(1) << shift;
+  return begin > UINT64_MAX - width ? UINT64_MAX : begin + width;
+}
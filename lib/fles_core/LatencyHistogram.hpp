@@ -0,0 +1,56 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/// Latency histogram class.
+/** A LatencyHistogram counts latency values in logarithmic bins of
+    nanoseconds. Each power of two is subdivided into sub_bins linear
+    bins, so quantiles are accurate to 1/sub_bins relative to the value
+    while the histogram has a fixed size and never allocates. */
+
+class LatencyHistogram {
+public:
+  static constexpr unsigned sub_bin_bits = 3;
+  static constexpr size_t sub_bins = size_t(1) << sub_bin_bits;
+  static constexpr size_t num_bins = (65 - sub_bin_bits) * sub_bins;
+
+  /// Add a single latency value.
+  void add(std::chrono::nanoseconds latency);
+
+  /// Merge the contents of another histogram.
+  LatencyHistogram& operator+=(const LatencyHistogram& other);
+
+  /// Add n values to a given bin (e.g., copied from another histogram).
+  void add_bin(size_t index, uint64_t n) {
+    bins_[index] += n;
+    count_ += n;
+  }
+
+  /// Account a value for the maximum only (e.g., along with add_bin()).
+  void update_max(std::chrono::nanoseconds value);
+
+  uint64_t count() const { return count_; }
+
+  std::chrono::nanoseconds max() const {
+    return std::chrono::nanoseconds(max_);
+  }
+
+  /// Retrieve the latency below which the fraction q of values lies (upper
+  /// edge of the corresponding bin, at most the maximum value).
+  std::chrono::nanoseconds quantile(double q) const;
+
+  /// Bin index of a given value in nanoseconds.
+  static size_t bin(uint64_t value);
+
+  /// Upper edge (exclusive) of a given bin in nanoseconds.
+  static uint64_t bin_end(size_t index);
+
+private:
+  std::array<uint64_t, num_bins> bins_{};
+  uint64_t count_ = 0;
+  uint64_t max_ = 0;
+};
@@ -0,0 +1,315 @@
+// Copyright 2026 agent <agent@local>
+
+#include "Metrics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+/// Escape a Prometheus label value.
+std::string prometheus_escape(const std::string& s) {
+  std::string result;
+  for (char c : s) {
+    if (c == '\\' || c == '"') {
+      result += '\\';
+      result += c;
+    } else if (c == '\n') {
+      result += "\\n";
+    } else {
+      result += c;
+    }
+  }
+  return result;
+}
+
+/// Escape an InfluxDB tag key or value.
+std::string influx_escape(const std::string& s) {
+  std::string result;
+  for (char c : s) {
+    if (c == ',' || c == ' ' || c == '=') {
+      result += '\\';
+    }
+    result += c;
+  }
+  return result;
+}
+
+/// Append a float field to InfluxDB line protocol fields. The protocol
+/// cannot represent infinity or NaN, so non-finite values are skipped.
+void influx_field(std::ostringstream& fields, const char* key, double value) {
+  if (!std::isfinite(value)) {
+    return;
+  }
+  if (fields.tellp() > 0) {
+    fields << ",";
+  }
+  fields << key << "=" << value;
+}
+
+/// Format labels (and an optional additional label) for Prometheus.
+std::string prometheus_labels(const MetricLabels& labels,
+                              const std::string& extra = std::string()) {
+  if (labels.empty() && extra.empty()) {
+    return std::string();
+  }
+  std::string s = "{";
+  for (const auto& label : labels) {
+    if (s.size() > 1) {
+      s += ",";
+    }
+    s += label.first + "=\"" + prometheus_escape(label.second) + "\"";
+  }
+  if (!extra.empty()) {
+    if (s.size() > 1) {
+      s += ",";
+    }
+    s += extra;
+  }
+  return s + "}";
+}
+
+} // namespace
+
+void MetricHistogram::observe(std::chrono::nanoseconds duration) {
+  uint64_t ns = duration.count() > 0 ? static_cast<uint64_t>(duration.count())
+                                     : 0;
+  bins_[LatencyHistogram::bin(ns)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+  uint64_t max = max_ns_.load(std::memory_order_relaxed);
+  while (ns > max && !max_ns_.compare_exchange_weak(
+                         max, ns, std::memory_order_relaxed)) {
+  }
+}
+
+size_t MetricHistogram::bucket_end_bin(size_t index) {
+  return LatencyHistogram::bin(UINT64_C(1) << (index + 10));
+}
+
+double MetricHistogram::bucket_bound(size_t index) {
+  return 1e-9 * static_cast<double>(UINT64_C(1) << (index + 10));
+}
+
+uint64_t MetricHistogram::bucket(size_t index) const {
+  size_t begin = index == 0 ? 0 : bucket_end_bin(index - 1);
+  uint64_t n = 0;
+  for (size_t i = begin; i < bucket_end_bin(index); ++i) {
+    n += bins_[i].load(std::memory_order_relaxed);
+  }
+  return n;
+}
+
+double MetricHistogram::quantile(double q) const {
+  return std::chrono::duration<double>(snapshot().quantile(q)).count();
+}
+
+LatencyHistogram MetricHistogram::snapshot() const {
+  LatencyHistogram h;
+  for (size_t i = 0; i < LatencyHistogram::num_bins; ++i) {
+    h.add_bin(i, bins_[i].load(std::memory_order_relaxed));
+  }
+  h.update_max(
+      std::chrono::nanoseconds(max_ns_.load(std::memory_order_relaxed)));
+  return h;
+}
+
+MetricsRegistry::Entry& MetricsRegistry::entry(Type type,
+                                               const std::string& name,
+                                               const MetricLabels& labels,
+                                               const std::string& help) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& e : entries_) {
+    if (e->name == name && e->labels == labels) {
+      if (e->type != type) {
+        throw std::runtime_error("metric registered with different type: " +
+                                 name);
+      }
+      return *e;
+    }
+  }
+  std::unique_ptr<Entry> e(new Entry{type, name, labels, help, nullptr,
+                                     nullptr, nullptr});
+  switch (type) {
+  case Type::Counter:
+    e->counter.reset(new MetricCounter);
+    break;
+  case Type::Gauge:
+    e->gauge.reset(new MetricGauge);
+    break;
+  case Type::Histogram:
+    e->histogram.reset(new MetricHistogram);
+    break;
+  }
+  entries_.push_back(std::move(e));
+  return *entries_.back();
+}
+
+MetricCounter& MetricsRegistry::counter(const std::string& name,
+                                        const MetricLabels& labels,
+                                        const std::string& help) {
+  return *entry(Type::Counter, name, labels, help).counter;
+}
+
+MetricGauge& MetricsRegistry::gauge(const std::string& name,
+                                    const MetricLabels& labels,
+                                    const std::string& help) {
+  return *entry(Type::Gauge, name, labels, help).gauge;
+}
+
+MetricHistogram& MetricsRegistry::histogram(const std::string& name,
+                                            const MetricLabels& labels,
+                                            const std::string& help) {
+  return *entry(Type::Histogram, name, labels, help).histogram;
+}
+
+void MetricsRegistry::write_prometheus(std::ostream& out) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // group the entries by name, in order of registration
+  std::vector<const Entry*> sorted;
+  for (const auto& e : entries_) {
+    sorted.push_back(e.get());
+  }
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const Entry* a, const Entry* b) {
+                     return a->name < b->name;
+                   });
+
+  std::string previous_name;
+  for (const Entry* e : sorted) {
+    if (e->name != previous_name) {
+      previous_name = e->name;
+      static const char* type_names[] = {"counter", "gauge", "histogram"};
+      out << "# HELP " << e->name << " " << e->help << "\n";
+      out << "# TYPE " << e->name << " "
+          << type_names[static_cast<int>(e->type)] << "\n";
+    }
+    switch (e->type) {
+    case Type::Counter:
+      out << e->name << prometheus_labels(e->labels) << " "
+          << e->counter->value() << "\n";
+      break;
+    case Type::Gauge:
+      out << e->name << prometheus_labels(e->labels) << " "
+          << e->gauge->value() << "\n";
+      break;
+    case Type::Histogram: {
+      const MetricHistogram& h = *e->histogram;
+      uint64_t cumulative = 0;
+      for (size_t i = 0; i < MetricHistogram::num_buckets; ++i) {
+        cumulative += h.bucket(i);
+        std::ostringstream le;
+        le << "le=\"" << MetricHistogram::bucket_bound(i) << "\"";
+        out << e->name << "_bucket" << prometheus_labels(e->labels, le.str())
+            << " " << cumulative << "\n";
+      }
+      out << e->name << "_bucket" << prometheus_labels(e->labels, "le=\"+Inf\"")
+          << " " << h.count() << "\n";
+      out << e->name << "_sum" << prometheus_labels(e->labels) << " "
+          << h.sum() << "\n";
+      out << e->name << "_count" << prometheus_labels(e->labels) << " "
+          << h.count() << "\n";
+      break;
+    }
+    }
+  }
+}
+
+void MetricsRegistry::write_influx(
+    std::ostream& out, std::chrono::system_clock::time_point time) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       time.time_since_epoch())
+                       .count();
+  for (const auto& e : entries_) {
+    std::ostringstream fields;
+    switch (e->type) {
+    case Type::Counter:
+      fields << "value=" << e->counter->value() << "i";
+      break;
+    case Type::Gauge:
+      influx_field(fields, "value", e->gauge->value());
+      break;
+    case Type::Histogram: {
+      const MetricHistogram& h = *e->histogram;
+      fields << "count=" << h.count() << "i";
+      influx_field(fields, "sum", h.sum());
+      influx_field(fields, "p50", h.quantile(0.5));
+      influx_field(fields, "p99", h.quantile(0.99));
+      break;
+    }
+    }
+    // a line without fields is invalid
+    if (fields.tellp() == 0) {
+      continue;
+    }
+    out << influx_escape(e->name);
+    for (const auto& label : e->labels) {
+      out << "," << influx_escape(label.first) << "="
+          << influx_escape(label.second);
+    }
+    out << " " << fields.str() << " " << timestamp << "\n";
+  }
+}
+
+ComponentMetrics::ComponentMetrics(const std::string& kind, uint64_t index)
+    : timeslices_(MetricsRegistry::get().counter(
+          "flesnet_timeslices_total",
+          {{"component", kind}, {"index", std::to_string(index)}},
+          "Number of timeslice components transferred")),
+      bytes_(MetricsRegistry::get().counter(
+          "flesnet_bytes_total",
+          {{"component", kind}, {"index", std::to_string(index)}},
+          "Number of bytes transferred")),
+      stalls_(MetricsRegistry::get().counter(
+          "flesnet_stalls_total",
+          {{"component", kind}, {"index", std::to_string(index)}},
+          "Number of timeslice components delayed by a full buffer")),
+      data_fill_(MetricsRegistry::get().gauge(
+          "flesnet_buffer_fill",
+          {{"component", kind},
+           {"index", std::to_string(index)},
+           {"buffer", "data"}},
+          "Fraction of the buffer in use")),
+      desc_fill_(MetricsRegistry::get().gauge(
+          "flesnet_buffer_fill",
+          {{"component", kind},
+           {"index", std::to_string(index)},
+           {"buffer", "desc"}},
+          "Fraction of the buffer in use")),
+      timeslice_rate_(MetricsRegistry::get().gauge(
+          "flesnet_timeslice_rate",
+          {{"component", kind}, {"index", std::to_string(index)}},
+          "Timeslice components transferred per second")),
+      byte_rate_(MetricsRegistry::get().gauge(
+          "flesnet_byte_rate",
+          {{"component", kind}, {"index", std::to_string(index)}},
+          "Bytes transferred per second")),
+      telemetry_(
+          Telemetry::get().add_channel(kind + " " + std::to_string(index))) {
+  previous_timeslices_ = timeslices_.value();
+  previous_bytes_ = bytes_.value();
+}
+
+void ComponentMetrics::update_rates() {
+  auto now = std::chrono::steady_clock::now();
+  double delta_t = std::chrono::duration<double>(now - previous_time_).count();
+  if (delta_t <= 0) {
+    return;
+  }
+  uint64_t timeslices = timeslices_.value();
+  uint64_t bytes = bytes_.value();
+  telemetry_.items.store(timeslices, std::memory_order_relaxed);
+  telemetry_.bytes.store(bytes, std::memory_order_relaxed);
+  telemetry_.stalls.store(stalls_.value(), std::memory_order_relaxed);
+  telemetry_.touch();
+  timeslice_rate_.set(static_cast<double>(timeslices - previous_timeslices_) /
+                      delta_t);
+  byte_rate_.set(static_cast<double>(bytes - previous_bytes_) / delta_t);
+  previous_time_ = now;
+  previous_timeslices_ = timeslices;
+  previous_bytes_ = bytes;
+}
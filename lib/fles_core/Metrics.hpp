@@ -0,0 +1,199 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "LatencyHistogram.hpp"
+#include "Telemetry.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Metric labels (key-value pairs), e.g. {{"input", "0"}}.
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/// Monotonically increasing counter metric.
+class MetricCounter {
+public:
+  void add(uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+
+  uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<uint64_t> value_{0};
+};
+
+/// Gauge metric, a value that can go up and down.
+class MetricGauge {
+public:
+  void set(double value) { value_.store(value, std::memory_order_relaxed); }
+
+  double value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<double> value_{0.0};
+};
+
+/// Latency histogram metric.
+/** Counts durations in the bins of a LatencyHistogram, using atomic
+    counters so it can be exported while being updated, and keeps their
+    sum. For export, the bins are combined into buckets with upper bounds of
+    powers of two nanoseconds (1.024 us to about 9 min). */
+class MetricHistogram {
+public:
+  static constexpr size_t num_buckets = 30;
+
+  void observe(std::chrono::nanoseconds duration);
+
+  /// Upper bound of a given bucket in seconds.
+  static double bucket_bound(size_t index);
+
+  /// Retrieve the number of values in a given bucket (not cumulative).
+  uint64_t bucket(size_t index) const;
+
+  /// Retrieve the number of values (including those above the last bucket).
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+  /// Retrieve the sum of all values in seconds.
+  double sum() const {
+    return static_cast<double>(sum_ns_.load(std::memory_order_relaxed)) *
+           1e-9;
+  }
+
+  /// Retrieve the latency below which the fraction q of values lies, in
+  /// seconds (see LatencyHistogram::quantile()).
+  double quantile(double q) const;
+
+  /// Copy the current contents to a LatencyHistogram.
+  LatencyHistogram snapshot() const;
+
+private:
+  /// Index of the first bin above a given bucket.
+  static size_t bucket_end_bin(size_t index);
+
+  std::array<std::atomic<uint64_t>, LatencyHistogram::num_bins> bins_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_ns_{0};
+  std::atomic<uint64_t> max_ns_{0};
+};
+
+/// Metrics registry class.
+/** The MetricsRegistry holds all counters, gauges and histograms of the
+    process. Metrics are registered once (under a lock) and then updated
+    through the returned reference from the hot paths, which only uses
+    relaxed atomic operations. Registering the same name and labels again
+    returns the existing metric.
+
+    The registry is read by the exporters (see MetricsExporter) in the
+    Prometheus text format or as InfluxDB line protocol. */
+
+class MetricsRegistry {
+public:
+  static MetricsRegistry& get() {
+    static MetricsRegistry instance;
+    return instance;
+  }
+
+  MetricsRegistry(const MetricsRegistry&) = delete;
+  void operator=(const MetricsRegistry&) = delete;
+
+  MetricCounter& counter(const std::string& name,
+                         const MetricLabels& labels,
+                         const std::string& help);
+
+  MetricGauge& gauge(const std::string& name,
+                     const MetricLabels& labels,
+                     const std::string& help);
+
+  MetricHistogram& histogram(const std::string& name,
+                             const MetricLabels& labels,
+                             const std::string& help);
+
+  /// Write all metrics in the Prometheus text exposition format.
+  void write_prometheus(std::ostream& out) const;
+
+  /// Write all metrics as InfluxDB line protocol, one line per metric
+  /// (measurement = metric name, tags = labels, timestamp in ns).
+  /// Non-finite values (e.g., an unbounded quantile) are omitted.
+  void write_influx(std::ostream& out,
+                    std::chrono::system_clock::time_point time) const;
+
+private:
+  MetricsRegistry() = default;
+
+  enum class Type { Counter, Gauge, Histogram };
+
+  struct Entry {
+    Type type;
+    std::string name;
+    MetricLabels labels;
+    std::string help;
+    std::unique_ptr<MetricCounter> counter;
+    std::unique_ptr<MetricGauge> gauge;
+    std::unique_ptr<MetricHistogram> histogram;
+  };
+
+  /// Find or create an entry of a given type.
+  Entry& entry(Type type,
+               const std::string& name,
+               const MetricLabels& labels,
+               const std::string& help);
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<Entry>> entries_;
+};
+
+/// Standard metrics of a transport component.
+/** Every input channel sender and timeslice builder reports its progress
+    and the fill level of its buffers through a ComponentMetrics object, so
+    that all transports can be monitored the same way. The metrics are
+    labelled with the component kind ("input" or "output") and index. */
+
+class ComponentMetrics {
+public:
+  ComponentMetrics(const std::string& kind, uint64_t index);
+
+  /// Account transferred timeslices (components) of a given total size.
+  void add_timeslice(uint64_t bytes, uint64_t timeslices = 1) {
+    timeslices_.add(timeslices);
+    bytes_.add(bytes);
+  }
+
+  /// Account a timeslice that was delayed by a full buffer.
+  void add_stall() { stalls_.add(); }
+
+  /// Set the buffer fill levels (fraction of the buffer in use, 0..1).
+  void set_buffer_fill(double data, double desc) {
+    data_fill_.set(data);
+    desc_fill_.set(desc);
+    telemetry_.data.fill.store(data, std::memory_order_relaxed);
+    telemetry_.desc.fill.store(desc, std::memory_order_relaxed);
+  }
+
+  /// Update the rate gauges from the counters and publish the telemetry
+  /// (call periodically).
+  void update_rates();
+
+  /// Telemetry channel of this component, e.g. to publish buffer indices.
+  TelemetryChannel& telemetry() { return telemetry_; }
+
+private:
+  MetricCounter& timeslices_;
+  MetricCounter& bytes_;
+  MetricCounter& stalls_;
+  MetricGauge& data_fill_;
+  MetricGauge& desc_fill_;
+  MetricGauge& timeslice_rate_;
+  MetricGauge& byte_rate_;
+  TelemetryChannel& telemetry_;
+
+  std::chrono::steady_clock::time_point previous_time_ =
+      std::chrono::steady_clock::now();
+  uint64_t previous_timeslices_ = 0;
+  uint64_t previous_bytes_ = 0;
+};
@@ -0,0 +1,308 @@
+// Copyright 2026 agent <agent@local>
+
+#include "MetricsExporter.hpp"
+#include "Metrics.hpp"
+#include "log.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <netdb.h>
+#include <poll.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+/// Split "<host>:<port>" into host and port.
+std::pair<std::string, uint16_t> split_host_port(const std::string& s) {
+  auto colon = s.rfind(':');
+  if (colon == std::string::npos || colon + 1 == s.size()) {
+    throw std::runtime_error("metrics exporter: port missing in \"" + s +
+                             "\"");
+  }
+  unsigned long port = std::stoul(s.substr(colon + 1));
+  if (port == 0 || port > 65535) {
+    throw std::runtime_error("metrics exporter: invalid port in \"" + s +
+                             "\"");
+  }
+  return {s.substr(0, colon), static_cast<uint16_t>(port)};
+}
+
+/// Resolve a host and port to an IPv4 socket address.
+sockaddr_in resolve(const std::string& host, uint16_t port, int socktype) {
+  addrinfo hints{};
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = socktype;
+  addrinfo* res = nullptr;
+  int err = getaddrinfo(host.c_str(), nullptr, &hints, &res);
+  if (err != 0 || res == nullptr) {
+    throw std::runtime_error("metrics exporter: cannot resolve \"" + host +
+                             "\": " + gai_strerror(err));
+  }
+  sockaddr_in addr{};
+  std::memcpy(&addr, res->ai_addr, sizeof(addr));
+  addr.sin_port = htons(port);
+  freeaddrinfo(res);
+  return addr;
+}
+
+void send_all(int fd, const std::string& data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    ssize_t n = ::send(fd, data.data() + sent, data.size() - sent,
+                       MSG_NOSIGNAL);
+    if (n <= 0) {
+      return;
+    }
+    sent += static_cast<size_t>(n);
+  }
+}
+
+} // namespace
+
+constexpr std::chrono::milliseconds MetricsExporter::interval;
+
+MetricsExporter::~MetricsExporter() { stop(); }
+
+std::unique_ptr<MetricsExporter>
+MetricsExporter::create(const std::string& uri) {
+  auto separator = uri.find("://");
+  if (separator == std::string::npos) {
+    throw std::runtime_error("metrics exporter: invalid URI \"" + uri + "\"");
+  }
+  std::string scheme = uri.substr(0, separator);
+  std::string rest = uri.substr(separator + 3);
+
+  if (scheme == "http") {
+    // ignore a trailing path, the metrics are always served on /metrics
+    auto slash = rest.find('/');
+    if (slash != std::string::npos) {
+      rest.resize(slash);
+    }
+    auto host_port = split_host_port(rest);
+    return std::unique_ptr<MetricsExporter>(
+        new MetricsExporterHttp(host_port.first, host_port.second));
+  }
+  if (scheme == "udp") {
+    auto host_port = split_host_port(rest);
+    return std::unique_ptr<MetricsExporter>(
+        new MetricsExporterUdp(host_port.first, host_port.second));
+  }
+  if (scheme == "file") {
+    if (rest.empty()) {
+      throw std::runtime_error("metrics exporter: file name missing");
+    }
+    return std::unique_ptr<MetricsExporter>(new MetricsExporterFile(rest));
+  }
+  throw std::runtime_error("metrics exporter: unknown scheme \"" + scheme +
+                           "\"");
+}
+
+void MetricsExporter::start() {
+  stopped_ = false;
+  thread_ = std::thread([this] { run(); });
+}
+
+void MetricsExporter::stop() {
+  stopped_ = true;
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void MetricsExporter::sleep(std::chrono::milliseconds duration) {
+  constexpr auto step = std::chrono::milliseconds(50);
+  auto end = std::chrono::steady_clock::now() + duration;
+  while (!stopped_ && std::chrono::steady_clock::now() < end) {
+    std::this_thread::sleep_for(step);
+  }
+}
+
+//--- MetricsExporterHttp ----------------------------------------------------
+
+MetricsExporterHttp::MetricsExporterHttp(const std::string& address,
+                                         uint16_t port) {
+  sockaddr_in addr = resolve(address, port, SOCK_STREAM);
+
+  socket_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (socket_ < 0) {
+    throw std::runtime_error(std::string("metrics exporter: socket: ") +
+                             std::strerror(errno));
+  }
+  int one = 1;
+  setsockopt(socket_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  if (::bind(socket_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+      ::listen(socket_, 8) < 0) {
+    int err = errno;
+    ::close(socket_);
+    throw std::runtime_error("metrics exporter: cannot listen on " + address +
+                             ":" + std::to_string(port) + ": " +
+                             std::strerror(err));
+  }
+  L_(info) << "serving metrics on http://" << address << ":" << port
+           << "/metrics";
+  start();
+}
+
+MetricsExporterHttp::~MetricsExporterHttp() {
+  stop();
+  ::close(socket_);
+}
+
+void MetricsExporterHttp::run() {
+  while (!stopped()) {
+    pollfd pfd{socket_, POLLIN, 0};
+    int n = ::poll(&pfd, 1, 100);
+    if (n <= 0) {
+      continue;
+    }
+    int connection = ::accept4(socket_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (connection < 0) {
+      continue;
+    }
+    serve(connection);
+    ::close(connection);
+  }
+}
+
+void MetricsExporterHttp::serve(int connection) {
+  // read the request header (with a short timeout)
+  std::string request;
+  char buf[1024];
+  while (request.find("\r\n\r\n") == std::string::npos &&
+         request.size() < 8192) {
+    pollfd pfd{connection, POLLIN, 0};
+    if (::poll(&pfd, 1, 1000) <= 0) {
+      return;
+    }
+    ssize_t n = ::recv(connection, buf, sizeof(buf), 0);
+    if (n <= 0) {
+      return;
+    }
+    request.append(buf, static_cast<size_t>(n));
+  }
+
+  std::string status;
+  std::string body;
+  if (request.compare(0, 13, "GET /metrics ") == 0 ||
+      request.compare(0, 13, "GET /metrics?") == 0) {
+    std::ostringstream out;
+    MetricsRegistry::get().write_prometheus(out);
+    status = "200 OK";
+    body = out.str();
+  } else {
+    status = "404 Not Found";
+    body = "not found\n";
+  }
+
+  std::ostringstream response;
+  response << "HTTP/1.0 " << status << "\r\n"
+           << "Content-Type: text/plain; version=0.0.4\r\n"
+           << "Content-Length: " << body.size() << "\r\n"
+           << "Connection: close\r\n\r\n"
+           << body;
+  send_all(connection, response.str());
+}
+
+//--- MetricsExporterUdp -----------------------------------------------------
+
+MetricsExporterUdp::MetricsExporterUdp(const std::string& host,
+                                       uint16_t port) {
+  sockaddr_in addr = resolve(host, port, SOCK_DGRAM);
+
+  socket_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  if (socket_ < 0) {
+    throw std::runtime_error(std::string("metrics exporter: socket: ") +
+                             std::strerror(errno));
+  }
+  if (::connect(socket_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) <
+      0) {
+    int err = errno;
+    ::close(socket_);
+    throw std::runtime_error("metrics exporter: cannot connect to " + host +
+                             ":" + std::to_string(port) + ": " +
+                             std::strerror(err));
+  }
+  L_(info) << "sending metrics to udp://" << host << ":" << port;
+  start();
+}
+
+MetricsExporterUdp::~MetricsExporterUdp() {
+  stop();
+  ::close(socket_);
+}
+
+void MetricsExporterUdp::run() {
+  // keep datagrams below a typical MTU, split at line boundaries
+  constexpr size_t max_datagram_size = 1400;
+
+  while (!stopped()) {
+    sleep(interval);
+    std::ostringstream out;
+    MetricsRegistry::get().write_influx(out, std::chrono::system_clock::now());
+    std::istringstream lines(out.str());
+    std::string datagram;
+    std::string line;
+    while (std::getline(lines, line)) {
+      if (!datagram.empty() &&
+          datagram.size() + line.size() + 1 > max_datagram_size) {
+        ::send(socket_, datagram.data(), datagram.size(), 0);
+        datagram.clear();
+      }
+      datagram += line;
+      datagram += '\n';
+    }
+    if (!datagram.empty()) {
+      ::send(socket_, datagram.data(), datagram.size(), 0);
+    }
+  }
+}
+
+//--- MetricsExporterFile ----------------------------------------------------
+
+MetricsExporterFile::MetricsExporterFile(std::string path)
+    : path_(std::move(path)) {
+  write();
+  L_(info) << "writing metrics to " << path_;
+  start();
+}
+
+MetricsExporterFile::~MetricsExporterFile() {
+  stop();
+  try {
+    write();
+  } catch (std::exception& e) {
+    L_(error) << "exception in ~MetricsExporterFile: " << e.what();
+  }
+}
+
+void MetricsExporterFile::write() const {
+  // write to a temporary file and rename it, so readers never see a
+  // partially written file
+  std::string tmp_path = path_ + ".tmp";
+  {
+    std::ofstream out(tmp_path);
+    if (!out) {
+      throw std::runtime_error("metrics exporter: cannot write " + tmp_path);
+    }
+    MetricsRegistry::get().write_prometheus(out);
+  }
+  if (std::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+    throw std::runtime_error("metrics exporter: cannot rename " + tmp_path);
+  }
+}
+
+void MetricsExporterFile::run() {
+  while (!stopped()) {
+    sleep(interval);
+    try {
+      write();
+    } catch (std::exception& e) {
+      L_(error) << e.what();
+    }
+  }
+}
@@ -0,0 +1,99 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+/// Metrics exporter base class.
+/** A MetricsExporter periodically publishes the contents of the
+    MetricsRegistry from a background thread. Exporters are created from a
+    URI:
+
+    - "http://<address>:<port>" serves the Prometheus text format on
+      "/metrics" (use address 0.0.0.0 to listen on all interfaces),
+    - "udp://<host>:<port>" sends InfluxDB line protocol datagrams,
+    - "file://<path>" regularly replaces the given file with the Prometheus
+      text format (e.g. for the node exporter textfile collector). */
+
+class MetricsExporter {
+public:
+  /// The MetricsExporter default constructor.
+  MetricsExporter() = default;
+
+  MetricsExporter(const MetricsExporter&) = delete;
+  void operator=(const MetricsExporter&) = delete;
+
+  /// The MetricsExporter destructor, stops the background thread.
+  virtual ~MetricsExporter();
+
+  /// Create an exporter from a given URI.
+  static std::unique_ptr<MetricsExporter> create(const std::string& uri);
+
+protected:
+  /// Start the background thread, calling run() until stopped.
+  void start();
+
+  /// Stop and join the background thread.
+  void stop();
+
+  /// Thread body, must return shortly after stopped() becomes true.
+  virtual void run() = 0;
+
+  bool stopped() const { return stopped_; }
+
+  /// Sleep for a given duration or until stopped.
+  void sleep(std::chrono::milliseconds duration);
+
+  /// The interval between periodic exports.
+  static constexpr std::chrono::milliseconds interval =
+      std::chrono::milliseconds(1000);
+
+private:
+  std::thread thread_;
+  std::atomic<bool> stopped_{false};
+};
+
+/// Exporter serving the Prometheus text format via HTTP.
+class MetricsExporterHttp : public MetricsExporter {
+public:
+  MetricsExporterHttp(const std::string& address, uint16_t port);
+  ~MetricsExporterHttp() override;
+
+private:
+  void run() override;
+
+  /// Answer a single request on a connected socket.
+  void serve(int connection);
+
+  int socket_ = -1;
+};
+
+/// Exporter sending InfluxDB line protocol via UDP.
+class MetricsExporterUdp : public MetricsExporter {
+public:
+  MetricsExporterUdp(const std::string& host, uint16_t port);
+  ~MetricsExporterUdp() override;
+
+private:
+  void run() override;
+
+  int socket_ = -1;
+};
+
+/// Exporter writing the Prometheus text format to a file.
+class MetricsExporterFile : public MetricsExporter {
+public:
+  explicit MetricsExporterFile(std::string path);
+  ~MetricsExporterFile() override;
+
+  /// Write the current metrics to the file.
+  void write() const;
+
+private:
+  void run() override;
+
+  std::string path_;
+};
@@ -136,11 +136,22 @@ std::string MicrosliceAnalyzer::statistics() const {
   return s.str();
 }
 
-void MicrosliceAnalyzer::put(std::shared_ptr<const fles::Microslice> ms) {
-  if (!check_microslice(*ms)) {
+void MicrosliceAnalyzer::analyze(const fles::Microslice& ms) {
+  if (!check_microslice(ms)) {
     pattern_checker_->reset();
   }
   if ((microslice_count_ % output_interval_) == 0) {
     out_ << output_prefix_ << statistics() << std::endl;
   }
 }
+
+void MicrosliceAnalyzer::put(std::shared_ptr<const fles::Microslice> ms) {
+  analyze(*ms);
+}
+
+void MicrosliceAnalyzer::put_batch(
+    const std::vector<std::shared_ptr<const fles::Microslice>>& items) {
+  for (const auto& ms : items) {
+    analyze(*ms);
+  }
+}
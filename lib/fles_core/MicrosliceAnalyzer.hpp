@@ -8,6 +8,7 @@
 #include <memory>
 #include <ostream>
 #include <string>
+#include <vector>
 
 class PatternChecker;
 
@@ -22,7 +23,13 @@ public:
 
   void put(std::shared_ptr<const fles::Microslice> ms) override;
 
+  void put_batch(
+      const std::vector<std::shared_ptr<const fles::Microslice>>& items)
+      override;
+
 private:
+  void analyze(const fles::Microslice& ms);
+
   bool check_microslice(const fles::Microslice& ms);
 
   std::string statistics() const;
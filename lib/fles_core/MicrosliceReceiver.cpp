@@ -1,7 +1,10 @@
 // Copyright 2015 Jan de Cuveland <cmail@cuveland.de>
 
 #include "MicrosliceReceiver.hpp"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <stdexcept>
 #include <thread>
 
 namespace fles {
@@ -11,43 +14,76 @@ MicrosliceReceiver::MicrosliceReceiver(InputBufferReadInterface& data_source)
       write_index_desc_(data_source_.get_write_index().desc),
       read_index_desc_(data_source_.get_read_index().desc) {}
 
-StorableMicroslice* MicrosliceReceiver::try_get() {
-  // update write_index if needed
+void MicrosliceReceiver::skip_released() {
+  // a lossy data source may release data that has not been read yet
+  uint64_t valid_index_desc = data_source_.get_read_index().desc;
+  if (valid_index_desc > read_index_desc_) {
+    skipped_ += valid_index_desc - read_index_desc_;
+    read_index_desc_ = valid_index_desc;
+  }
+}
+
+void MicrosliceReceiver::update_write_index() {
   if (write_index_desc_ <= read_index_desc_) {
     write_index_desc_ = data_source_.get_write_index().desc;
+    skip_released();
   }
-  if (write_index_desc_ > read_index_desc_) {
+}
 
-    const MicrosliceDescriptor& desc =
-        data_source_.desc_buffer().at(read_index_desc_);
+StorableMicroslice*
+MicrosliceReceiver::copy(const MicrosliceDescriptor& desc) {
+  const uint8_t* buffer_begin = data_source_.data_buffer().ptr();
+  const uint64_t buffer_size = data_source_.data_buffer().bytes();
 
-    const uint8_t* data_begin = &data_source_.data_buffer().at(desc.offset);
+  // a descriptor overwritten while being read may carry any size
+  if (desc.size > buffer_size) {
+    return nullptr;
+  }
 
-    const uint64_t offset_end = desc.offset + desc.size;
+  const uint8_t* buffer_end = buffer_begin + buffer_size;
 
-    const uint8_t* data_end = &data_source_.data_buffer().at(offset_end);
+  const uint8_t* data_begin = &data_source_.data_buffer().at(desc.offset);
 
-    StorableMicroslice* sms;
+  // size of the segment up to the end of the buffer
+  const auto head_size = static_cast<uint64_t>(buffer_end - data_begin);
 
-    if (data_begin <= data_end) {
-      sms = new StorableMicroslice(
-          const_cast<const fles::MicrosliceDescriptor&>(desc),
-          const_cast<const uint8_t*>(data_begin));
-    } else {
-      const uint8_t* buffer_begin = data_source_.data_buffer().ptr();
+  if (desc.size <= head_size) {
+    return new StorableMicroslice(desc, data_begin);
+  }
+
+  const uint8_t* data_end = buffer_begin + (desc.size - head_size);
 
-      const uint8_t* buffer_end =
-          buffer_begin + data_source_.data_buffer().bytes();
+  // copy two segments to vector
+  std::vector<uint8_t> data;
+  data.reserve(desc.size);
+  data.assign(data_begin, buffer_end);
+  data.insert(data.end(), buffer_begin, data_end);
+  assert(data.size() == desc.size);
 
-      // copy two segments to vector
-      std::vector<uint8_t> data;
-      data.reserve(desc.size);
-      data.assign(data_begin, buffer_end);
-      data.insert(data.end(), buffer_begin, data_end);
-      assert(data.size() == desc.size);
+  return new StorableMicroslice(desc, data);
+}
 
-      sms = new StorableMicroslice(
-          const_cast<const fles::MicrosliceDescriptor&>(desc), data);
+StorableMicroslice* MicrosliceReceiver::try_get() {
+  update_write_index();
+  if (write_index_desc_ > read_index_desc_) {
+
+    // copy the descriptor, a lossy data source may overwrite it
+    const MicrosliceDescriptor desc =
+        data_source_.desc_buffer().at(read_index_desc_);
+
+    const uint64_t offset_end = desc.offset + desc.size;
+
+    StorableMicroslice* sms = copy(desc);
+
+    // discard the copy if the data has been overwritten in the meantime
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (data_source_.get_read_index().desc > read_index_desc_) {
+      delete sms;
+      skip_released();
+      return nullptr;
+    }
+    if (sms == nullptr) {
+      throw std::runtime_error("invalid microslice descriptor");
     }
 
     ++read_index_desc_;
@@ -59,6 +95,57 @@ StorableMicroslice* MicrosliceReceiver::try_get() {
   return nullptr;
 }
 
+std::size_t MicrosliceReceiver::try_get_batch(
+    std::vector<std::unique_ptr<Microslice>>& items, std::size_t max_items) {
+  update_write_index();
+  if (write_index_desc_ <= read_index_desc_) {
+    return 0;
+  }
+  const uint64_t available = write_index_desc_ - read_index_desc_;
+  uint64_t end_index_desc =
+      read_index_desc_ + std::min<uint64_t>(available, max_items);
+
+  const std::size_t first = items.size();
+  uint64_t offset_end = 0;
+  bool invalid = false;
+  for (uint64_t i = read_index_desc_; i < end_index_desc; ++i) {
+    // copy the descriptor, a lossy data source may overwrite it
+    const MicrosliceDescriptor desc = data_source_.desc_buffer().at(i);
+    std::unique_ptr<StorableMicroslice> sms(copy(desc));
+    if (!sms) {
+      // end the batch before the invalid descriptor
+      end_index_desc = i;
+      invalid = true;
+      break;
+    }
+    offset_end = desc.offset + desc.size;
+    items.push_back(std::move(sms));
+  }
+
+  // discard the copies of data overwritten in the meantime
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint64_t valid_index_desc = data_source_.get_read_index().desc;
+  if (invalid && valid_index_desc <= end_index_desc) {
+    throw std::runtime_error("invalid microslice descriptor");
+  }
+  if (valid_index_desc > read_index_desc_) {
+    uint64_t discarded =
+        std::min(valid_index_desc, end_index_desc) - read_index_desc_;
+    items.erase(items.begin() + static_cast<std::ptrdiff_t>(first),
+                items.begin() + static_cast<std::ptrdiff_t>(first + discarded));
+    skip_released();
+    if (read_index_desc_ >= end_index_desc) {
+      return 0;
+    }
+  }
+
+  read_index_desc_ = end_index_desc;
+
+  data_source_.set_read_index({read_index_desc_, offset_end});
+
+  return items.size() - first;
+}
+
 StorableMicroslice* MicrosliceReceiver::do_get() {
   if (eos_) {
     return nullptr;
@@ -81,4 +168,28 @@ StorableMicroslice* MicrosliceReceiver::do_get() {
 
   return sms;
 }
+
+std::size_t MicrosliceReceiver::do_get_batch(
+    std::vector<std::unique_ptr<Microslice>>& items, std::size_t max_items) {
+  if (eos_ || max_items == 0) {
+    return 0;
+  }
+
+  // wait until a microslice is available in the input buffer
+  std::size_t n = 0;
+  while (n == 0) {
+    data_source_.proceed();
+    n = try_get_batch(items, max_items);
+    if (n == 0) {
+      if (data_source_.get_eof() &&
+          read_index_desc_ == data_source_.get_write_index().desc) {
+        eos_ = true;
+        return 0;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  return n;
+}
 } // namespace fles
@@ -9,6 +9,7 @@
 #include "StorableMicroslice.hpp"
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace fles {
 
@@ -41,17 +42,39 @@ public:
 
   bool eos() const override { return eos_; }
 
+  /// Number of microslices skipped because a lossy data source released them.
+  uint64_t skipped() const { return skipped_; }
+
 private:
   StorableMicroslice* do_get() override;
 
+  std::size_t do_get_batch(std::vector<std::unique_ptr<Microslice>>& items,
+                           std::size_t max_items) override;
+
   StorableMicroslice* try_get();
 
+  /// Copy the available microslices (up to max_items) and release them to
+  /// the data source at once.
+  std::size_t try_get_batch(std::vector<std::unique_ptr<Microslice>>& items,
+                            std::size_t max_items);
+
+  /// Copy a microslice from the buffers of the data source. Returns nullptr
+  /// if the descriptor size exceeds the data buffer.
+  StorableMicroslice* copy(const MicrosliceDescriptor& desc);
+
+  /// Update the write index if all known microslices have been read.
+  void update_write_index();
+
+  void skip_released();
+
   /// Data source (e.g., FLIB).
   InputBufferReadInterface& data_source_;
 
   uint64_t write_index_desc_;
   uint64_t read_index_desc_;
 
+  uint64_t skipped_ = 0;
+
   bool eos_ = false;
 };
 } // namespace fles
@@ -12,10 +12,8 @@ MicrosliceTransmitter::MicrosliceTransmitter(
     InputBufferWriteInterface& data_sink)
     : data_sink_(data_sink) {}
 
-bool MicrosliceTransmitter::try_put(
-    const std::shared_ptr<const Microslice>& item) {
-  assert(item != nullptr);
-  const DualIndex item_size = {1, item->desc().size};
+bool MicrosliceTransmitter::try_write(const Microslice& item) {
+  const DualIndex item_size = {1, item.desc().size};
   const DualIndex buffer_size = {data_sink_.desc_buffer().size(),
                                  data_sink_.data_buffer().size()};
   DualIndex available = buffer_size - write_index_ + read_index_cached_;
@@ -36,30 +34,52 @@ bool MicrosliceTransmitter::try_put(
       &data_sink_.data_buffer().at(write_index_.data + item_size.data);
 
   if (data_begin <= data_end) {
-    std::copy_n(item->content(), item_size.data, data_begin);
+    std::copy_n(item.content(), item_size.data, data_begin);
   } else {
     size_t part1_size =
         buffer_size.data -
         (write_index_.data & data_sink_.data_buffer().size_mask());
 
     // copy data into two segments
-    std::copy_n(item->content(), part1_size, data_begin);
-    std::copy_n(item->content() + part1_size, item_size.data - part1_size,
+    std::copy_n(item.content(), part1_size, data_begin);
+    std::copy_n(item.content() + part1_size, item_size.data - part1_size,
                 data_sink_.data_buffer().ptr());
   }
 
-  data_sink_.desc_buffer().at(write_index_.desc) = item->desc();
+  data_sink_.desc_buffer().at(write_index_.desc) = item.desc();
   data_sink_.desc_buffer().at(write_index_.desc).offset = write_index_.data;
 
   write_index_ += item_size;
-  data_sink_.set_write_index(write_index_);
 
   return true;
 }
 
-void MicrosliceTransmitter::put(std::shared_ptr<const Microslice> item) {
-  while (!try_put(item)) {
+void MicrosliceTransmitter::write(const Microslice& item) {
+  if (try_write(item)) {
+    return;
+  }
+  // let the reader see what has been written so far
+  data_sink_.set_write_index(write_index_);
+  while (!try_write(item)) {
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
   }
 }
+
+void MicrosliceTransmitter::put(std::shared_ptr<const Microslice> item) {
+  assert(item != nullptr);
+  write(*item);
+  data_sink_.set_write_index(write_index_);
+}
+
+void MicrosliceTransmitter::put_batch(
+    const std::vector<std::shared_ptr<const Microslice>>& items) {
+  if (items.empty()) {
+    return;
+  }
+  for (const auto& item : items) {
+    assert(item != nullptr);
+    write(*item);
+  }
+  data_sink_.set_write_index(write_index_);
+}
 } // namespace fles
@@ -6,6 +6,7 @@
 #include "DualRingBuffer.hpp"
 #include "Microslice.hpp"
 #include "Sink.hpp"
+#include <vector>
 
 namespace fles {
 
@@ -32,10 +33,24 @@ public:
    */
   void put(std::shared_ptr<const Microslice> item) override;
 
+  /**
+   * \brief Transmit a batch of items.
+   *
+   * The items are made visible to the data sink at once, or whenever the
+   * function has to wait for space.
+   */
+  void put_batch(
+      const std::vector<std::shared_ptr<const Microslice>>& items) override;
+
   void end_stream() override { data_sink_.set_eof(true); }
 
 private:
-  bool try_put(const std::shared_ptr<const Microslice>& item);
+  /// Copy an item to the buffers of the data sink without making it
+  /// visible. Returns false if there is not enough space available.
+  bool try_write(const Microslice& item);
+
+  /// Copy an item to the buffers of the data sink, waiting for space.
+  void write(const Microslice& item);
 
   /// Data sink (e.g., shared memory buffer).
   InputBufferWriteInterface& data_sink_;
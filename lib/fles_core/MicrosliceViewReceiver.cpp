@@ -0,0 +1,179 @@
+// Copyright 2026 agent <agent@local>
+
+#include "MicrosliceViewReceiver.hpp"
+#include "MicrosliceView.hpp"
+#include "StorableMicroslice.hpp"
+#include <cassert>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fles {
+
+/// The microslices handed out and not yet released to the data source.
+struct MicrosliceViewReceiver::Releases {
+  struct Entry {
+    uint64_t data_end;
+    bool done;
+  };
+
+  std::mutex mutex;
+  /// Descriptor index of the first entry.
+  uint64_t begin;
+  std::deque<Entry> entries;
+};
+
+/// A microslice view marking its buffer space as released on destruction.
+class MicrosliceViewReceiver::View : public MicrosliceView {
+public:
+  View(MicrosliceDescriptor& d,
+       uint8_t* content,
+       std::shared_ptr<Releases> releases,
+       uint64_t index)
+      : MicrosliceView(d, content), releases_(std::move(releases)),
+        index_(index) {}
+
+  View(const View&) = delete;
+  void operator=(const View&) = delete;
+
+  ~View() override {
+    std::lock_guard<std::mutex> lock(releases_->mutex);
+    releases_->entries[index_ - releases_->begin].done = true;
+  }
+
+private:
+  std::shared_ptr<Releases> releases_;
+  uint64_t index_;
+};
+
+MicrosliceViewReceiver::MicrosliceViewReceiver(
+    InputBufferReadInterface& data_source)
+    : data_source_(data_source), releases_(std::make_shared<Releases>()),
+      write_index_desc_(data_source_.get_write_index().desc),
+      read_index_desc_(data_source_.get_read_index().desc) {
+  releases_->begin = read_index_desc_;
+}
+
+MicrosliceViewReceiver::~MicrosliceViewReceiver() { release(); }
+
+uint64_t MicrosliceViewReceiver::outstanding() const {
+  std::lock_guard<std::mutex> lock(releases_->mutex);
+  uint64_t n = 0;
+  for (const auto& entry : releases_->entries) {
+    if (!entry.done) {
+      ++n;
+    }
+  }
+  return n;
+}
+
+void MicrosliceViewReceiver::release() {
+  DualIndex read_index{0, 0};
+  {
+    std::lock_guard<std::mutex> lock(releases_->mutex);
+    auto& entries = releases_->entries;
+    if (entries.empty() || !entries.front().done) {
+      return;
+    }
+    while (!entries.empty() && entries.front().done) {
+      read_index.data = entries.front().data_end;
+      entries.pop_front();
+      ++releases_->begin;
+    }
+    read_index.desc = releases_->begin;
+  }
+  data_source_.set_read_index(read_index);
+}
+
+Microslice* MicrosliceViewReceiver::try_get() {
+  // update write_index if needed
+  if (write_index_desc_ <= read_index_desc_) {
+    write_index_desc_ = data_source_.get_write_index().desc;
+  }
+  if (write_index_desc_ <= read_index_desc_) {
+    return nullptr;
+  }
+
+  MicrosliceDescriptor& desc = data_source_.desc_buffer().at(read_index_desc_);
+  RingBufferView<uint8_t>& data_buffer = data_source_.data_buffer();
+  uint8_t* data_begin = &data_buffer.at(desc.offset);
+
+  Microslice* ms;
+  bool done;
+  if ((desc.offset & data_buffer.size_mask()) + desc.size <=
+      data_buffer.bytes()) {
+    ms = new View(desc, data_begin, releases_, read_index_desc_);
+    done = false;
+  } else {
+    // content wraps around, copy two segments to vector
+    uint8_t* buffer_begin = data_buffer.ptr();
+    uint8_t* buffer_end = buffer_begin + data_buffer.bytes();
+    uint8_t* data_end = &data_buffer.at(desc.offset + desc.size);
+
+    std::vector<uint8_t> data;
+    data.reserve(desc.size);
+    data.assign(data_begin, buffer_end);
+    data.insert(data.end(), buffer_begin, data_end);
+    assert(data.size() == desc.size);
+
+    ms = new StorableMicroslice(
+        const_cast<const fles::MicrosliceDescriptor&>(desc), data);
+    done = true;
+    ++copied_;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(releases_->mutex);
+    releases_->entries.push_back({desc.offset + desc.size, done});
+  }
+  ++read_index_desc_;
+
+  return ms;
+}
+
+Microslice* MicrosliceViewReceiver::do_get() {
+  if (eos_) {
+    return nullptr;
+  }
+
+  // wait until a microslice is available in the input buffer
+  Microslice* ms = nullptr;
+  while (ms == nullptr) {
+    release();
+    data_source_.proceed();
+    ms = try_get();
+    if (ms == nullptr) {
+      if (data_source_.get_eof() &&
+          read_index_desc_ == data_source_.get_write_index().desc) {
+        eos_ = true;
+        return nullptr;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  return ms;
+}
+
+std::size_t MicrosliceViewReceiver::do_get_batch(
+    std::vector<std::unique_ptr<Microslice>>& items, std::size_t max_items) {
+  if (max_items == 0) {
+    return 0;
+  }
+  Microslice* ms = do_get();
+  if (ms == nullptr) {
+    return 0;
+  }
+  items.emplace_back(ms);
+
+  // add the microslices available without waiting
+  std::size_t n = 1;
+  while (n < max_items && (ms = try_get()) != nullptr) {
+    items.emplace_back(ms);
+    ++n;
+  }
+  return n;
+}
+} // namespace fles
@@ -0,0 +1,77 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::MicrosliceViewReceiver class.
+#pragma once
+
+#include "DualRingBuffer.hpp"
+#include "MicrosliceSource.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace fles {
+
+/**
+ * \brief The MicrosliceViewReceiver class implements a zero-copy mechanism to
+ * receive Microslices from an InputBufferReadInterface object.
+ *
+ * In contrast to MicrosliceReceiver, the microslices are not copied, but
+ * handed out as views into the buffers of the data source. The buffer space
+ * of a microslice is released to the data source when its view is destroyed
+ * (and all preceding microslices have been released as well), so the views
+ * must not outlive the data source. Only a microslice whose content wraps
+ * around the end of the data buffer is copied.
+ *
+ * As the data is not copied, this receiver must not be used with a lossy
+ * data source, which may overwrite the data while a view still exists.
+ */
+class MicrosliceViewReceiver : public MicrosliceSource {
+public:
+  /// Construct Microslice receiver connected to a given data source.
+  explicit MicrosliceViewReceiver(InputBufferReadInterface& data_source);
+
+  /// Delete copy constructor (non-copyable).
+  MicrosliceViewReceiver(const MicrosliceViewReceiver&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const MicrosliceViewReceiver&) = delete;
+
+  ~MicrosliceViewReceiver() override;
+
+  bool eos() const override { return eos_; }
+
+  /// Number of microslices copied because their content wraps around.
+  uint64_t copied() const { return copied_; }
+
+  /// Number of microslices handed out, but not yet released.
+  uint64_t outstanding() const;
+
+private:
+  class View;
+  struct Releases;
+
+  Microslice* do_get() override;
+
+  std::size_t do_get_batch(std::vector<std::unique_ptr<Microslice>>& items,
+                           std::size_t max_items) override;
+
+  Microslice* try_get();
+
+  /// Release the buffer space of all consecutive released microslices to
+  /// the data source.
+  void release();
+
+  /// Data source (e.g., FLIB).
+  InputBufferReadInterface& data_source_;
+
+  /// Release state, shared with the views handed out.
+  std::shared_ptr<Releases> releases_;
+
+  uint64_t write_index_desc_;
+  uint64_t read_index_desc_;
+
+  uint64_t copied_ = 0;
+
+  bool eos_ = false;
+};
+
+} // namespace fles
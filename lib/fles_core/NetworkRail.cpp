@@ -0,0 +1,126 @@
+// Copyright 2026 agent <agent@local>
+
+#include "NetworkRail.hpp"
+#include "log.hpp"
+#include <arpa/inet.h>
+#include <cstring>
+#include <fstream>
+#include <ifaddrs.h>
+#include <netdb.h>
+#include <stdexcept>
+#ifdef HAVE_NUMA
+#include <numaif.h>
+#endif
+
+NetworkRail::NetworkRail(const std::string& spec) {
+  auto at = spec.rfind('@');
+  address_ = spec.substr(0, at);
+  if (address_.empty()) {
+    throw std::runtime_error("invalid rail specification: " + spec);
+  }
+  if (at != std::string::npos) {
+    try {
+      numa_node_ = std::stoi(spec.substr(at + 1));
+    } catch (std::exception&) {
+      throw std::runtime_error("invalid rail specification: " + spec);
+    }
+  } else {
+    numa_node_ = numa_node_of_address(address_);
+  }
+}
+
+std::vector<NetworkRail>
+NetworkRail::select(const std::vector<NetworkRail>& rails, int numa_node) {
+  std::vector<NetworkRail> local;
+  if (numa_node >= 0) {
+    for (const auto& rail : rails) {
+      if (rail.numa_node() == numa_node) {
+        local.push_back(rail);
+      }
+    }
+  }
+  if (local.empty()) {
+    return rails;
+  }
+  return local;
+}
+
+int NetworkRail::numa_node_of_memory(const void* ptr) {
+#ifdef HAVE_NUMA
+  int node = -1;
+  if (get_mempolicy(&node, nullptr, 0, const_cast<void*>(ptr),
+                    MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+    L_(debug) << "get_mempolicy failed: " << strerror(errno);
+    return -1;
+  }
+  return node;
+#else
+  (void)ptr;
+  return -1;
+#endif
+}
+
+int NetworkRail::numa_node_of_address(const std::string& address) {
+  struct addrinfo hints;
+  memset(&hints, 0, sizeof(struct addrinfo));
+  hints.ai_family = AF_UNSPEC;
+  struct addrinfo* res;
+  if (getaddrinfo(address.c_str(), nullptr, &hints, &res) != 0) {
+    L_(warning) << "cannot resolve rail address " << address;
+    return -1;
+  }
+
+  struct ifaddrs* ifaddr;
+  if (getifaddrs(&ifaddr) != 0) {
+    freeaddrinfo(res);
+    return -1;
+  }
+
+  // find the interface the address is assigned to
+  std::string interface;
+  for (struct ifaddrs* ifa = ifaddr; ifa != nullptr && interface.empty();
+       ifa = ifa->ifa_next) {
+    if (ifa->ifa_addr == nullptr) {
+      continue;
+    }
+    for (struct addrinfo* t = res; t != nullptr; t = t->ai_next) {
+      if (ifa->ifa_addr->sa_family != t->ai_family) {
+        continue;
+      }
+      bool match = false;
+      if (t->ai_family == AF_INET) {
+        match = reinterpret_cast<struct sockaddr_in*>(ifa->ifa_addr)
+                    ->sin_addr.s_addr ==
+                reinterpret_cast<struct sockaddr_in*>(t->ai_addr)
+                    ->sin_addr.s_addr;
+      } else if (t->ai_family == AF_INET6) {
+        match = memcmp(&reinterpret_cast<struct sockaddr_in6*>(ifa->ifa_addr)
+                            ->sin6_addr,
+                       &reinterpret_cast<struct sockaddr_in6*>(t->ai_addr)
+                            ->sin6_addr,
+                       sizeof(struct in6_addr)) == 0;
+      }
+      if (match) {
+        interface = ifa->ifa_name;
+        break;
+      }
+    }
+  }
+  freeifaddrs(ifaddr);
+  freeaddrinfo(res);
+
+  if (interface.empty()) {
+    L_(warning) << "rail address " << address
+                << " is not assigned to a local interface";
+    return -1;
+  }
+
+  int node = -1;
+  std::ifstream ifs("/sys/class/net/" + interface + "/device/numa_node");
+  if (!(ifs >> node)) {
+    node = -1;
+  }
+  L_(debug) << "rail " << address << ": interface " << interface
+            << ", NUMA node " << node;
+  return node;
+}
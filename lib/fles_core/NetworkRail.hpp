@@ -0,0 +1,48 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Local network rail class.
+/** A NetworkRail is a local network interface (and thereby a network
+    device) used for timeslice transfers, identified by a local address.
+    An input channel with several rails distributes its compute node
+    connections over the rails attached to the NUMA node of its input
+    buffer. */
+
+class NetworkRail {
+public:
+  /// Construct from a specification of the form "<address>[@<numa node>]".
+  /** If the NUMA node is not given, it is determined from the network
+      interface the address is assigned to. */
+  explicit NetworkRail(const std::string& spec);
+
+  /// Construct from local address and NUMA node.
+  NetworkRail(std::string address, int numa_node)
+      : address_(std::move(address)), numa_node_(numa_node) {}
+
+  /// Retrieve the local address of the rail.
+  const std::string& address() const { return address_; }
+
+  /// Retrieve the NUMA node of the rail (-1 if unknown).
+  int numa_node() const { return numa_node_; }
+
+  /// Select the rails to use for a buffer on a given NUMA node.
+  /** Returns the rails attached to the given node, or all rails if there
+      is no such rail or the node is unknown (-1). */
+  static std::vector<NetworkRail> select(const std::vector<NetworkRail>& rails,
+                                         int numa_node);
+
+  /// Determine the NUMA node of the memory at a given address.
+  static int numa_node_of_memory(const void* ptr);
+
+  /// Determine the NUMA node of the network interface with a given local
+  /// address.
+  static int numa_node_of_address(const std::string& address);
+
+private:
+  std::string address_;
+  int numa_node_ = -1;
+};
@@ -0,0 +1,264 @@
+// Copyright 2026 agent <agent@local>
+
+#include "OfflineTimesliceBuilder.hpp"
+#include "StorableTimeslice.hpp"
+#include "WorkerPoolSink.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+/// The microslices of a timeslice, passed to the assembly threads.
+struct TimesliceParts {
+  uint64_t index = 0;
+  std::vector<std::vector<std::shared_ptr<const fles::Microslice>>>
+      components;
+  /// The assembled timeslice, set by the assembly thread.
+  mutable std::shared_ptr<const fles::Timeslice> timeslice;
+};
+
+/// Sink assembling a timeslice from its microslices.
+class AssemblySink : public fles::Sink<TimesliceParts> {
+public:
+  explicit AssemblySink(uint64_t timeslice_size)
+      : timeslice_size_(timeslice_size) {}
+
+  void put(std::shared_ptr<const TimesliceParts> parts) override {
+    auto timeslice = std::make_shared<fles::StorableTimeslice>(
+        timeslice_size_, parts->index, parts->index);
+    for (const auto& microslices : parts->components) {
+      uint32_t c = timeslice->append_component(microslices.size());
+      for (uint64_t m = 0; m < microslices.size(); ++m) {
+        timeslice->append_microslice(c, m, microslices[m]->desc(),
+                                     microslices[m]->content());
+      }
+    }
+    parts->timeslice = std::move(timeslice);
+  }
+
+private:
+  uint64_t timeslice_size_;
+};
+
+/// Sink passing the assembled timeslices to the output.
+class OutputSink : public fles::Sink<TimesliceParts> {
+public:
+  explicit OutputSink(fles::TimesliceSink& output) : output_(output) {}
+
+  void put(std::shared_ptr<const TimesliceParts> parts) override {
+    output_.put(std::move(parts->timeslice));
+  }
+
+  void end_stream() override { output_.end_stream(); }
+
+private:
+  fles::TimesliceSink& output_;
+};
+
+} // namespace
+
+OfflineTimesliceBuilder::OfflineTimesliceBuilder(
+    std::vector<std::unique_ptr<fles::MicrosliceSource>> sources,
+    fles::TimesliceSink& output,
+    uint64_t timeslice_size,
+    uint64_t overlap_size,
+    uint64_t microslice_length,
+    uint32_t num_workers)
+    : output_(output), timeslice_size_(timeslice_size),
+      overlap_size_(overlap_size), microslice_length_(microslice_length),
+      num_workers_(std::max<uint32_t>(num_workers, 1)) {
+  if (sources.empty()) {
+    throw std::runtime_error("no microslice input");
+  }
+  if (timeslice_size_ == 0) {
+    throw std::runtime_error("timeslice size must be at least 1");
+  }
+  for (auto& source : sources) {
+    inputs_.emplace_back();
+    inputs_.back().index = inputs_.size() - 1;
+    inputs_.back().source = std::move(source);
+  }
+}
+
+OfflineTimesliceBuilder::~OfflineTimesliceBuilder() = default;
+
+void OfflineTimesliceBuilder::initialize() {
+  // the first microslice of each input
+  std::vector<std::shared_ptr<const fles::Microslice>> first;
+  for (auto& input : inputs_) {
+    std::shared_ptr<const fles::Microslice> ms = input.source->get();
+    input.eos = !ms;
+    first.push_back(std::move(ms));
+  }
+
+  bool have_start = false;
+  for (const auto& ms : first) {
+    if (ms) {
+      start_index_ = have_start ? std::max(start_index_, ms->desc().idx)
+                                : ms->desc().idx;
+      have_start = true;
+    }
+  }
+
+  std::shared_ptr<const fles::Microslice> second;
+  if (microslice_length_ == 0) {
+    if (first[0]) {
+      second = inputs_[0].source->get();
+      inputs_[0].eos = !second;
+    }
+    if (second && second->desc().idx > first[0]->desc().idx) {
+      microslice_length_ = second->desc().idx - first[0]->desc().idx;
+    } else {
+      L_(warning) << "cannot determine microslice length, using 1";
+      microslice_length_ = 1;
+    }
+    L_(info) << "microslice length: " << microslice_length_;
+  }
+
+  for (size_t i = 0; i < inputs_.size(); ++i) {
+    if (first[i]) {
+      accept(inputs_[i], std::move(first[i]));
+    }
+  }
+  if (second) {
+    accept(inputs_[0], std::move(second));
+  }
+}
+
+void OfflineTimesliceBuilder::accept(
+    Input& input, std::shared_ptr<const fles::Microslice> microslice) {
+  uint64_t idx = microslice->desc().idx;
+  if (idx < start_index_) {
+    ++skipped_;
+    return;
+  }
+  if ((idx - start_index_) % microslice_length_ != 0) {
+    if (input.misaligned++ == 0) {
+      L_(warning) << "input " << input.index << ": misaligned microslice "
+                  << idx << " skipped (reported once)";
+    }
+    ++misaligned_;
+    return;
+  }
+  uint64_t pos = position(*microslice);
+  if (pos < input.next_position) {
+    if (input.misaligned++ == 0) {
+      L_(warning) << "input " << input.index << ": out-of-order microslice "
+                  << idx << " skipped (reported once)";
+    }
+    ++misaligned_;
+    return;
+  }
+  input.next_position = pos + 1;
+  input.buffer.push_back(std::move(microslice));
+}
+
+bool OfflineTimesliceBuilder::read(Input& input) {
+  std::shared_ptr<const fles::Microslice> microslice = input.source->get();
+  if (!microslice) {
+    input.eos = true;
+    return false;
+  }
+  accept(input, std::move(microslice));
+  return true;
+}
+
+bool OfflineTimesliceBuilder::fill(Input& input, uint64_t pos) {
+  while (input.buffer.empty() || position(*input.buffer.back()) < pos) {
+    if (input.eos || !read(input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t
+OfflineTimesliceBuilder::position(const fles::Microslice& microslice) const {
+  return (microslice.desc().idx - start_index_) / microslice_length_;
+}
+
+void OfflineTimesliceBuilder::run(uint64_t max_timeslices) {
+  initialize();
+
+  fles::WorkerPoolSink<TimesliceParts> pool(
+      num_workers_,
+      [this](uint32_t) {
+        return std::unique_ptr<fles::Sink<TimesliceParts>>(
+            new AssemblySink(timeslice_size_));
+      },
+      4 * num_workers_);
+  pool.set_ordered_sink(
+      std::unique_ptr<fles::Sink<TimesliceParts>>(new OutputSink(output_)));
+
+  const uint64_t num_microslices = timeslice_size_ + overlap_size_;
+  for (uint64_t ts = 0; ts < max_timeslices; ++ts) {
+    uint64_t begin = ts * timeslice_size_;
+    uint64_t end = begin + num_microslices;
+
+    // all inputs have to reach the end of the timeslice
+    bool reached = true;
+    for (auto& input : inputs_) {
+      if (!fill(input, end - 1)) {
+        L_(info) << "input " << input.index << " ends in timeslice " << ts;
+        reached = false;
+        break;
+      }
+    }
+    if (!reached) {
+      break;
+    }
+
+    auto parts = std::make_shared<TimesliceParts>();
+    parts->index = ts;
+    parts->components.resize(inputs_.size());
+    bool complete = true;
+    for (auto& input : inputs_) {
+      auto& component = parts->components[input.index];
+      for (const auto& ms : input.buffer) {
+        if (position(*ms) >= end) {
+          break;
+        }
+        component.push_back(ms);
+      }
+      if (component.size() < num_microslices) {
+        uint64_t n = num_microslices - component.size();
+        L_(warning) << "timeslice " << ts << ", input " << input.index << ": "
+                    << n << " of " << num_microslices
+                    << " microslices missing";
+        missing_ += n;
+        complete = false;
+      }
+      // release the microslices not needed by the next timeslice
+      while (!input.buffer.empty() &&
+             position(*input.buffer.front()) < begin + timeslice_size_) {
+        input.buffer.pop_front();
+      }
+    }
+    if (!complete) {
+      ++incomplete_timeslices_;
+    }
+
+    pool.put(std::move(parts));
+    ++timeslices_;
+  }
+
+  pool.end_stream();
+}
+
+void OfflineTimesliceBuilder::log_statistics() const {
+  L_(info) << "built " << timeslices_ << " timeslices from "
+           << inputs_.size() << " inputs";
+  if (incomplete_timeslices_ != 0) {
+    L_(warning) << incomplete_timeslices_ << " incomplete timeslices, "
+                << missing_ << " microslices missing";
+  }
+  if (misaligned_ != 0) {
+    L_(warning) << misaligned_ << " misaligned or duplicate microslices "
+                << "skipped";
+  }
+  if (skipped_ != 0) {
+    L_(info) << skipped_ << " microslices before the common start skipped";
+  }
+}
@@ -0,0 +1,123 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "Microslice.hpp"
+#include "MicrosliceSource.hpp"
+#include "Sink.hpp"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+/// Offline timeslice builder class.
+/** An OfflineTimesliceBuilder reads several microslice streams (e.g., one
+    microslice archive per input link) and builds timeslices from them
+    like flesnet does: timeslice n consists of one component per stream,
+    each holding the core microslices n * timeslice_size ... (n + 1) *
+    timeslice_size - 1 followed by overlap_size overlap microslices.
+
+    The streams are aligned by the microslice index (start time) in the
+    descriptors. The position of a microslice is its index relative to
+    the first index common to all streams, divided by the microslice
+    length. Microslices before the common start, at a position that is
+    not a multiple of the length, or at an already passed position are
+    skipped; missing microslices leave a component short. Both are
+    reported, but do not stop the build. Building ends with the last
+    timeslice that all streams reach.
+
+    The microslices are read sequentially, while the timeslices are
+    assembled by a pool of worker threads and passed to the output sink
+    in order. */
+
+class OfflineTimesliceBuilder {
+public:
+  /// The OfflineTimesliceBuilder constructor.
+  /** \param sources           microslice streams, one per component
+      \param output            sink receiving the timeslices in order
+      \param timeslice_size    number of core microslices per timeslice
+      \param overlap_size      number of overlap microslices per timeslice
+      \param microslice_length difference of the indices of consecutive
+                               microslices (0: detect from the first
+                               stream)
+      \param num_workers       number of assembly threads */
+  OfflineTimesliceBuilder(
+      std::vector<std::unique_ptr<fles::MicrosliceSource>> sources,
+      fles::TimesliceSink& output,
+      uint64_t timeslice_size,
+      uint64_t overlap_size,
+      uint64_t microslice_length = 0,
+      uint32_t num_workers = 1);
+
+  OfflineTimesliceBuilder(const OfflineTimesliceBuilder&) = delete;
+  void operator=(const OfflineTimesliceBuilder&) = delete;
+
+  ~OfflineTimesliceBuilder();
+
+  /// Build up to max_timeslices timeslices and end the output stream.
+  void run(uint64_t max_timeslices = UINT64_MAX);
+
+  /// Log a summary of the build and the problems found.
+  void log_statistics() const;
+
+  uint64_t timeslices() const { return timeslices_; }
+
+  /// Number of missing microslices in all built timeslices.
+  uint64_t missing() const { return missing_; }
+
+  /// Number of skipped misaligned or duplicate microslices.
+  uint64_t misaligned() const { return misaligned_; }
+
+  /// Number of skipped microslices before the common start.
+  uint64_t skipped() const { return skipped_; }
+
+  /// Difference of the indices of consecutive microslices.
+  uint64_t microslice_length() const { return microslice_length_; }
+
+private:
+  /// A microslice stream with the microslices read ahead.
+  struct Input {
+    size_t index = 0;
+    std::unique_ptr<fles::MicrosliceSource> source;
+    std::deque<std::shared_ptr<const fles::Microslice>> buffer;
+    /// Position of the last accepted microslice plus one.
+    uint64_t next_position = 0;
+    /// Number of skipped misaligned or duplicate microslices.
+    uint64_t misaligned = 0;
+    bool eos = false;
+  };
+
+  /// Determine the common start index and the microslice length.
+  void initialize();
+
+  /// Append a microslice to the buffer of an input, unless it has to be
+  /// skipped.
+  void accept(Input& input,
+              std::shared_ptr<const fles::Microslice> microslice);
+
+  /// Read the next microslice of an input. Returns false at the end of the
+  /// input.
+  bool read(Input& input);
+
+  /// Read an input up to the given position. Returns false if the input
+  /// ends before.
+  bool fill(Input& input, uint64_t pos);
+
+  uint64_t position(const fles::Microslice& microslice) const;
+
+  std::vector<Input> inputs_;
+  fles::TimesliceSink& output_;
+
+  uint64_t timeslice_size_;
+  uint64_t overlap_size_;
+  uint64_t microslice_length_;
+  uint32_t num_workers_;
+
+  /// Microslice index corresponding to position 0.
+  uint64_t start_index_ = 0;
+
+  uint64_t timeslices_ = 0;
+  uint64_t missing_ = 0;
+  uint64_t misaligned_ = 0;
+  uint64_t skipped_ = 0;
+  uint64_t incomplete_timeslices_ = 0;
+};
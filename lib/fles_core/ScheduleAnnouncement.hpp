@@ -0,0 +1,20 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#pragma pack(1)
+
+/// Structure representing the scheduling weights of a compute node for a
+/// window of schedule epochs, sent from compute node to input channel.
+struct ScheduleAnnouncement {
+  static constexpr size_t window = 16;
+
+  /// Number of epochs announced so far.
+  uint64_t epochs;
+  /// Weights for the latest epochs, weight[i] applies to epoch epochs-1-i.
+  uint8_t weight[window];
+};
+
+#pragma pack()
@@ -0,0 +1,107 @@
+// Copyright 2026 agent <agent@local>
+
+#include "Scheduler.hpp"
+#include <algorithm>
+
+Scheduler::~Scheduler() {
+  for (auto& level : wheel_) {
+    for (auto& head : level) {
+      while (head != nullptr) {
+        head->unlink();
+      }
+    }
+  }
+}
+
+void Scheduler::add(Timer& timer, clock::duration delay) {
+  timer.unlink();
+  timer.period_ = clock::duration::zero();
+  // the owner may have been idle since its last call to timer()
+  now_ = clock::now();
+  timer.expiry_ = to_ticks(now_ + delay);
+  insert(timer);
+}
+
+void Scheduler::add_periodic(Timer& timer, clock::duration period) {
+  add(timer, period);
+  timer.period_ = period;
+}
+
+void Scheduler::insert(Timer& timer) {
+  // expired timers are run on the next tick
+  if (timer.expiry_ < current_tick_) {
+    timer.expiry_ = current_tick_;
+  }
+  uint64_t delta = timer.expiry_ - current_tick_;
+
+  size_t level = 0;
+  while (level < num_levels - 1 &&
+         delta >= (UINT64_C(1) << (level_bits * (level + 1)))) {
+    ++level;
+  }
+  uint64_t slot_tick = timer.expiry_;
+  if (delta >= (UINT64_C(1) << (level_bits * num_levels))) {
+    // beyond the range of the wheel, park in the farthest slot of the
+    // topmost level and requeue from there when it is cascaded
+    slot_tick = current_tick_ + (UINT64_C(1) << (level_bits * num_levels)) - 1;
+  }
+  size_t slot = (slot_tick >> (level_bits * level)) & (level_size - 1);
+  push(wheel_[level][slot], timer);
+}
+
+void Scheduler::cascade(size_t level) {
+  size_t slot = (current_tick_ >> (level_bits * level)) & (level_size - 1);
+  Timer* head = wheel_[level][slot];
+  wheel_[level][slot] = nullptr;
+  if (head != nullptr) {
+    head->pprev_ = &head;
+  }
+  while (head != nullptr) {
+    Timer& timer = *head;
+    timer.unlink();
+    insert(timer);
+  }
+}
+
+void Scheduler::advance() {
+  uint64_t now_tick = to_ticks(now_);
+  while (current_tick_ <= now_tick) {
+    // move timers of the higher levels down when a lower level wraps,
+    // starting with the highest level
+    size_t levels = 1;
+    while (levels < num_levels &&
+           (current_tick_ & ((UINT64_C(1) << (level_bits * levels)) - 1)) ==
+               0) {
+      ++levels;
+    }
+    for (size_t level = levels - 1; level > 0; --level) {
+      cascade(level);
+    }
+
+    // detach the current slot, timers rearmed by callbacks go to later ticks
+    Timer* head = wheel_[0][current_tick_ & (level_size - 1)];
+    wheel_[0][current_tick_ & (level_size - 1)] = nullptr;
+    if (head != nullptr) {
+      head->pprev_ = &head;
+    }
+    ++current_tick_;
+
+    while (head != nullptr) {
+      Timer& timer = *head;
+      timer.unlink();
+      if (timer.period_ != clock::duration::zero()) {
+        // rearm from the current time, skipping the periods missed while
+        // the owner did not call timer()
+        uint64_t period =
+            std::max<uint64_t>(static_cast<uint64_t>(timer.period_ / tick), 1);
+        timer.expiry_ += period;
+        if (timer.expiry_ <= now_tick) {
+          uint64_t missed = (now_tick - timer.expiry_) / period + 1;
+          timer.expiry_ += missed * period;
+        }
+        insert(timer);
+      }
+      timer.callback_();
+    }
+  }
+}
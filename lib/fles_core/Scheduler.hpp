@@ -1,59 +1,127 @@
-// Copyright 2012-2013 Jan de Cuveland <cmail@cuveland.de>
+// Copyright 2012-2013, 2016 Jan de Cuveland <cmail@cuveland.de>
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <functional>
-#include <queue>
-#include <sys/time.h> // for `time_t` and `struct timeval`
+#include <utility>
+
+/// Timer scheduler class.
+/** A Scheduler runs timer callbacks from the main loop of its owner
+    (call timer() once per iteration). Timers are kept in a hierarchical
+    timer wheel with a resolution of one tick, so adding, cancelling and
+    expiring a timer is O(1) and does not allocate. Timers are intrusive
+    objects owned by the caller and can be rearmed any number of times.
+
+    The scheduler is based on the monotonic steady_clock. timer() reads
+    the clock once and caches the value, which can be retrieved by now()
+    instead of reading the clock again. A periodic timer missing several
+    periods (e.g., because timer() was not called for a while) expires
+    only once and then continues in its original phase. */
 
 class Scheduler {
 public:
-  struct event {
-    using callback_type = std::function<void()>;
-    using time_type = std::chrono::time_point<std::chrono::system_clock>;
+  using clock = std::chrono::steady_clock;
 
-    event(const callback_type& cb, const time_type& when)
-        : callback_(cb), when_(when) {}
+  /// Resolution of the timer wheel.
+  static constexpr clock::duration tick = std::chrono::milliseconds(1);
 
-    void operator()() const { callback_(); }
+  /// Intrusive timer, embedded in the object owning the callback.
+  class Timer {
+  public:
+    explicit Timer(std::function<void()> callback)
+        : callback_(std::move(callback)) {}
 
-    callback_type callback_;
-    time_type when_;
-  };
+    Timer(const Timer&) = delete;
+    void operator=(const Timer&) = delete;
+
+    ~Timer() { unlink(); }
+
+    /// Check if the timer is currently scheduled.
+    bool active() const { return pprev_ != nullptr; }
+
+  private:
+    friend class Scheduler;
 
-  struct event_less : public std::less<event> {
-    bool operator()(const event& e1, const event& e2) const {
-      return (e2.when_ < e1.when_);
+    void unlink() {
+      if (pprev_ != nullptr) {
+        *pprev_ = next_;
+        if (next_ != nullptr) {
+          next_->pprev_ = pprev_;
+        }
+        next_ = nullptr;
+        pprev_ = nullptr;
+      }
     }
+
+    std::function<void()> callback_;
+    clock::duration period_ = clock::duration::zero();
+    uint64_t expiry_ = 0; ///< Expiry time in ticks
+    Timer* next_ = nullptr;
+    Timer** pprev_ = nullptr;
   };
 
-  void add(const event::callback_type& cb, const time_t& when) {
-    auto real_when = std::chrono::system_clock::from_time_t(when);
+  Scheduler() : now_(clock::now()), current_tick_(to_ticks(now_)) {}
 
-    event_queue_.emplace(cb, real_when);
-  }
+  Scheduler(const Scheduler&) = delete;
+  void operator=(const Scheduler&) = delete;
+
+  ~Scheduler();
+
+  /// Schedule a one-shot timer to expire after a given delay. A timer that
+  /// is already scheduled is rescheduled.
+  void add(Timer& timer, clock::duration delay);
+
+  /// Schedule a periodic timer, expiring first after one period. Periods
+  /// are rounded down to whole ticks, but expire at most once per tick.
+  void add_periodic(Timer& timer, clock::duration period);
 
-  void add(const event::callback_type& cb, const timeval& when) {
-    auto real_when = std::chrono::system_clock::from_time_t(when.tv_sec) +
-                     std::chrono::microseconds(when.tv_usec);
+  /// Cancel a scheduled timer.
+  void cancel(Timer& timer) { timer.unlink(); }
 
-    event_queue_.emplace(cb, real_when);
+  /// Run the callbacks of all expired timers.
+  void timer() {
+    now_ = clock::now();
+    if (to_ticks(now_) >= current_tick_) {
+      advance();
+    }
   }
 
-  void add(const event::callback_type& cb,
-           const std::chrono::time_point<std::chrono::system_clock>& when) {
-    event_queue_.emplace(cb, when);
+  /// Retrieve the time of the last call to timer() or add().
+  clock::time_point now() const { return now_; }
+
+private:
+  static constexpr unsigned level_bits = 8;
+  static constexpr size_t level_size = size_t(1) << level_bits;
+  static constexpr size_t num_levels = 4;
+
+  static uint64_t to_ticks(clock::time_point t) {
+    return static_cast<uint64_t>(t.time_since_epoch() / tick);
   }
 
-  void timer() {
-    event::time_type now = std::chrono::system_clock::now();
+  /// Process all ticks up to the current time.
+  void advance();
 
-    while (!event_queue_.empty() && (event_queue_.top().when_ <= now)) {
-      event_queue_.top()();
-      event_queue_.pop();
+  /// Link a timer into the wheel according to its expiry time.
+  void insert(Timer& timer);
+
+  /// Reinsert all timers of a slot in a higher level.
+  void cascade(size_t level);
+
+  static void push(Timer*& head, Timer& timer) {
+    timer.next_ = head;
+    if (head != nullptr) {
+      head->pprev_ = &timer.next_;
     }
+    head = &timer;
+    timer.pprev_ = &head;
   }
 
-private:
-  std::priority_queue<event, std::vector<event>, event_less> event_queue_;
+  clock::time_point now_;
+
+  /// The next tick to be processed.
+  uint64_t current_tick_;
+
+  std::array<std::array<Timer*, level_size>, num_levels> wheel_{};
 };
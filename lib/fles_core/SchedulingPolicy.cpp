@@ -0,0 +1,170 @@
+// Copyright 2026 agent <agent@local>
+
+#include "SchedulingPolicy.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+std::unique_ptr<SchedulingPolicy>
+SchedulingPolicy::create(const std::string& spec, uint32_t num_compute_nodes) {
+  if (num_compute_nodes == 0) {
+    throw std::runtime_error("scheduling policy without compute nodes");
+  }
+
+  std::string name = spec;
+  std::string args;
+  auto pos = spec.find(':');
+  if (pos != std::string::npos) {
+    name = spec.substr(0, pos);
+    args = spec.substr(pos + 1);
+  }
+
+  if (name == "round-robin") {
+    return std::unique_ptr<SchedulingPolicy>(
+        new RoundRobinPolicy(num_compute_nodes));
+  }
+  if (name == "weighted") {
+    std::vector<uint32_t> weights;
+    std::istringstream ss(args);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+      weights.push_back(static_cast<uint32_t>(std::stoul(item)));
+    }
+    if (weights.size() != num_compute_nodes) {
+      throw std::runtime_error("weighted scheduling requires " +
+                               std::to_string(num_compute_nodes) +
+                               " weights");
+    }
+    return std::unique_ptr<SchedulingPolicy>(new WeightedPolicy(weights));
+  }
+  if (name == "occupancy") {
+    return std::unique_ptr<SchedulingPolicy>(
+        new OccupancyPolicy(num_compute_nodes));
+  }
+  throw std::runtime_error("unknown scheduling policy: " + name);
+}
+
+std::unique_ptr<ScheduleAnnouncer>
+SchedulingPolicy::create_announcer(const std::string& spec,
+                                   uint32_t num_compute_nodes) {
+  if (spec != "occupancy") {
+    return nullptr;
+  }
+  return std::unique_ptr<ScheduleAnnouncer>(
+      new ScheduleAnnouncer(num_compute_nodes));
+}
+
+WeightedPolicy::WeightedPolicy(const std::vector<uint32_t>& weights)
+    : weights_(weights), table_(table(weights)) {
+  if (table_.empty()) {
+    throw std::runtime_error("weighted scheduling requires a nonzero weight");
+  }
+}
+
+std::string WeightedPolicy::description() const {
+  std::ostringstream s;
+  s << "weighted:";
+  for (size_t i = 0; i < weights_.size(); ++i) {
+    s << (i != 0 ? "," : "") << weights_[i];
+  }
+  return s.str();
+}
+
+std::vector<uint32_t>
+WeightedPolicy::table(const std::vector<uint32_t>& weights) {
+  const int64_t total =
+      std::accumulate(weights.begin(), weights.end(), INT64_C(0));
+  std::vector<int64_t> current(weights.size(), 0);
+  std::vector<uint32_t> table;
+  table.reserve(static_cast<size_t>(total));
+
+  for (int64_t n = 0; n < total; ++n) {
+    size_t best = 0;
+    for (size_t i = 0; i < weights.size(); ++i) {
+      current[i] += weights[i];
+      if (current[i] > current[best]) {
+        best = i;
+      }
+    }
+    current[best] -= total;
+    table.push_back(static_cast<uint32_t>(best));
+  }
+  return table;
+}
+
+OccupancyPolicy::OccupancyPolicy(uint32_t num_compute_nodes)
+    : num_compute_nodes_(num_compute_nodes),
+      epoch_length_(epoch_length(num_compute_nodes)),
+      weights_(num_compute_nodes), announced_(num_compute_nodes, lookahead) {}
+
+int OccupancyPolicy::target(uint64_t timeslice) {
+  const uint64_t epoch = timeslice / epoch_length_;
+
+  if (epoch != epoch_) {
+    // the first epochs are scheduled with equal weights
+    std::vector<uint32_t> weights(num_compute_nodes_, 1);
+    if (epoch >= lookahead) {
+      for (uint32_t cn = 0; cn < num_compute_nodes_; ++cn) {
+        auto it = weights_[cn].find(epoch);
+        if (it == weights_[cn].end()) {
+          return -1;
+        }
+        weights[cn] = it->second;
+      }
+    }
+    table_ = WeightedPolicy::table(weights);
+    epoch_ = epoch;
+
+    for (auto& w : weights_) {
+      w.erase(w.begin(), w.lower_bound(epoch));
+    }
+  }
+
+  return static_cast<int>(table_[(timeslice % epoch_length_) % table_.size()]);
+}
+
+void OccupancyPolicy::on_announcement(uint32_t compute_index,
+                                      const ScheduleAnnouncement& a) {
+  uint64_t& announced = announced_.at(compute_index);
+  if (a.epochs <= announced) {
+    return;
+  }
+  if (a.epochs - announced > ScheduleAnnouncement::window) {
+    throw std::runtime_error("schedule announcement of compute node " +
+                             std::to_string(compute_index) + " lost");
+  }
+  for (uint64_t epoch = announced; epoch < a.epochs; ++epoch) {
+    weights_[compute_index][epoch] = a.weight[a.epochs - 1 - epoch];
+  }
+  announced = a.epochs;
+}
+
+ScheduleAnnouncer::ScheduleAnnouncer(uint32_t num_compute_nodes)
+    : epoch_length_(OccupancyPolicy::epoch_length(num_compute_nodes)) {
+  announcement_.epochs = OccupancyPolicy::lookahead;
+  std::fill(std::begin(announcement_.weight), std::end(announcement_.weight),
+            1);
+}
+
+void ScheduleAnnouncer::update(uint64_t timeslice, double fill_level) {
+  const uint64_t horizon =
+      timeslice / epoch_length_ + OccupancyPolicy::lookahead + 1;
+  const uint8_t w = weight(fill_level);
+
+  while (announcement_.epochs < horizon) {
+    std::memmove(&announcement_.weight[1], &announcement_.weight[0],
+                 ScheduleAnnouncement::window - 1);
+    announcement_.weight[0] = w;
+    ++announcement_.epochs;
+  }
+}
+
+uint8_t ScheduleAnnouncer::weight(double fill_level) {
+  fill_level = std::min(std::max(fill_level, 0.0), 1.0);
+  return static_cast<uint8_t>(
+      1 + std::lround((1.0 - fill_level) *
+                      (OccupancyPolicy::max_weight - 1)));
+}
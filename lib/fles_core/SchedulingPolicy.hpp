@@ -0,0 +1,145 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "ScheduleAnnouncement.hpp"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ScheduleAnnouncer;
+
+/// Abstract timeslice scheduling policy class.
+/** A SchedulingPolicy assigns timeslices to compute nodes. All input
+    channels have to arrive at the same assignment independently, so the
+    result must be a deterministic function of the timeslice index and of
+    information shared by all inputs. */
+
+class SchedulingPolicy {
+public:
+  virtual ~SchedulingPolicy() = default;
+
+  /// Return the compute node index for a given timeslice, or -1 if the
+  /// assignment is not known yet.
+  virtual int target(uint64_t timeslice) = 0;
+
+  /// Handle a schedule announcement received from a compute node.
+  virtual void on_announcement(uint32_t /* compute_index */,
+                               const ScheduleAnnouncement& /* a */) {}
+
+  /// Return a short description of the policy.
+  virtual std::string description() const = 0;
+
+  /// Create a policy from a specification: "round-robin",
+  /// "weighted:<w0>,<w1>,..." or "occupancy".
+  static std::unique_ptr<SchedulingPolicy>
+  create(const std::string& spec, uint32_t num_compute_nodes);
+
+  /// Create the compute node side of a policy, nullptr if not required.
+  static std::unique_ptr<ScheduleAnnouncer>
+  create_announcer(const std::string& spec, uint32_t num_compute_nodes);
+};
+
+/// Fixed round-robin assignment (timeslice modulo number of nodes).
+class RoundRobinPolicy : public SchedulingPolicy {
+public:
+  explicit RoundRobinPolicy(uint32_t num_compute_nodes)
+      : num_compute_nodes_(num_compute_nodes) {}
+
+  int target(uint64_t timeslice) override {
+    return static_cast<int>(timeslice % num_compute_nodes_);
+  }
+
+  std::string description() const override { return "round-robin"; }
+
+private:
+  uint32_t num_compute_nodes_;
+};
+
+/// Fixed weighted assignment for heterogeneous compute nodes.
+/** Each compute node receives a share of the timeslices proportional to its
+    weight. The assignment repeats with a period of the sum of the weights
+    and is interleaved as evenly as possible (smooth weighted
+    round-robin). */
+class WeightedPolicy : public SchedulingPolicy {
+public:
+  explicit WeightedPolicy(const std::vector<uint32_t>& weights);
+
+  int target(uint64_t timeslice) override {
+    return static_cast<int>(table_[timeslice % table_.size()]);
+  }
+
+  std::string description() const override;
+
+  /// Create the interleaved assignment table for a set of weights.
+  static std::vector<uint32_t> table(const std::vector<uint32_t>& weights);
+
+private:
+  std::vector<uint32_t> weights_;
+  std::vector<uint32_t> table_;
+};
+
+/// Buffer occupancy-aware assignment.
+/** The timeslices are grouped into epochs. Each compute node announces its
+    weight for an epoch in advance based on the fill level of its timeslice
+    buffer (see ScheduleAnnouncer), the announcements are piggybacked on the
+    regular status messages. The weights of an epoch are never changed once
+    announced, so all inputs derive the same weighted assignment. An input
+    waits for the announcements of all compute nodes before scheduling a
+    timeslice of a new epoch. */
+class OccupancyPolicy : public SchedulingPolicy {
+public:
+  /// Maximum weight of a compute node with an empty buffer.
+  static constexpr uint32_t max_weight = 8;
+
+  /// Number of epochs a weight is announced in advance.
+  static constexpr uint64_t lookahead = 2;
+
+  /// Number of timeslices per epoch (each node receives at least one).
+  static uint64_t epoch_length(uint32_t num_compute_nodes) {
+    return static_cast<uint64_t>(num_compute_nodes) * max_weight;
+  }
+
+  explicit OccupancyPolicy(uint32_t num_compute_nodes);
+
+  int target(uint64_t timeslice) override;
+
+  void on_announcement(uint32_t compute_index,
+                       const ScheduleAnnouncement& a) override;
+
+  std::string description() const override { return "occupancy"; }
+
+private:
+  uint32_t num_compute_nodes_;
+  uint64_t epoch_length_;
+
+  /// Announced weights per compute node, indexed by epoch.
+  std::vector<std::map<uint64_t, uint8_t>> weights_;
+
+  /// Number of epochs known per compute node.
+  std::vector<uint64_t> announced_;
+
+  uint64_t epoch_ = UINT64_MAX;
+  std::vector<uint32_t> table_;
+};
+
+/// Compute node side of the occupancy-aware assignment.
+/** A ScheduleAnnouncer derives the weights of future epochs from the buffer
+    fill level and keeps the window of the latest announcements. */
+class ScheduleAnnouncer {
+public:
+  explicit ScheduleAnnouncer(uint32_t num_compute_nodes);
+
+  /// Announce epochs up to the lookahead beyond a completely received
+  /// timeslice, using the current buffer fill level (0..1).
+  void update(uint64_t timeslice, double fill_level);
+
+  const ScheduleAnnouncement& announcement() const { return announcement_; }
+
+  static uint8_t weight(double fill_level);
+
+private:
+  uint64_t epoch_length_;
+  ScheduleAnnouncement announcement_;
+};
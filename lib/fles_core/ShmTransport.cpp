@@ -0,0 +1,22 @@
+// Copyright 2026 agent <agent@local>
+
+#include "ShmTransport.hpp"
+#include <algorithm>
+
+ShmTransport::ShmTransport(uint32_t num_inputs,
+                           uint32_t num_builders,
+                           uint32_t timeslice_size)
+    : inputs_(num_inputs), timeslice_size_(timeslice_size) {
+  for (uint32_t i = 0; i < num_builders; ++i) {
+    builders_.emplace_back(new Builder(i));
+  }
+}
+
+uint64_t ShmTransport::acked_timeslices() const {
+  uint64_t acked = UINT64_MAX;
+  for (const auto& builder : builders_) {
+    acked = std::min(acked, builder->next_timeslice.load(
+                                std::memory_order_acquire));
+  }
+  return acked;
+}
@@ -0,0 +1,89 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "DualRingBuffer.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// Shared state of the intra-node transport.
+/** If all inputs and compute nodes run in a single process, timeslice
+    components are copied by the timeslice builders directly from the input
+    buffers into the timeslice buffer. Input channels (ComponentSenderShm)
+    and timeslice builders (TimesliceBuilderShm) exchange their buffer
+    positions through the atomic variables in this object:
+
+    - each input channel publishes the descriptor write index of its input
+      buffer,
+    - each timeslice builder publishes the index of the next timeslice it
+      has not yet copied, from which the input channels derive their read
+      indexes.
+
+    Timeslices are assigned to the builders round-robin. */
+
+class ShmTransport {
+public:
+  /// Position of an input channel, written by ComponentSenderShm.
+  struct Input {
+    Input(InputBufferReadInterface& source, uint32_t overlap)
+        : data_source(source), start_index(source.get_read_index()),
+          overlap_size(overlap) {}
+
+    /// The input buffer (read-only access from the timeslice builders).
+    InputBufferReadInterface& data_source;
+
+    /// Read indexes at start of operation.
+    const DualIndex start_index;
+
+    /// Constant overlap size (in microslices) of a timeslice component.
+    const uint32_t overlap_size;
+
+    /// Descriptor write index available to the timeslice builders.
+    alignas(64) std::atomic<uint64_t> write_index_desc{0};
+  };
+
+  /// Position of a timeslice builder, written by TimesliceBuilderShm.
+  struct Builder {
+    explicit Builder(uint64_t first_timeslice)
+        : next_timeslice(first_timeslice) {}
+
+    /// Index of the next timeslice not yet copied from the input buffers.
+    alignas(64) std::atomic<uint64_t> next_timeslice;
+  };
+
+  /// The ShmTransport constructor.
+  ShmTransport(uint32_t num_inputs,
+               uint32_t num_builders,
+               uint32_t timeslice_size);
+
+  ShmTransport(const ShmTransport&) = delete;
+  void operator=(const ShmTransport&) = delete;
+
+  /// Attach the input buffer of an input channel. All inputs have to be
+  /// attached before any of the transport threads is started.
+  void set_input(size_t index,
+                 InputBufferReadInterface& data_source,
+                 uint32_t overlap_size) {
+    inputs_.at(index).reset(new Input(data_source, overlap_size));
+  }
+
+  Input& input(size_t index) { return *inputs_.at(index); }
+  Builder& builder(size_t index) { return *builders_.at(index); }
+
+  size_t num_inputs() const { return inputs_.size(); }
+  size_t num_builders() const { return builders_.size(); }
+
+  uint32_t timeslice_size() const { return timeslice_size_; }
+
+  /// Retrieve the index of the oldest timeslice not yet copied by all
+  /// timeslice builders.
+  uint64_t acked_timeslices() const;
+
+private:
+  std::vector<std::unique_ptr<Input>> inputs_;
+  std::vector<std::unique_ptr<Builder>> builders_;
+
+  /// Constant size (in microslices) of a timeslice component.
+  const uint32_t timeslice_size_;
+};
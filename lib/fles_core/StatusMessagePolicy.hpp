@@ -0,0 +1,76 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+/// Adaptive buffer position status protocol.
+/** Input channels announce their compute node write pointers in ping-pong
+    status messages, each of which is answered by the compute node with its
+    acknowledged pointers. Instead of sending a message whenever it is its
+    turn, the input channel asks a StatusMessagePolicy whether an update is
+    due. An update is due if
+
+    - the descriptor write pointer has advanced by at least desc_threshold
+      since the last status message,
+    - the free space in the compute node buffer (as seen by the input) has
+      fallen below low_space_fraction, so that a fresh acknowledgement is
+      needed to avoid blocking, or
+    - there is unannounced or unacknowledged data and the last status
+      message is older than max_delay.
+
+    All positions are absolute, the buffer sizes are given in the same
+    units (descriptors or bytes). */
+
+struct StatusMessagePolicy {
+  /// Minimum advance of the descriptor write pointer that triggers a status
+  /// message immediately.
+  uint64_t desc_threshold = 4;
+
+  /// Fraction of free compute node buffer space below which a status
+  /// message is sent on every turn.
+  double low_space_fraction = 0.25;
+
+  /// Maximum age of the last status message while data is pending.
+  std::chrono::steady_clock::duration max_delay =
+      std::chrono::microseconds(500);
+
+  /// Buffer positions of a single direction (descriptor or data).
+  struct Positions {
+    uint64_t written; ///< Current write pointer
+    uint64_t sent;    ///< Write pointer announced in the last status message
+    uint64_t acked;   ///< Latest acknowledged pointer
+    uint64_t size;    ///< Buffer size
+
+    bool low_space(double fraction) const {
+      return static_cast<double>(acked + size - written) <
+             fraction * static_cast<double>(size);
+    }
+  };
+
+  bool due(const Positions& desc,
+           const Positions& data,
+           std::chrono::steady_clock::duration since_last) const {
+    if (desc.written - desc.sent >= desc_threshold) {
+      return true;
+    }
+    if (desc.low_space(low_space_fraction) ||
+        data.low_space(low_space_fraction)) {
+      return true;
+    }
+    bool pending = desc.written != desc.sent || desc.written != desc.acked;
+    return pending && since_last >= max_delay;
+  }
+};
+
+/// Status message counters of a connection or connection group.
+struct StatusMessageStatistics {
+  uint64_t sent = 0;     ///< Status messages sent
+  uint64_t received = 0; ///< Status messages received
+
+  StatusMessageStatistics& operator+=(const StatusMessageStatistics& other) {
+    sent += other.sent;
+    received += other.received;
+    return *this;
+  }
+};
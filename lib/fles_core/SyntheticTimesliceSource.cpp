@@ -0,0 +1,51 @@
+// Copyright 2026 agent <agent@local>
+
+#include "SyntheticTimesliceSource.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include "StorableTimeslice.hpp"
+
+SyntheticTimesliceSource::SyntheticTimesliceSource(
+    const SyntheticTimesliceParameters& par)
+    : par_(par), content_(par.microslice_size) {
+  for (size_t i = 0; i < content_.size(); ++i) {
+    content_[i] = static_cast<uint8_t>(i);
+  }
+}
+
+uint64_t SyntheticTimesliceSource::timeslice_size() const {
+  uint64_t microslices = par_.core_microslices + par_.overlap_microslices;
+  return par_.num_components * microslices *
+         (sizeof(fles::MicrosliceDescriptor) + par_.microslice_size);
+}
+
+fles::Timeslice* SyntheticTimesliceSource::do_get() {
+  if (eos()) {
+    return nullptr;
+  }
+
+  uint64_t index = next_index_++;
+  uint64_t num_microslices = par_.core_microslices + par_.overlap_microslices;
+  auto* timeslice =
+      new fles::StorableTimeslice(par_.core_microslices, index, index);
+
+  for (uint32_t c = 0; c < par_.num_components; ++c) {
+    uint32_t component = timeslice->append_component(num_microslices);
+    for (uint64_t m = 0; m < num_microslices; ++m) {
+      uint64_t ms_index = index * par_.core_microslices + m;
+      fles::MicrosliceDescriptor desc = fles::MicrosliceDescriptor();
+      desc.hdr_id =
+          static_cast<uint8_t>(fles::HeaderFormatIdentifier::Standard);
+      desc.hdr_ver = static_cast<uint8_t>(fles::HeaderFormatVersion::Standard);
+      desc.eq_id = static_cast<uint16_t>(c);
+      desc.sys_id = static_cast<uint8_t>(fles::SubsystemIdentifier::FLES);
+      desc.sys_ver =
+          static_cast<uint8_t>(fles::SubsystemFormatFLES::Uninitialized);
+      desc.idx = ms_index;
+      desc.size = par_.microslice_size;
+      desc.offset = ms_index * par_.microslice_size;
+      timeslice->append_microslice(component, m, desc, content_.data());
+    }
+  }
+
+  return timeslice;
+}
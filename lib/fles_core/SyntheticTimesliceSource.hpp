@@ -0,0 +1,47 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "TimesliceSource.hpp"
+#include <cstdint>
+#include <vector>
+
+/// Parameters of a synthetic timeslice stream.
+struct SyntheticTimesliceParameters {
+  /// Number of components (input links) per timeslice.
+  uint32_t num_components = 4;
+  /// Content size of each microslice in bytes.
+  uint32_t microslice_size = 65536;
+  /// Number of core microslices per timeslice component.
+  uint32_t core_microslices = 100;
+  /// Number of overlap microslices per timeslice component.
+  uint32_t overlap_microslices = 1;
+  /// Number of timeslices to generate.
+  uint64_t num_timeslices = 1000;
+};
+
+/// Synthetic timeslice source class.
+/** A SyntheticTimesliceSource generates a stream of timeslices in memory
+    without any external input. The microslices carry valid descriptors
+    and a ramp pattern content that is generated once, so that generation
+    costs little more than the memory copies of a real receiver. */
+
+class SyntheticTimesliceSource : public fles::TimesliceSource {
+public:
+  explicit SyntheticTimesliceSource(const SyntheticTimesliceParameters& par);
+
+  bool eos() const override { return next_index_ >= par_.num_timeslices; }
+
+  /// Retrieve the size in bytes of each generated timeslice (descriptors
+  /// and content of all components).
+  uint64_t timeslice_size() const;
+
+private:
+  fles::Timeslice* do_get() override;
+
+  SyntheticTimesliceParameters par_;
+
+  /// Content of every microslice.
+  std::vector<uint8_t> content_;
+
+  uint64_t next_index_ = 0;
+};
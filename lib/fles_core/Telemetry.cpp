@@ -0,0 +1,156 @@
+// Copyright 2026 agent <agent@local>
+
+#include "Telemetry.hpp"
+#include "log.hpp"
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <signal.h>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace {
+const char telemetry_magic[8] = "FLESMON";
+const char* const segment_prefix = "flesmon.";
+
+void copy_name(char* dest, const std::string& src, size_t size) {
+  size_t length = std::min(src.size(), size - 1);
+  std::memcpy(dest, src.data(), length);
+  dest[length] = '\0';
+}
+
+std::string process_name() {
+  std::ifstream comm("/proc/self/comm");
+  std::string name;
+  std::getline(comm, name);
+  return name;
+}
+} // namespace
+
+Telemetry::Telemetry() : name_(segment_name(getpid())) {
+  namespace ip = boost::interprocess;
+  try {
+    ip::shared_memory_object::remove(name_.c_str());
+    shm_.reset(new ip::shared_memory_object(ip::create_only, name_.c_str(),
+                                            ip::read_write));
+    shm_->truncate(static_cast<ip::offset_t>(
+        sizeof(TelemetryHeader) + max_channels * sizeof(TelemetryChannel)));
+    region_.reset(new ip::mapped_region(*shm_, ip::read_write));
+  } catch (ip::interprocess_exception& e) {
+    L_(warning) << "telemetry segment " << name_
+                << " not available: " << e.what();
+    shm_.reset();
+    return;
+  }
+
+  auto* base = static_cast<uint8_t*>(region_->get_address());
+  channels_ = reinterpret_cast<TelemetryChannel*>(base +
+                                                  sizeof(TelemetryHeader));
+  for (uint32_t i = 0; i < max_channels; ++i) {
+    new (&channels_[i]) TelemetryChannel();
+    channels_[i].name[0] = '\0';
+  }
+
+  header_ = new (base) TelemetryHeader();
+  header_->version = version;
+  header_->max_channels = max_channels;
+  header_->pid = getpid();
+  header_->start_time =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count();
+  copy_name(header_->process, process_name(), sizeof(header_->process));
+  header_->num_channels.store(0, std::memory_order_relaxed);
+  // the magic marks the segment as complete
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(header_->magic, telemetry_magic, sizeof(header_->magic));
+}
+
+Telemetry::~Telemetry() {
+  if (shm_) {
+    boost::interprocess::shared_memory_object::remove(name_.c_str());
+  }
+}
+
+TelemetryChannel& Telemetry::add_channel(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (header_ != nullptr) {
+    uint32_t index = header_->num_channels.load(std::memory_order_relaxed);
+    if (index < max_channels) {
+      TelemetryChannel& channel = channels_[index];
+      copy_name(channel.name, name, sizeof(channel.name));
+      channel.touch();
+      // publish the channel only after its name is complete
+      header_->num_channels.store(index + 1, std::memory_order_release);
+      return channel;
+    }
+    L_(warning) << "telemetry segment " << name_
+                << " full, not publishing channel " << name;
+  }
+  dummy_channels_.emplace_back(new TelemetryChannel());
+  copy_name(dummy_channels_.back()->name, name,
+            sizeof(dummy_channels_.back()->name));
+  return *dummy_channels_.back();
+}
+
+std::string Telemetry::segment_name(int64_t pid) {
+  return segment_prefix + std::to_string(pid);
+}
+
+std::vector<std::string> Telemetry::segment_names() {
+  std::vector<std::string> names;
+  boost::system::error_code ec;
+  for (boost::filesystem::directory_iterator it("/dev/shm", ec), end;
+       !ec && it != end; it.increment(ec)) {
+    std::string name = it->path().filename().string();
+    if (name.compare(0, std::strlen(segment_prefix), segment_prefix) == 0) {
+      names.push_back(name);
+    }
+  }
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+TelemetryView::TelemetryView(const std::string& segment_name) {
+  namespace ip = boost::interprocess;
+  shm_.reset(new ip::shared_memory_object(ip::open_only, segment_name.c_str(),
+                                          ip::read_only));
+  region_.reset(new ip::mapped_region(*shm_, ip::read_only));
+  if (region_->get_size() < sizeof(TelemetryHeader)) {
+    throw std::runtime_error("telemetry segment " + segment_name +
+                             " too small");
+  }
+  auto* base = static_cast<const uint8_t*>(region_->get_address());
+  header_ = reinterpret_cast<const TelemetryHeader*>(base);
+  if (std::memcmp(header_->magic, telemetry_magic, sizeof(telemetry_magic)) !=
+      0) {
+    throw std::runtime_error("telemetry segment " + segment_name +
+                             " not initialized");
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (header_->version != Telemetry::version) {
+    throw std::runtime_error("telemetry segment " + segment_name +
+                             " has incompatible version " +
+                             std::to_string(header_->version));
+  }
+  if (region_->get_size() < sizeof(TelemetryHeader) +
+                                header_->max_channels *
+                                    sizeof(TelemetryChannel)) {
+    throw std::runtime_error("telemetry segment " + segment_name +
+                             " truncated");
+  }
+  channels_ =
+      reinterpret_cast<const TelemetryChannel*>(base + sizeof(TelemetryHeader));
+}
+
+uint32_t TelemetryView::num_channels() const {
+  return std::min(header_->num_channels.load(std::memory_order_acquire),
+                  header_->max_channels);
+}
+
+bool TelemetryView::alive() const {
+  return kill(static_cast<pid_t>(header_->pid), 0) == 0 || errno == EPERM;
+}
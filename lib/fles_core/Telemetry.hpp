@@ -0,0 +1,150 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                  std::atomic<double>::is_always_lock_free,
+              "telemetry requires address-free atomics");
+
+/// Occupancy of a ring buffer, as published in the telemetry segment.
+struct TelemetryBuffer {
+  std::atomic<uint64_t> read{0};  ///< Read index (first item in use)
+  std::atomic<uint64_t> write{0}; ///< Write index (first unused item)
+  std::atomic<uint64_t> size{0};  ///< Buffer size in items (0: unknown)
+  std::atomic<double> fill{0.0};  ///< Fraction of the buffer in use (0..1)
+
+  /// Publish the indices, the fill level is derived from them.
+  void set(uint64_t read_index, uint64_t write_index, uint64_t buffer_size) {
+    read.store(read_index, std::memory_order_relaxed);
+    write.store(write_index, std::memory_order_relaxed);
+    size.store(buffer_size, std::memory_order_relaxed);
+    if (buffer_size != 0) {
+      fill.store(static_cast<double>(write_index - read_index) /
+                     static_cast<double>(buffer_size),
+                 std::memory_order_relaxed);
+    }
+  }
+};
+
+/// Telemetry of a single channel (buffer or transport component).
+/** All fields are written by the owning process only, using relaxed
+    atomic stores. Readers may see a mix of old and new values, which is
+    acceptable for monitoring. */
+struct TelemetryChannel {
+  static constexpr size_t max_name_length = 32;
+
+  char name[max_name_length]; ///< Channel name (zero-terminated)
+  TelemetryBuffer data;       ///< Data buffer occupancy
+  TelemetryBuffer desc;       ///< Descriptor buffer occupancy
+  std::atomic<uint64_t> items{0};       ///< Items (e.g. timeslices) handled
+  std::atomic<uint64_t> bytes{0};       ///< Bytes handled
+  std::atomic<uint64_t> stalls{0};      ///< Items delayed by a full buffer
+  std::atomic<uint64_t> outstanding{0}; ///< Items in flight
+  std::atomic<int64_t> updated{0}; ///< Last update (system clock, ns)
+
+  void add(uint64_t item_bytes, uint64_t num_items = 1) {
+    items.fetch_add(num_items, std::memory_order_relaxed);
+    bytes.fetch_add(item_bytes, std::memory_order_relaxed);
+  }
+
+  void touch() {
+    updated.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::system_clock::now().time_since_epoch())
+                      .count(),
+                  std::memory_order_relaxed);
+  }
+};
+
+/// Header of the telemetry segment, followed by the channel array.
+struct TelemetryHeader {
+  static constexpr size_t max_name_length = 32;
+
+  char magic[8];         ///< "FLESMON" (zero-terminated)
+  uint32_t version;      ///< Layout version (see Telemetry::version)
+  uint32_t max_channels; ///< Size of the channel array
+  int64_t pid;           ///< Process id of the owner
+  int64_t start_time;    ///< Creation time (system clock, ns)
+  char process[max_name_length];      ///< Process name (zero-terminated)
+  std::atomic<uint32_t> num_channels; ///< Number of channels in use
+};
+
+/// Shared memory telemetry class.
+/** Every process owns a small shared memory segment ("flesmon.<pid>"),
+    in which its buffers and transport components publish their occupancy,
+    progress and stall counters. The segment is created on first use,
+    channels are only ever added, and the segment is removed when the
+    process exits. Monitoring tools (see flesmon) attach to it read-only
+    through a TelemetryView, so they have no effect on the owner.
+
+    The layout is versioned; readers must reject segments with a different
+    version. */
+
+class Telemetry {
+public:
+  static constexpr uint32_t version = 1;
+  static constexpr uint32_t max_channels = 64;
+
+  static Telemetry& get() {
+    static Telemetry instance;
+    return instance;
+  }
+
+  Telemetry(const Telemetry&) = delete;
+  void operator=(const Telemetry&) = delete;
+
+  ~Telemetry();
+
+  /// Add a channel to the segment. If the segment is full or could not be
+  /// created, a process-local dummy channel is returned.
+  TelemetryChannel& add_channel(const std::string& name);
+
+  /// Name of the telemetry segment of a given process.
+  static std::string segment_name(int64_t pid);
+
+  /// Names of all telemetry segments on this node.
+  static std::vector<std::string> segment_names();
+
+private:
+  Telemetry();
+
+  std::mutex mutex_;
+  std::string name_;
+  std::unique_ptr<boost::interprocess::shared_memory_object> shm_;
+  std::unique_ptr<boost::interprocess::mapped_region> region_;
+  TelemetryHeader* header_ = nullptr;
+  TelemetryChannel* channels_ = nullptr;
+  std::vector<std::unique_ptr<TelemetryChannel>> dummy_channels_;
+};
+
+/// Read-only view of the telemetry segment of another process.
+class TelemetryView {
+public:
+  /// Attach to a given segment, throws if it is missing or incompatible.
+  explicit TelemetryView(const std::string& segment_name);
+
+  const TelemetryHeader& header() const { return *header_; }
+
+  uint32_t num_channels() const;
+
+  const TelemetryChannel& channel(uint32_t index) const {
+    return channels_[index];
+  }
+
+  /// Check if the owning process is still running.
+  bool alive() const;
+
+private:
+  std::unique_ptr<boost::interprocess::shared_memory_object> shm_;
+  std::unique_ptr<boost::interprocess::mapped_region> region_;
+  const TelemetryHeader* header_ = nullptr;
+  const TelemetryChannel* channels_ = nullptr;
+};
@@ -49,4 +49,55 @@ void ThreadContainer::set_cpu(int n) {
 #endif
 }
 
+void ThreadContainer::set_placement(const Placement& placement) {
+  if (placement.cpu >= 0) {
+    set_cpu(placement.cpu);
+  }
+#ifdef HAVE_NUMA
+  if (placement.cpu < 0 && placement.node >= 0 && numa_available() != -1) {
+    if (numa_run_on_node(placement.node) != 0) {
+      L_(error) << "set_placement: could not run on node " << placement.node;
+    }
+  }
+#endif
+  set_preferred_node(placement.effective_node());
+}
+
 #pragma GCC diagnostic pop
+
+void ThreadContainer::set_preferred_node(int node) {
+#ifdef HAVE_NUMA
+  if (numa_available() == -1) {
+    return;
+  }
+  if (node >= 0) {
+    numa_set_preferred(node);
+  } else {
+    numa_set_localalloc();
+  }
+#else
+  (void)node;
+#endif
+}
+
+int ThreadContainer::node_of_cpu(int cpu) {
+#ifdef HAVE_NUMA
+  if (numa_available() == -1) {
+    return -1;
+  }
+  return numa_node_of_cpu(cpu);
+#else
+  (void)cpu;
+  return -1;
+#endif
+}
+
+std::string ThreadContainer::Placement::to_string() const {
+  if (empty()) {
+    return "not pinned";
+  }
+  std::string s = cpu >= 0 ? "CPU " + std::to_string(cpu) : "any CPU";
+  int n = effective_node();
+  s += n >= 0 ? ", NUMA node " + std::to_string(n) : ", NUMA node unknown";
+  return s;
+}
@@ -1,8 +1,41 @@
 // Copyright 2013 Jan de Cuveland <cmail@cuveland.de>
 #pragma once
 
+#include <string>
+
 class ThreadContainer {
+public:
+  /// Placement of a worker thread on a CPU and NUMA node.
+  /** If only the CPU is given, the NUMA node of the CPU is used for memory
+      allocation. If only the NUMA node is given, the thread may run on
+      any CPU of the node. */
+  struct Placement {
+    int cpu = -1;  ///< CPU to pin the thread to (-1: any)
+    int node = -1; ///< NUMA node to allocate memory on (-1: local)
+
+    bool empty() const { return cpu < 0 && node < 0; }
+
+    /// Retrieve the effective NUMA node (-1 if unknown).
+    int effective_node() const {
+      return (node < 0 && cpu >= 0) ? node_of_cpu(cpu) : node;
+    }
+
+    /// Return a string describing the placement, suitable for log output.
+    std::string to_string() const;
+  };
+
+  /// Retrieve the NUMA node of a given CPU (-1 if unknown).
+  static int node_of_cpu(int cpu);
+
 protected:
   static void set_node();
   static void set_cpu(int n);
+
+  /// Pin the calling thread according to a placement and prefer memory
+  /// allocation on its NUMA node.
+  static void set_placement(const Placement& placement);
+
+  /// Prefer memory allocation of the calling thread on a given NUMA node
+  /// (-1: revert to local allocation).
+  static void set_preferred_node(int node);
 };
@@ -0,0 +1,126 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::ThreadedSource stream stage.
+#pragma once
+
+#include "BoundedQueue.hpp"
+#include "Source.hpp"
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace fles {
+
+/**
+ * \brief The ThreadedSource class reads a source on a worker thread.
+ *
+ * The worker thread retrieves the items of the upstream source (e.g., a
+ * FilteredSource running a filter stage) ahead of time, so the upstream
+ * stage runs in parallel to the consumer. The items are passed in batches
+ * through a bounded queue to keep the synchronization cost per item low.
+ * A batch is handed over as soon as the consumer runs out of items, so
+ * batching does not delay items of a slow upstream source. The upstream
+ * source must not be used otherwise while the ThreadedSource exists.
+ *
+ * An exception thrown by the upstream source ends the stream; it is
+ * rethrown by get() after the items retrieved before have been delivered.
+ * The destructor stops the worker thread after its current get() returns.
+ */
+template <class T> class ThreadedSource : public Source<T> {
+public:
+  /// Construct a ThreadedSource reading ahead up to about capacity items.
+  ThreadedSource(Source<T>& source, size_t capacity)
+      : source_(source), batch_size_(std::max<size_t>(capacity / 2, 1)),
+        queue_(2), thread_([this] { run(); }) {}
+
+  ThreadedSource(const ThreadedSource&) = delete;
+  void operator=(const ThreadedSource&) = delete;
+
+  ~ThreadedSource() override {
+    queue_.close();
+    thread_.join();
+  }
+
+  bool eos() const override { return eos_; }
+
+private:
+  using batch_t = std::vector<std::unique_ptr<T>>;
+
+  T* do_get() override {
+    if (eos_) {
+      return nullptr;
+    }
+    while (next_ == batch_.size()) {
+      batch_.clear();
+      next_ = 0;
+      if (!queue_.pop(batch_)) {
+        eos_ = true;
+        if (error_) {
+          std::rethrow_exception(error_);
+        }
+        return nullptr;
+      }
+    }
+    return batch_[next_++].release();
+  }
+
+  /// Hand out the remaining items of the current batch, waiting for the
+  /// next batch only if none are left.
+  std::size_t do_get_batch(std::vector<std::unique_ptr<T>>& items,
+                           std::size_t max_items) override {
+    if (max_items == 0) {
+      return 0;
+    }
+    T* first = do_get();
+    if (first == nullptr) {
+      return 0;
+    }
+    items.emplace_back(first);
+    std::size_t n = 1;
+    while (n < max_items && next_ < batch_.size()) {
+      items.push_back(std::move(batch_[next_++]));
+      ++n;
+    }
+    return n;
+  }
+
+  /// The worker thread main function.
+  void run() {
+    batch_t batch;
+    try {
+      while (auto item = source_.get()) {
+        batch.push_back(std::move(item));
+        // hand over early if the consumer is waiting
+        if (batch.size() >= batch_size_ || queue_.size() == 0) {
+          if (!queue_.push(std::move(batch))) {
+            return;
+          }
+          batch = batch_t();
+        }
+      }
+    } catch (...) {
+      // published to the consumer by close()
+      error_ = std::current_exception();
+    }
+    if (!batch.empty()) {
+      queue_.push(std::move(batch));
+    }
+    queue_.close();
+  }
+
+  Source<T>& source_;
+  const size_t batch_size_;
+  BoundedQueue<batch_t> queue_;
+  std::exception_ptr error_;
+
+  /// The batch currently delivered by get() and its next item.
+  batch_t batch_;
+  size_t next_ = 0;
+
+  bool eos_ = false;
+  std::thread thread_;
+};
+
+} // namespace fles
@@ -0,0 +1,44 @@
+// Copyright 2026 agent <agent@local>
+
+#include "ThroughputBenchmark.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include <iomanip>
+
+double ThroughputResult::items_per_second() const {
+  double seconds = std::chrono::duration<double>(duration).count();
+  return seconds > 0 ? static_cast<double>(items) / seconds : 0;
+}
+
+double ThroughputResult::gigabytes_per_second() const {
+  double seconds = std::chrono::duration<double>(duration).count();
+  return seconds > 0 ? static_cast<double>(bytes) * 1e-9 / seconds : 0;
+}
+
+void ThroughputResult::print(std::ostream& out, const std::string& name) const {
+  auto us = [](std::chrono::nanoseconds ns) {
+    return static_cast<double>(ns.count()) * 1e-3;
+  };
+  const LatencyHistogram& h = latency_histogram;
+  out << name << ": " << items << " items, " << bytes << " bytes in "
+      << std::fixed << std::setprecision(3)
+      << std::chrono::duration<double>(duration).count() << " s" << std::endl;
+  out << "  throughput: " << std::setprecision(3) << gigabytes_per_second()
+      << " GB/s, " << std::setprecision(1) << items_per_second()
+      << " items/s" << std::endl;
+  out << "  latency/us: p50 " << us(h.quantile(0.5)) << ", p90 "
+      << us(h.quantile(0.9)) << ", p99 " << us(h.quantile(0.99)) << ", max "
+      << us(h.max()) << std::endl;
+  out << std::defaultfloat;
+}
+
+uint64_t item_size(const fles::Timeslice& timeslice) {
+  uint64_t size = 0;
+  for (uint64_t c = 0; c < timeslice.num_components(); ++c) {
+    size += timeslice.size_component(c);
+  }
+  return size;
+}
+
+uint64_t item_size(const fles::Microslice& microslice) {
+  return sizeof(fles::MicrosliceDescriptor) + microslice.desc().size;
+}
@@ -0,0 +1,163 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "LatencyHistogram.hpp"
+#include "Microslice.hpp"
+#include "Sink.hpp"
+#include "Source.hpp"
+#include "Timeslice.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// Result of a throughput benchmark run.
+struct ThroughputResult {
+  /// Account for a single item.
+  void add(uint64_t size, std::chrono::nanoseconds latency) {
+    ++items;
+    bytes += size;
+    latency_histogram.add(latency);
+  }
+
+  double items_per_second() const;
+  double gigabytes_per_second() const;
+
+  /// Print a summary of the result.
+  void print(std::ostream& out, const std::string& name) const;
+
+  uint64_t items = 0;
+  uint64_t bytes = 0;
+
+  /// Total measured time.
+  std::chrono::nanoseconds duration{0};
+
+  /// Distribution of the time spent per item.
+  LatencyHistogram latency_histogram;
+};
+
+/// Size in bytes of a timeslice (descriptors and content).
+uint64_t item_size(const fles::Timeslice& timeslice);
+
+/// Size in bytes of a microslice (descriptor and content).
+uint64_t item_size(const fles::Microslice& microslice);
+
+/// Sink discarding all items.
+template <class T> class NullSink : public fles::Sink<T> {
+public:
+  void put(std::shared_ptr<const T> /* item */) override {}
+};
+
+/// Measure the throughput of a source.
+/** Drains up to max_items from the source into a null sink. The latency
+    of an item is the time from the release of the previous item to the
+    release of this one, i.e., it includes the time blocked in get() and
+    the cost of handing the item back to the source (e.g., completion of
+    a timeslice in a timeslice buffer).
+
+    With a batch_size above 1, the items are retrieved with get_batch()
+    and each item of a batch is accounted with the average latency. */
+template <class T>
+ThroughputResult benchmark_source(fles::Source<T>& source,
+                                  uint64_t max_items = UINT64_MAX,
+                                  std::size_t batch_size = 1) {
+  using clock = std::chrono::steady_clock;
+  NullSink<T> sink;
+  ThroughputResult result;
+
+  auto begin = clock::now();
+  auto last = begin;
+  if (batch_size <= 1) {
+    while (result.items < max_items) {
+      std::shared_ptr<const T> item = source.get();
+      if (!item) {
+        break;
+      }
+      uint64_t size = item_size(*item);
+      sink.put(std::move(item));
+      auto now = clock::now();
+      result.add(size, now - last);
+      last = now;
+    }
+  } else {
+    std::vector<std::unique_ptr<T>> items;
+    std::vector<uint64_t> sizes;
+    while (result.items < max_items) {
+      auto n = source.get_batch(
+          items, std::min<uint64_t>(batch_size, max_items - result.items));
+      if (n == 0) {
+        break;
+      }
+      sizes.clear();
+      for (auto& item : items) {
+        sizes.push_back(item_size(*item));
+        sink.put(std::move(item));
+      }
+      items.clear();
+      auto now = clock::now();
+      for (uint64_t size : sizes) {
+        result.add(size, (now - last) / n);
+      }
+      last = now;
+    }
+  }
+  result.duration = last - begin;
+  return result;
+}
+
+/// Measure the throughput of a sink.
+/** Feeds up to max_items from a generator source (usually an in-memory
+    source like SyntheticTimesliceSource) to the sink and signals the end
+    of the stream. Only the time spent in put(), put_batch() and
+    end_stream() is measured, so the cost of the generator does not affect
+    the result. With a batch_size above 1, the items are passed to the sink
+    with put_batch(). */
+template <class T>
+ThroughputResult benchmark_sink(fles::Sink<T>& sink,
+                                fles::Source<T>& generator,
+                                uint64_t max_items = UINT64_MAX,
+                                std::size_t batch_size = 1) {
+  using clock = std::chrono::steady_clock;
+  ThroughputResult result;
+
+  batch_size = std::max<std::size_t>(batch_size, 1);
+  std::vector<std::shared_ptr<const T>> batch;
+  std::vector<uint64_t> sizes;
+  while (result.items < max_items) {
+    batch.clear();
+    sizes.clear();
+    while (batch.size() < batch_size &&
+           result.items + batch.size() < max_items) {
+      std::shared_ptr<const T> item = generator.get();
+      if (!item) {
+        break;
+      }
+      sizes.push_back(item_size(*item));
+      batch.push_back(std::move(item));
+    }
+    if (batch.empty()) {
+      break;
+    }
+    auto begin = clock::now();
+    if (batch_size == 1) {
+      sink.put(batch.front());
+    } else {
+      sink.put_batch(batch);
+    }
+    auto latency = clock::now() - begin;
+    // release the items outside of the measurement
+    batch.clear();
+    result.duration += latency;
+    for (uint64_t size : sizes) {
+      result.add(size, latency / sizes.size());
+    }
+  }
+
+  auto begin = clock::now();
+  sink.end_stream();
+  result.duration += clock::now() - begin;
+  return result;
+}
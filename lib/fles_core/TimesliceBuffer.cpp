@@ -1,17 +1,26 @@
 // Copyright 2016 Jan de Cuveland <cmail@cuveland.de>
 
 #include "TimesliceBuffer.hpp"
+#include "log.hpp"
 
+#include <algorithm>
 #include <utility>
 
 TimesliceBuffer::TimesliceBuffer(std::string shm_identifier,
                                  uint32_t data_buffer_size_exp,
                                  uint32_t desc_buffer_size_exp,
-                                 uint32_t num_input_nodes)
+                                 uint32_t num_input_nodes,
+                                 uint32_t num_consumers,
+                                 uint32_t max_in_flight)
     : shm_identifier_(std::move(shm_identifier)),
       data_buffer_size_exp_(data_buffer_size_exp),
       desc_buffer_size_exp_(desc_buffer_size_exp),
-      num_input_nodes_(num_input_nodes) {
+      num_input_nodes_(num_input_nodes), num_consumers_(num_consumers),
+      max_in_flight_(max_in_flight),
+      latency_metric_(MetricsRegistry::get().histogram(
+          "flesnet_timeslice_latency_seconds", {{"buffer", shm_identifier_}},
+          "Timeslice dispatch-to-completion latency")),
+      telemetry_(Telemetry::get().add_channel("buffer " + shm_identifier_)) {
   boost::interprocess::shared_memory_object::remove(
       (shm_identifier_ + "data_").c_str());
   boost::interprocess::shared_memory_object::remove(
@@ -80,6 +89,17 @@ TimesliceBuffer::TimesliceBuffer(std::string shm_identifier,
           (shm_identifier_ + "completions_").c_str(), desc_buffer_size,
           sizeof(fles::TimesliceCompletion)));
   completions_mq_ = std::move(completions_mq);
+
+  for (uint32_t i = 0; i < num_consumers_; ++i) {
+    std::string name = consumer_queue_name(shm_identifier_, i);
+    boost::interprocess::message_queue::remove(name.c_str());
+    consumer_mqs_.push_back(std::unique_ptr<boost::interprocess::message_queue>(
+        new boost::interprocess::message_queue(
+            boost::interprocess::create_only, name.c_str(), desc_buffer_size,
+            sizeof(fles::TimesliceWorkItem))));
+  }
+  consumer_stats_.resize(num_consumers_);
+  dispatch_.resize(desc_buffer_size);
 }
 
 TimesliceBuffer::~TimesliceBuffer() {
@@ -91,6 +111,166 @@ TimesliceBuffer::~TimesliceBuffer() {
       (shm_identifier_ + "work_items_").c_str());
   boost::interprocess::message_queue::remove(
       (shm_identifier_ + "completions_").c_str());
+  for (uint32_t i = 0; i < num_consumers_; ++i) {
+    boost::interprocess::message_queue::remove(
+        consumer_queue_name(shm_identifier_, i).c_str());
+  }
+}
+
+std::string TimesliceBuffer::consumer_queue_name(
+    const std::string& shm_identifier, uint32_t consumer) {
+  return shm_identifier + "work_items_" + std::to_string(consumer) + "_";
+}
+
+uint32_t TimesliceBuffer::select_consumer() {
+  uint32_t best = UINT32_MAX;
+  for (uint32_t n = 0; n < num_consumers_; ++n) {
+    uint32_t i = (next_consumer_ + n) % num_consumers_;
+    const ConsumerStatistics& cs = consumer_stats_[i];
+    if (max_in_flight_ != 0 && cs.in_flight >= max_in_flight_) {
+      continue;
+    }
+    if (best == UINT32_MAX || cs.in_flight < consumer_stats_[best].in_flight) {
+      best = i;
+    }
+  }
+  next_consumer_ = (next_consumer_ + 1) % num_consumers_;
+  return best;
+}
+
+void TimesliceBuffer::send_work_item(fles::TimesliceWorkItem wi) {
+  ++num_timeslices_;
+  for (uint32_t i = 0; i < wi.ts_desc.num_components; ++i) {
+    num_bytes_ += get_desc(i, wi.ts_desc.ts_pos).size;
+  }
+
+  Dispatch& d = dispatch_entry(wi.ts_desc.ts_pos);
+  d.pending = true;
+  d.consumer = UINT32_MAX;
+  d.ts_index = wi.ts_desc.index;
+  d.time = std::chrono::steady_clock::now();
+
+  ++num_outstanding_;
+  telemetry_.items.store(num_timeslices_, std::memory_order_relaxed);
+  telemetry_.bytes.store(num_bytes_, std::memory_order_relaxed);
+  telemetry_.outstanding.store(num_outstanding_, std::memory_order_relaxed);
+  telemetry_.touch();
+
+  if (num_consumers_ == 0) {
+    if (trace_) {
+      trace_->record(wi.ts_desc.index, TraceStage::WorkItemQueued, UINT32_MAX);
+    }
+    work_items_mq_->send(&wi, sizeof(wi), 0);
+    return;
+  }
+
+  backlog_.push_back(wi);
+  dispatch_backlog();
+}
+
+void TimesliceBuffer::dispatch(const fles::TimesliceWorkItem& wi,
+                               uint32_t consumer) {
+  Dispatch& d = dispatch_entry(wi.ts_desc.ts_pos);
+  d.consumer = consumer;
+  if (trace_) {
+    trace_->record(wi.ts_desc.index, TraceStage::WorkItemQueued, consumer);
+  }
+  ++consumer_stats_[consumer].dispatched;
+  ++consumer_stats_[consumer].in_flight;
+  consumer_mqs_[consumer]->send(&wi, sizeof(wi), 0);
+}
+
+void TimesliceBuffer::dispatch_backlog() {
+  while (!backlog_.empty()) {
+    uint32_t consumer = select_consumer();
+    if (consumer == UINT32_MAX) {
+      // all consumers are busy, wait for the next completion
+      return;
+    }
+    dispatch(backlog_.front(), consumer);
+    backlog_.pop_front();
+  }
+}
+
+void TimesliceBuffer::send_end_work_item() {
+  // work items still held back (e.g., on abort) must precede the end marker
+  while (!backlog_.empty()) {
+    dispatch(backlog_.front(), next_consumer_);
+    next_consumer_ = (next_consumer_ + 1) % num_consumers_;
+    backlog_.pop_front();
+  }
+  work_items_mq_->send(nullptr, 0, 0);
+  for (auto& mq : consumer_mqs_) {
+    mq->send(nullptr, 0, 0);
+  }
+}
+
+std::size_t TimesliceBuffer::get_num_work_items() const {
+  std::size_t num = work_items_mq_->get_num_msg() + backlog_.size();
+  for (const auto& mq : consumer_mqs_) {
+    num += mq->get_num_msg();
+  }
+  return num;
+}
+
+bool TimesliceBuffer::try_receive_completion(fles::TimesliceCompletion& c) {
+  std::size_t recvd_size;
+  unsigned int priority;
+  if (!completions_mq_->try_receive(&c, sizeof(c), recvd_size, priority)) {
+    return false;
+  }
+  if (recvd_size == 0) {
+    return false;
+  }
+  assert(recvd_size == sizeof(c));
+
+  Dispatch& d = dispatch_entry(c.ts_pos);
+  if (d.pending) {
+    d.pending = false;
+    --num_outstanding_;
+    telemetry_.outstanding.store(num_outstanding_, std::memory_order_relaxed);
+    auto latency = std::chrono::steady_clock::now() - d.time;
+    latency_metric_.observe(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(latency));
+    if (d.consumer != UINT32_MAX) {
+      --consumer_stats_[d.consumer].in_flight;
+    }
+    uint32_t consumer =
+        (c.consumer_index < num_consumers_) ? c.consumer_index : d.consumer;
+    if (trace_) {
+      trace_->record(d.ts_index, TraceStage::CompletionReturned, consumer);
+    }
+    if (consumer != UINT32_MAX) {
+      ConsumerStatistics& cs = consumer_stats_[consumer];
+      ++cs.completed;
+      if (consumer != d.consumer) {
+        ++cs.stolen;
+      }
+      cs.latency_sum += latency;
+      cs.latency_max = std::max(cs.latency_max, latency);
+    }
+    // the consumer may have dropped below its in-flight limit
+    dispatch_backlog();
+  }
+  return true;
+}
+
+void TimesliceBuffer::log_consumer_statistics(const std::string& prefix) const {
+  double runtime = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start_time_)
+                       .count();
+  for (uint32_t i = 0; i < num_consumers_; ++i) {
+    const ConsumerStatistics& cs = consumer_stats_[i];
+    L_(info) << prefix << "consumer " << i << ": " << cs.completed
+             << " timeslices completed ("
+             << static_cast<double>(cs.completed) / runtime << " /s, "
+             << cs.stolen << " stolen, "
+             << cs.dispatched << " dispatched), latency mean "
+             << cs.mean_latency_us() << " us, max "
+             << std::chrono::duration<double, std::micro>(cs.latency_max)
+                    .count()
+             << " us";
+  }
 }
 
 uint8_t* TimesliceBuffer::get_data_ptr(uint_fast16_t index) {
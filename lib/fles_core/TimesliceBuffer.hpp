@@ -1,27 +1,63 @@
 // Copyright 2016 Jan de Cuveland <cmail@cuveland.de>
 #pragma once
 
+#include "LatencyHistogram.hpp"
+#include "Metrics.hpp"
+#include "Telemetry.hpp"
 #include "TimesliceCompletion.hpp"
 #include "TimesliceComponentDescriptor.hpp"
 #include "TimesliceWorkItem.hpp"
+#include "TraceRecorder.hpp"
 
 #include <boost/interprocess/ipc/message_queue.hpp>
 #include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/shared_memory_object.hpp>
 
+#include <chrono>
 #include <csignal>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
 
 /// Timeslice buffer container class.
 /** A TimesliceBuffer object represents the compute node's timeslice buffer
-   (filled by the input nodes). */
+   (filled by the input nodes).
+
+   If constructed with a nonzero number of consumers, work items are not
+   placed into the shared work item queue, but distributed to one queue per
+   consumer (the least loaded consumer below its in-flight limit is chosen).
+   If all consumers are at their limit, the item is held back until a
+   completion frees a consumer. Idle consumers may steal work from the queues
+   of other consumers (see fles::TimesliceReceiver). */
 
 class TimesliceBuffer {
 public:
+  /// Per-consumer accounting of work items.
+  struct ConsumerStatistics {
+    uint64_t dispatched = 0; ///< Items placed into this consumer's queue
+    uint64_t completed = 0;  ///< Items completed by this consumer
+    uint64_t stolen = 0;     ///< Items taken from another consumer's queue
+    uint64_t in_flight = 0;  ///< Items dispatched, but not yet completed
+    std::chrono::steady_clock::duration latency_sum{0};
+    std::chrono::steady_clock::duration latency_max{0};
+
+    double mean_latency_us() const {
+      if (completed == 0) {
+        return 0.0;
+      }
+      return std::chrono::duration<double, std::micro>(latency_sum).count() /
+             static_cast<double>(completed);
+    }
+  };
+
   /// The TimesliceBuffer constructor.
   TimesliceBuffer(std::string shm_identifier,
                   uint32_t data_buffer_size_exp,
                   uint32_t desc_buffer_size_exp,
-                  uint32_t num_input_nodes);
+                  uint32_t num_input_nodes,
+                  uint32_t num_consumers = 0,
+                  uint32_t max_in_flight = 0);
 
   TimesliceBuffer(const TimesliceBuffer&) = delete;
   void operator=(const TimesliceBuffer&) = delete;
@@ -41,40 +77,84 @@ public:
 
   uint32_t get_num_input_nodes() const { return num_input_nodes_; }
 
-  void send_work_item(fles::TimesliceWorkItem wi) {
-    work_items_mq_->send(&wi, sizeof(wi), 0);
-  }
+  uint32_t get_num_consumers() const { return num_consumers_; }
+
+  /// Dispatch a work item to a consumer queue (or the shared queue).
+  void send_work_item(fles::TimesliceWorkItem wi);
 
   void send_completion(fles::TimesliceCompletion c) {
     completions_mq_->send(&c, sizeof(c), 0);
   }
 
-  void send_end_work_item() { work_items_mq_->send(nullptr, 0, 0); }
+  /// Send the end-of-stream marker to all work item queues.
+  void send_end_work_item();
 
   void send_end_completion() { completions_mq_->send(nullptr, 0, 0); }
 
-  std::size_t get_num_work_items() const {
-    return work_items_mq_->get_num_msg();
-  }
+  /// Get the number of pending work items, including held back ones.
+  std::size_t get_num_work_items() const;
 
   std::size_t get_num_completions() const {
     return completions_mq_->get_num_msg();
   }
 
-  bool try_receive_completion(fles::TimesliceCompletion& c) {
-    std::size_t recvd_size;
-    unsigned int priority;
-    if (!completions_mq_->try_receive(&c, sizeof(c), recvd_size, priority)) {
-      return false;
-    }
-    if (recvd_size == 0) {
-      return false;
-    }
-    assert(recvd_size == sizeof(c));
-    return true;
-  };
+  /// Receive a completion and update the consumer statistics.
+  bool try_receive_completion(fles::TimesliceCompletion& c);
+
+  const std::vector<ConsumerStatistics>& consumer_statistics() const {
+    return consumer_stats_;
+  }
+
+  /// Number of timeslices dispatched to the consumers.
+  uint64_t num_timeslices() const { return num_timeslices_; }
+
+  /// Number of timeslice data bytes dispatched to the consumers.
+  uint64_t num_bytes() const { return num_bytes_; }
+
+  /// Dispatch-to-completion latency of all timeslices.
+  LatencyHistogram latency_histogram() const {
+    return latency_metric_.snapshot();
+  }
+
+  /// Log a summary line for each consumer.
+  void log_consumer_statistics(const std::string& prefix) const;
+
+  /// Record the trace points of this compute node. The work item queued
+  /// and completion returned points are recorded by the buffer itself,
+  /// the timeslice builder adds its own points through trace().
+  void set_trace(std::unique_ptr<TraceRecorder> trace) {
+    trace_ = std::move(trace);
+  }
+
+  /// Retrieve the trace recorder (nullptr if tracing is disabled).
+  TraceRecorder* trace() const { return trace_.get(); }
+
+  /// Name of the work item queue of a given consumer.
+  static std::string consumer_queue_name(const std::string& shm_identifier,
+                                         uint32_t consumer);
 
 private:
+  /// Bookkeeping entry for a dispatched work item.
+  struct Dispatch {
+    bool pending = false;
+    uint32_t consumer = UINT32_MAX;
+    uint64_t ts_index = 0;
+    std::chrono::steady_clock::time_point time;
+  };
+
+  Dispatch& dispatch_entry(uint64_t ts_pos) {
+    return dispatch_[ts_pos & ((UINT64_C(1) << desc_buffer_size_exp_) - 1)];
+  }
+
+  /// Choose the target consumer queue (or UINT32_MAX if all are busy).
+  uint32_t select_consumer();
+
+  /// Place a work item into the queue of a given consumer.
+  void dispatch(const fles::TimesliceWorkItem& wi, uint32_t consumer);
+
+  /// Dispatch held back work items to consumers below their limit.
+  void dispatch_backlog();
+
   std::string shm_identifier_;
 
   uint32_t data_buffer_size_exp_;
@@ -82,6 +162,12 @@ private:
 
   uint32_t num_input_nodes_;
 
+  uint32_t num_consumers_;
+  uint32_t max_in_flight_;
+
+  /// Consumer to start the search for the least loaded queue with.
+  uint32_t next_consumer_ = 0;
+
   std::unique_ptr<boost::interprocess::shared_memory_object> data_shm_;
   std::unique_ptr<boost::interprocess::shared_memory_object> desc_shm_;
 
@@ -90,4 +176,31 @@ private:
 
   std::unique_ptr<boost::interprocess::message_queue> work_items_mq_;
   std::unique_ptr<boost::interprocess::message_queue> completions_mq_;
+
+  std::vector<std::unique_ptr<boost::interprocess::message_queue>>
+      consumer_mqs_;
+
+  std::vector<ConsumerStatistics> consumer_stats_;
+
+  /// Work items held back while all consumers are at their in-flight limit.
+  std::deque<fles::TimesliceWorkItem> backlog_;
+
+  std::chrono::steady_clock::time_point start_time_ =
+      std::chrono::steady_clock::now();
+
+  /// Dispatch bookkeeping, indexed by timeslice position (ring buffer).
+  std::vector<Dispatch> dispatch_;
+
+  uint64_t num_timeslices_ = 0;
+  uint64_t num_bytes_ = 0;
+  uint64_t num_outstanding_ = 0;
+
+  /// Dispatch-to-completion latency, exported via the MetricsRegistry.
+  MetricHistogram& latency_metric_;
+
+  /// Dispatched and outstanding work items, published for flesmon.
+  TelemetryChannel& telemetry_;
+
+  /// Optional timeslice trace recorder.
+  std::unique_ptr<TraceRecorder> trace_;
 };
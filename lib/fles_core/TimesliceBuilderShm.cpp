@@ -0,0 +1,196 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TimesliceBuilderShm.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include "Utility.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+TimesliceBuilderShm::TimesliceBuilderShm(uint64_t compute_index,
+                                         TimesliceBuffer& timeslice_buffer,
+                                         ShmTransport& transport,
+                                         uint32_t max_timeslice_number,
+                                         volatile sig_atomic_t* signal_status)
+    : compute_index_(compute_index), timeslice_buffer_(timeslice_buffer),
+      transport_(transport), builder_(transport.builder(compute_index)),
+      max_timeslice_number_(max_timeslice_number),
+      signal_status_(signal_status), ts_index_(compute_index),
+      ack_(timeslice_buffer_.get_desc_size_exp()) {
+  assert(transport_.num_inputs() == timeslice_buffer_.get_num_input_nodes());
+  for (size_t i = 0; i < transport_.num_inputs(); ++i) {
+    components_.emplace_back(new Component(timeslice_buffer_, i));
+  }
+}
+
+void TimesliceBuilderShm::operator()() {
+  time_begin_ = std::chrono::high_resolution_clock::now();
+  scheduler_.add_periodic(report_metrics_timer_, std::chrono::seconds(1));
+
+  while (ts_index_ < max_timeslice_number_ && *signal_status_ == 0) {
+    if (!try_build_timeslice()) {
+      handle_timeslice_completions();
+      std::this_thread::yield();
+    }
+    scheduler_.timer();
+  }
+
+  time_end_ = std::chrono::high_resolution_clock::now();
+
+  // wait until all pending timeslices have been acknowledged
+  while (acked_ < tpos_) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    handle_timeslice_completions();
+  }
+  assert(timeslice_buffer_.get_num_work_items() == 0);
+  assert(timeslice_buffer_.get_num_completions() == 0);
+  timeslice_buffer_.send_end_work_item();
+  timeslice_buffer_.send_end_completion();
+
+  double runtime =
+      std::chrono::duration<double>(time_end_ - time_begin_).count();
+  L_(info) << "[c" << compute_index_ << "] " << tpos_ << " timeslices, "
+           << human_readable_count(bytes_copied_) << " copied ("
+           << human_readable_count(static_cast<uint64_t>(
+                                       static_cast<double>(bytes_copied_) /
+                                       runtime),
+                                   true, "B/s")
+           << ")";
+  timeslice_buffer_.log_consumer_statistics(
+      "[c" + std::to_string(compute_index_) + "] ");
+}
+
+TimesliceBuilderShm::ComponentRange
+TimesliceBuilderShm::component_range(size_t input) {
+  ShmTransport::Input& in = transport_.input(input);
+  RingBufferView<fles::MicrosliceDescriptor>& desc_buffer =
+      in.data_source.desc_buffer();
+
+  ComponentRange range{};
+  range.desc_offset =
+      ts_index_ * transport_.timeslice_size() + in.start_index.desc;
+  range.desc_length = transport_.timeslice_size() + in.overlap_size;
+  range.data_offset = desc_buffer.at(range.desc_offset).offset;
+  const auto& last = desc_buffer.at(range.desc_offset + range.desc_length - 1);
+  assert(last.offset + last.size >= range.data_offset);
+  range.data_length = last.offset + last.size - range.data_offset;
+  return range;
+}
+
+bool TimesliceBuilderShm::try_build_timeslice() {
+  uint64_t desc_end = (ts_index_ + 1) * transport_.timeslice_size();
+
+  // check if the complete timeslice is available in all input buffers
+  for (size_t i = 0; i < components_.size(); ++i) {
+    ShmTransport::Input& in = transport_.input(i);
+    if (in.write_index_desc.load(std::memory_order_acquire) <
+        desc_end + in.overlap_size + in.start_index.desc) {
+      return false;
+    }
+  }
+
+  // check if there is space for all components in the timeslice buffer
+  for (size_t i = 0; i < components_.size(); ++i) {
+    auto& c = components_[i];
+    if (c->data.size_available_contiguous() < component_range(i).size() ||
+        c->desc.size_available() < 1) {
+      return false;
+    }
+  }
+
+  uint64_t ts_bytes = 0;
+  for (size_t i = 0; i < components_.size(); ++i) {
+    auto& c = components_[i];
+    InputBufferReadInterface& source = transport_.input(i).data_source;
+    ComponentRange range = component_range(i);
+
+    // skip remaining bytes in data buffer to avoid fractured entry
+    c->data.skip_buffer_wrap(range.size());
+
+    // generate timeslice component descriptor
+    assert(tpos_ == c->desc.write_index());
+    c->desc.append(
+        {ts_index_, c->data.write_index(), range.size(), range.desc_length});
+
+    // copy directly from the input buffer into shared memory
+    append(c->data, source.desc_buffer(), range.desc_offset,
+           range.desc_length);
+    append(c->data, source.data_buffer(), range.data_offset,
+           range.data_length);
+    ts_bytes += range.size();
+  }
+  bytes_copied_ += ts_bytes;
+  metrics_.add_timeslice(ts_bytes);
+  if (TraceRecorder* trace = timeslice_buffer_.trace()) {
+    trace->record(ts_index_, TraceStage::BuilderComplete,
+                  static_cast<uint32_t>(compute_index_));
+  }
+
+  // the input buffers are no longer needed for this timeslice
+  ts_index_ += transport_.num_builders();
+  builder_.next_timeslice.store(ts_index_, std::memory_order_release);
+
+  handle_timeslice_completions();
+
+  timeslice_buffer_.send_work_item(
+      {{ts_index_ - transport_.num_builders(), tpos_,
+        transport_.timeslice_size(),
+        static_cast<uint32_t>(components_.size())},
+       timeslice_buffer_.get_data_size_exp(),
+       timeslice_buffer_.get_desc_size_exp()});
+  ++tpos_;
+
+  return true;
+}
+
+template <typename T>
+void TimesliceBuilderShm::append(ManagedRingBuffer<uint8_t>& dst,
+                                 const RingBufferView<T>& src,
+                                 uint64_t offset,
+                                 uint64_t length) {
+  uint64_t length1 =
+      std::min<uint64_t>(length, src.size() - (offset & src.size_mask()));
+  dst.append(reinterpret_cast<const uint8_t*>(&src.at(offset)),
+             length1 * sizeof(T));
+  if (length1 < length) {
+    dst.append(reinterpret_cast<const uint8_t*>(src.ptr()),
+               (length - length1) * sizeof(T));
+  }
+}
+
+void TimesliceBuilderShm::handle_timeslice_completions() {
+  fles::TimesliceCompletion c;
+  while (timeslice_buffer_.try_receive_completion(c)) {
+    if (c.ts_pos == acked_) {
+      do {
+        ++acked_;
+      } while (ack_.at(acked_) > c.ts_pos);
+      for (auto& component : components_) {
+        component->desc.set_read_index(acked_);
+        component->data.set_read_index(
+            component->desc.at(acked_ - 1).offset +
+            component->desc.at(acked_ - 1).size);
+      }
+    } else {
+      ack_.at(c.ts_pos) = c.ts_pos;
+    }
+  }
+}
+
+void TimesliceBuilderShm::report_metrics() {
+  double data_fill = 0.;
+  double desc_fill = 0.;
+  for (auto& c : components_) {
+    data_fill = std::max(data_fill, static_cast<double>(c->data.size_used()) /
+                                        static_cast<double>(c->data.size()));
+    desc_fill = std::max(desc_fill, static_cast<double>(c->desc.size_used()) /
+                                        static_cast<double>(c->desc.size()));
+  }
+  metrics_.set_buffer_fill(data_fill, desc_fill);
+  metrics_.update_rates();
+
+  if (TraceRecorder* trace = timeslice_buffer_.trace()) {
+    trace->flush();
+  }
+}
@@ -0,0 +1,133 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "ManagedRingBuffer.hpp"
+#include "Metrics.hpp"
+#include "RingBuffer.hpp"
+#include "Scheduler.hpp"
+#include "ShmTransport.hpp"
+#include "TimesliceBuffer.hpp"
+#include <chrono>
+#include <csignal>
+#include <memory>
+#include <vector>
+
+/// Timeslice builder of the intra-node transport.
+/** A TimesliceBuilderShm object assembles the timeslices assigned to its
+    compute node index by copying the timeslice components directly from
+    the input buffers of the same process into the timeslice buffer. The
+    progress is reported back to the input channels through the shared
+    ShmTransport state, see ComponentSenderShm. */
+
+class TimesliceBuilderShm {
+public:
+  /// The TimesliceBuilderShm constructor.
+  TimesliceBuilderShm(uint64_t compute_index,
+                      TimesliceBuffer& timeslice_buffer,
+                      ShmTransport& transport,
+                      uint32_t max_timeslice_number,
+                      volatile sig_atomic_t* signal_status);
+
+  TimesliceBuilderShm(const TimesliceBuilderShm&) = delete;
+  void operator=(const TimesliceBuilderShm&) = delete;
+
+  /// The thread main function.
+  void operator()();
+
+private:
+  /// Position of a timeslice component in an input buffer.
+  struct ComponentRange {
+    uint64_t desc_offset;
+    uint64_t desc_length;
+    uint64_t data_offset;
+    uint64_t data_length;
+
+    /// Size of the component in the timeslice buffer.
+    uint64_t size() const {
+      return desc_length * sizeof(fles::MicrosliceDescriptor) + data_length;
+    }
+  };
+
+  /// This builder's index in the list of compute nodes.
+  const uint64_t compute_index_;
+
+  /// Shared memory buffer to store assembled timeslices.
+  TimesliceBuffer& timeslice_buffer_;
+
+  /// The shared state of the intra-node transport.
+  ShmTransport& transport_;
+
+  /// This builder's shared state.
+  ShmTransport::Builder& builder_;
+
+  /// Number of timeslices after which this run shall end.
+  const uint32_t max_timeslice_number_;
+
+  /// Pointer to global signal status variable.
+  volatile sig_atomic_t* signal_status_;
+
+  /// Index of acknowledged timeslices (local index).
+  uint64_t acked_ = 0;
+
+  /// The global index of the timeslice currently being assembled.
+  uint64_t ts_index_;
+
+  /// The local buffer position of the timeslice currently being assembled.
+  uint64_t tpos_ = 0;
+
+  /// Buffer to store acknowledged status of timeslices.
+  RingBuffer<uint64_t, true> ack_;
+
+  /// Timeslice buffer component, one per input channel.
+  struct Component {
+    Component(TimesliceBuffer& timeslice_buffer, size_t i)
+        : desc(timeslice_buffer.get_desc_ptr(i),
+               timeslice_buffer.get_desc_size_exp()),
+          data(timeslice_buffer.get_data_ptr(i),
+               timeslice_buffer.get_data_size_exp()) {}
+
+    ManagedRingBuffer<fles::TimesliceComponentDescriptor> desc;
+    ManagedRingBuffer<uint8_t> data;
+  };
+
+  /// The vector of timeslice buffer components.
+  std::vector<std::unique_ptr<Component>> components_;
+
+  /// Amount of data copied (for performance statistics).
+  uint64_t bytes_copied_ = 0;
+
+  /// Begin of operation (for performance statistics).
+  std::chrono::high_resolution_clock::time_point time_begin_;
+
+  /// End of operation (for performance statistics).
+  std::chrono::high_resolution_clock::time_point time_end_;
+
+  /// Progress and buffer metrics of this timeslice builder.
+  ComponentMetrics metrics_{"output", compute_index_};
+
+  /// Scheduler for periodic events.
+  Scheduler scheduler_;
+
+  /// Timer for the periodic metrics update.
+  Scheduler::Timer report_metrics_timer_{[this] { report_metrics(); }};
+
+  /// Try to assemble the current timeslice, return true on success.
+  bool try_build_timeslice();
+
+  /// Retrieve the position of the current timeslice in an input buffer.
+  ComponentRange component_range(size_t input);
+
+  /// Append entries of an input ring buffer to a timeslice buffer
+  /// component.
+  template <typename T>
+  static void append(ManagedRingBuffer<uint8_t>& dst,
+                     const RingBufferView<T>& src,
+                     uint64_t offset,
+                     uint64_t length);
+
+  /// Handle pending timeslice completions and advance read indexes.
+  void handle_timeslice_completions();
+
+  /// Update the buffer fill level and rate metrics.
+  void report_metrics();
+};
@@ -0,0 +1,33 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TimesliceProcessor.hpp"
+#include "TimesliceSinkRegistry.hpp"
+#include "log.hpp"
+#include <chrono>
+
+TimesliceProcessor::TimesliceProcessor(const std::string& shm_identifier,
+                                       uint32_t worker_index,
+                                       const std::string& sink_spec)
+    : worker_index_(worker_index),
+      source_(shm_identifier, static_cast<int32_t>(worker_index)),
+      sink_(TimesliceSinkRegistry::get().create(sink_spec, worker_index,
+                                                log_.stream)) {}
+
+void TimesliceProcessor::operator()() {
+  auto time_begin = std::chrono::steady_clock::now();
+
+  // the view refers to the timeslice buffer memory and is completed when the
+  // last reference is released
+  while (auto timeslice = source_.get()) {
+    sink_->put(std::shared_ptr<const fles::Timeslice>(std::move(timeslice)));
+    ++timeslice_count_;
+  }
+  sink_->end_stream();
+
+  double runtime = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - time_begin)
+                       .count();
+  L_(info) << "timeslice processor " << worker_index_ << ": "
+           << timeslice_count_ << " timeslices processed ("
+           << static_cast<double>(timeslice_count_) / runtime << " /s)";
+}
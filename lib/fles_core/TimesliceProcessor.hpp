@@ -0,0 +1,42 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "Sink.hpp"
+#include "TimesliceReceiver.hpp"
+#include "log.hpp"
+#include <memory>
+#include <string>
+
+/// In-process timeslice processor class.
+/** A TimesliceProcessor object reads timeslices directly from the memory of
+    a local timeslice buffer and feeds them to a timeslice sink. It is
+    intended to be run in its own thread, several instances per timeslice
+    buffer form a pool of processing threads. The sink is created from the
+    TimesliceSinkRegistry and writes to a log stream of its own. */
+
+class TimesliceProcessor {
+public:
+  /// The TimesliceProcessor constructor.
+  TimesliceProcessor(const std::string& shm_identifier,
+                     uint32_t worker_index,
+                     const std::string& sink_spec);
+
+  TimesliceProcessor(const TimesliceProcessor&) = delete;
+  void operator=(const TimesliceProcessor&) = delete;
+
+  /// The thread main function.
+  void operator()();
+
+  uint64_t timeslice_count() const { return timeslice_count_; }
+
+private:
+  uint32_t worker_index_;
+
+  /// The log stream of this thread, not shared with other processors.
+  logging::OstreamLog log_{status};
+
+  fles::TimesliceReceiver source_;
+  std::unique_ptr<fles::TimesliceSink> sink_;
+
+  uint64_t timeslice_count_ = 0;
+};
@@ -0,0 +1,135 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TimesliceSinkPipeline.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <utility>
+
+TimesliceSinkPipeline::Stage::Stage(std::unique_ptr<fles::TimesliceSink> s,
+                                    std::string n,
+                                    size_t queue_size,
+                                    MetricHistogram& pm,
+                                    MetricGauge& qm)
+    : sink(std::move(s)), name(std::move(n)), queue(queue_size),
+      put_metric(pm), queue_metric(qm) {}
+
+TimesliceSinkPipeline::TimesliceSinkPipeline(size_t queue_size,
+                                             const std::string& metrics_prefix,
+                                             MetricLabels labels)
+    : queue_size_(std::max<size_t>(queue_size, 1)),
+      metrics_prefix_(metrics_prefix), labels_(std::move(labels)) {}
+
+TimesliceSinkPipeline::~TimesliceSinkPipeline() { join(); }
+
+void TimesliceSinkPipeline::add(std::unique_ptr<fles::TimesliceSink> sink,
+                                const std::string& name) {
+  MetricLabels labels = labels_;
+  labels.emplace_back("sink", name);
+  auto& put_metric = MetricsRegistry::get().histogram(
+      metrics_prefix_ + "_sink_put_seconds", labels,
+      "Time spent by a sink on a timeslice");
+  auto& queue_metric = MetricsRegistry::get().gauge(
+      metrics_prefix_ + "_sink_queue_depth", labels,
+      "Number of timeslices queued for a sink");
+  stages_.emplace_back(new Stage(std::move(sink), name, queue_size_,
+                                 put_metric, queue_metric));
+  Stage& stage = *stages_.back();
+  stage.thread = std::thread([this, &stage] { run(stage); });
+}
+
+void TimesliceSinkPipeline::put(
+    std::shared_ptr<const fles::Timeslice> timeslice) {
+  rethrow_error();
+  for (auto& stage : stages_) {
+    size_t depth = stage->queue.size();
+    stage->max_queue_depth = std::max(stage->max_queue_depth, depth);
+    stage->queue_metric.set(static_cast<double>(depth));
+    stage->queue.push(timeslice);
+  }
+}
+
+void TimesliceSinkPipeline::end_stream() {
+  end_stream_ = true;
+  close();
+}
+
+void TimesliceSinkPipeline::close() {
+  join();
+  rethrow_error();
+}
+
+void TimesliceSinkPipeline::run(Stage& stage) {
+  std::shared_ptr<const fles::Timeslice> timeslice;
+  while (stage.queue.pop(timeslice)) {
+    if (stage.failed.load(std::memory_order_relaxed)) {
+      // release the timeslice without processing
+      timeslice.reset();
+      continue;
+    }
+    auto begin = std::chrono::steady_clock::now();
+    try {
+      stage.sink->put(std::move(timeslice));
+    } catch (...) {
+      stage.error = std::current_exception();
+      stage.failed.store(true, std::memory_order_release);
+      L_(error) << "sink " << stage.name << " failed, discarding timeslices";
+    }
+    timeslice.reset();
+    auto duration = std::chrono::steady_clock::now() - begin;
+    stage.put_metric.observe(duration);
+    stage.busy_ns.fetch_add(
+        static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+                .count()),
+        std::memory_order_relaxed);
+    stage.count.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (end_stream_ && !stage.failed.load(std::memory_order_relaxed)) {
+    try {
+      stage.sink->end_stream();
+    } catch (...) {
+      stage.error = std::current_exception();
+      stage.failed.store(true, std::memory_order_release);
+    }
+  }
+}
+
+void TimesliceSinkPipeline::join() {
+  if (closed_) {
+    return;
+  }
+  closed_ = true;
+  for (auto& stage : stages_) {
+    stage->queue.close();
+  }
+  for (auto& stage : stages_) {
+    if (stage->thread.joinable()) {
+      stage->thread.join();
+    }
+  }
+}
+
+void TimesliceSinkPipeline::rethrow_error() const {
+  for (const auto& stage : stages_) {
+    if (stage->failed.load(std::memory_order_acquire)) {
+      std::rethrow_exception(stage->error);
+    }
+  }
+}
+
+void TimesliceSinkPipeline::log_statistics(const std::string& prefix) const {
+  double runtime = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start_time_)
+                       .count();
+  for (const auto& stage : stages_) {
+    uint64_t count = stage->count.load(std::memory_order_relaxed);
+    double busy =
+        static_cast<double>(stage->busy_ns.load(std::memory_order_relaxed)) *
+        1e-9;
+    L_(info) << prefix << "sink " << stage->name << ": " << count
+             << " timeslices (" << static_cast<double>(count) / runtime
+             << " /s), busy " << 100.0 * busy / runtime
+             << " %, max queue depth " << stage->max_queue_depth << "/"
+             << stage->queue.capacity();
+  }
+}
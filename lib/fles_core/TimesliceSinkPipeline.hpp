@@ -0,0 +1,112 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "BoundedQueue.hpp"
+#include "Metrics.hpp"
+#include "Sink.hpp"
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Parallel timeslice sink pipeline class.
+/** A TimesliceSinkPipeline distributes each timeslice to several sinks,
+    each running in its own worker thread behind a bounded queue of shared
+    timeslice handles. The sinks thus process timeslices concurrently, and
+    a slow sink only throttles the others once its queue is full. A
+    timeslice is released (and, if received from a timeslice buffer,
+    completed) when the last sink has dropped its handle.
+
+    An exception thrown by a sink stops that sink. Its remaining items are
+    discarded, and the exception is rethrown by the next call to put() or
+    close(). */
+
+class TimesliceSinkPipeline : public fles::TimesliceSink {
+public:
+  /// The TimesliceSinkPipeline constructor.
+  /** \param queue_size     maximum number of queued timeslices per sink
+      \param metrics_prefix prefix of the per-sink metric names
+      \param labels         additional labels of the per-sink metrics */
+  TimesliceSinkPipeline(size_t queue_size,
+                        const std::string& metrics_prefix,
+                        MetricLabels labels = MetricLabels());
+
+  TimesliceSinkPipeline(const TimesliceSinkPipeline&) = delete;
+  void operator=(const TimesliceSinkPipeline&) = delete;
+
+  /// The TimesliceSinkPipeline destructor, stops all worker threads.
+  ~TimesliceSinkPipeline() override;
+
+  /// Add a sink and start its worker thread.
+  void add(std::unique_ptr<fles::TimesliceSink> sink, const std::string& name);
+
+  /// Retrieve the number of sinks.
+  size_t size() const { return stages_.size(); }
+
+  /// Pass a timeslice to all sinks, waiting for space in their queues.
+  void put(std::shared_ptr<const fles::Timeslice> timeslice) override;
+
+  /// Close the pipeline and signal the end of the stream to all sinks.
+  void end_stream() override;
+
+  /// Wait until all queued timeslices are processed and stop the worker
+  /// threads. Rethrows the first exception thrown by a sink.
+  void close();
+
+  /// Log a summary line for each sink.
+  void log_statistics(const std::string& prefix) const;
+
+private:
+  using Queue = BoundedQueue<std::shared_ptr<const fles::Timeslice>>;
+
+  /// A sink and its worker thread.
+  struct Stage {
+    Stage(std::unique_ptr<fles::TimesliceSink> sink,
+          std::string name,
+          size_t queue_size,
+          MetricHistogram& put_metric,
+          MetricGauge& queue_metric);
+
+    std::unique_ptr<fles::TimesliceSink> sink;
+    std::string name;
+    Queue queue;
+
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> busy_ns{0};
+    size_t max_queue_depth = 0;
+
+    /// Exception thrown by the sink, valid once failed is set.
+    std::exception_ptr error;
+    std::atomic<bool> failed{false};
+
+    MetricHistogram& put_metric;
+    MetricGauge& queue_metric;
+
+    std::thread thread;
+  };
+
+  /// The worker thread main function.
+  void run(Stage& stage);
+
+  /// Close all queues and join the worker threads.
+  void join();
+
+  /// Rethrow the first exception thrown by a sink (if any).
+  void rethrow_error() const;
+
+  size_t queue_size_;
+  std::string metrics_prefix_;
+  MetricLabels labels_;
+
+  std::vector<std::unique_ptr<Stage>> stages_;
+
+  /// Forward end_stream() to the sinks when their queues are drained.
+  std::atomic<bool> end_stream_{false};
+  bool closed_ = false;
+
+  std::chrono::steady_clock::time_point start_time_ =
+      std::chrono::steady_clock::now();
+};
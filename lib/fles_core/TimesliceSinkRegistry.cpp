@@ -0,0 +1,68 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TimesliceSinkRegistry.hpp"
+#include "TimesliceAnalyzer.hpp"
+#include "log.hpp"
+#include <dlfcn.h>
+#include <stdexcept>
+
+TimesliceSinkRegistry::TimesliceSinkRegistry() {
+  // built-in sinks
+  add("analyzer", [](const std::string& args, uint32_t worker_index,
+                     std::ostream& out) {
+    uint64_t output_interval = 1000;
+    if (!args.empty()) {
+      output_interval = std::stoull(args);
+    }
+    return std::unique_ptr<fles::TimesliceSink>(new TimesliceAnalyzer(
+        output_interval, out, std::to_string(worker_index) + ": ",
+        nullptr));
+  });
+}
+
+std::unique_ptr<fles::TimesliceSink>
+TimesliceSinkRegistry::create(const std::string& spec,
+                              uint32_t worker_index,
+                              std::ostream& out) const {
+  std::string name = spec;
+  std::string args;
+  auto pos = spec.find(':');
+  if (pos != std::string::npos) {
+    name = spec.substr(0, pos);
+    args = spec.substr(pos + 1);
+  }
+
+  auto it = factories_.find(name);
+  if (it == factories_.end()) {
+    throw std::runtime_error("unknown timeslice sink: " + name);
+  }
+  return it->second(args, worker_index, out);
+}
+
+void TimesliceSinkRegistry::load_library(const std::string& path) {
+  void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (handle == nullptr) {
+    throw std::runtime_error("failed to load plugin library: " +
+                             std::string(dlerror()));
+  }
+
+  using register_function = void (*)(TimesliceSinkRegistry&);
+  auto register_sinks = reinterpret_cast<register_function>(
+      dlsym(handle, "fles_register_timeslice_sinks"));
+  if (register_sinks == nullptr) {
+    dlclose(handle);
+    throw std::runtime_error("no fles_register_timeslice_sinks() in " + path);
+  }
+
+  libraries_.push_back(handle);
+  register_sinks(*this);
+  L_(debug) << "loaded timeslice sink plugin library " << path;
+}
+
+std::vector<std::string> TimesliceSinkRegistry::names() const {
+  std::vector<std::string> names;
+  for (const auto& factory : factories_) {
+    names.push_back(factory.first);
+  }
+  return names;
+}
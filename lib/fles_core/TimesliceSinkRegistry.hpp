@@ -0,0 +1,72 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "Sink.hpp"
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// Factory function creating a timeslice sink for a given worker thread. The
+/// sink should write its output to the given stream, which belongs to the
+/// worker thread.
+using TimesliceSinkFactory = std::function<std::unique_ptr<fles::TimesliceSink>(
+    const std::string& args, uint32_t worker_index, std::ostream& out)>;
+
+/// Timeslice sink registry class.
+/** The TimesliceSinkRegistry holds named factories of timeslice sinks that
+    can be run in-process as timeslice processors. Factories are either
+    registered statically (see TimesliceSinkRegistration) or loaded from a
+    shared library. A plugin library has to provide the C function
+
+        void fles_register_timeslice_sinks(TimesliceSinkRegistry& registry);
+
+    which is called once after loading the library. */
+
+class TimesliceSinkRegistry {
+public:
+  static TimesliceSinkRegistry& get() {
+    static TimesliceSinkRegistry instance;
+    return instance;
+  }
+
+  TimesliceSinkRegistry(const TimesliceSinkRegistry&) = delete;
+  void operator=(const TimesliceSinkRegistry&) = delete;
+
+  /// Register a timeslice sink factory under a given name.
+  void add(const std::string& name, TimesliceSinkFactory factory) {
+    factories_[name] = std::move(factory);
+  }
+
+  bool contains(const std::string& name) const {
+    return factories_.count(name) != 0u;
+  }
+
+  /// Create a timeslice sink from a specification "name[:args]".
+  std::unique_ptr<fles::TimesliceSink> create(const std::string& spec,
+                                              uint32_t worker_index,
+                                              std::ostream& out) const;
+
+  /// Load a plugin library and register the sinks it provides.
+  void load_library(const std::string& path);
+
+  std::vector<std::string> names() const;
+
+private:
+  TimesliceSinkRegistry();
+
+  std::map<std::string, TimesliceSinkFactory> factories_;
+
+  /// Handles of loaded plugin libraries (never unloaded).
+  std::vector<void*> libraries_;
+};
+
+/// Helper for the static registration of a timeslice sink factory.
+struct TimesliceSinkRegistration {
+  TimesliceSinkRegistration(const std::string& name,
+                            TimesliceSinkFactory factory) {
+    TimesliceSinkRegistry::get().add(name, std::move(factory));
+  }
+};
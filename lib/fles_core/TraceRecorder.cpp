@@ -0,0 +1,95 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TraceRecorder.hpp"
+#include "log.hpp"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+const char trace_file_magic[8] = {'F', 'L', 'E', 'S', 'T', 'R', 'C', '1'};
+} // namespace
+
+const char* trace_stage_name(TraceStage stage) {
+  switch (stage) {
+  case TraceStage::InputWritten:
+    return "input_written";
+  case TraceStage::SendPosted:
+    return "send_posted";
+  case TraceStage::SendCompleted:
+    return "send_completed";
+  case TraceStage::BuilderComplete:
+    return "builder_complete";
+  case TraceStage::WorkItemQueued:
+    return "work_item_queued";
+  case TraceStage::ConsumerReceived:
+    return "consumer_received";
+  case TraceStage::CompletionReturned:
+    return "completion_returned";
+  }
+  return "unknown";
+}
+
+TraceRecorder::TraceRecorder(std::string filename,
+                             uint64_t sampling,
+                             size_t capacity)
+    : filename_(std::move(filename)), sampling_(sampling == 0 ? 1 : sampling),
+      records_(capacity) {
+  std::ofstream out(filename_, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("cannot create trace file " + filename_);
+  }
+  out.write(trace_file_magic, sizeof(trace_file_magic));
+}
+
+TraceRecorder::~TraceRecorder() {
+  try {
+    flush();
+  } catch (std::exception& e) {
+    L_(error) << "exception in ~TraceRecorder: " << e.what();
+  }
+  L_(info) << "trace " << filename_ << ": " << written_ << " records"
+           << (dropped_ != 0 ? ", " + std::to_string(dropped_) + " dropped"
+                             : std::string());
+}
+
+void TraceRecorder::flush() {
+  if (dropped_ != reported_dropped_) {
+    L_(warning) << "trace " << filename_ << ": "
+                << dropped_ - reported_dropped_
+                << " records dropped, buffer full";
+    reported_dropped_ = dropped_;
+  }
+  if (size_ == 0) {
+    return;
+  }
+  std::ofstream out(filename_, std::ios::binary | std::ios::app);
+  out.write(reinterpret_cast<const char*>(records_.data()),
+            static_cast<std::streamsize>(size_ * sizeof(TraceRecord)));
+  if (!out) {
+    throw std::runtime_error("cannot write trace file " + filename_);
+  }
+  written_ += size_;
+  size_ = 0;
+}
+
+std::string TraceRecorder::filename(const std::string& prefix,
+                                    const std::string& component) {
+  return prefix + "." + component + ".trace";
+}
+
+std::vector<TraceRecord> TraceRecorder::read(const std::string& filename) {
+  std::ifstream in(filename, std::ios::binary);
+  char magic[sizeof(trace_file_magic)];
+  if (!in.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, trace_file_magic, sizeof(magic)) != 0) {
+    throw std::runtime_error("not a trace file: " + filename);
+  }
+  std::vector<TraceRecord> records;
+  TraceRecord r;
+  while (in.read(reinterpret_cast<char*>(&r), sizeof(r))) {
+    records.push_back(r);
+  }
+  return records;
+}
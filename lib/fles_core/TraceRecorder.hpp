@@ -0,0 +1,107 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Trace points along the path of a timeslice.
+enum class TraceStage : uint32_t {
+  InputWritten,      ///< Timeslice component available in input buffer
+  SendPosted,        ///< Transfer of component to compute node initiated
+  SendCompleted,     ///< Transfer of component completed at input
+  BuilderComplete,   ///< All components received at compute node
+  WorkItemQueued,    ///< Work item placed into the timeslice buffer queue
+  ConsumerReceived,  ///< Work item received by a consumer
+  CompletionReturned ///< Completion received back from the consumer
+};
+
+constexpr size_t num_trace_stages = 7;
+
+/// Retrieve the name of a trace stage.
+const char* trace_stage_name(TraceStage stage);
+
+/// Trace record, as stored in trace files.
+struct TraceRecord {
+  uint64_t timeslice; ///< Global timeslice index
+  int64_t time;       ///< System clock time (ns since epoch)
+  uint32_t stage;     ///< Trace stage (see TraceStage)
+  uint32_t component; ///< Input, compute node or consumer index
+};
+
+/// Timeslice trace recorder class.
+/** A TraceRecorder stores the trace points of a single thread in a
+    preallocated buffer, so recording neither locks nor allocates. Only
+    timeslices with an index divisible by the sampling factor are traced;
+    as the factor is the same in all processes, the same timeslices are
+    traced along the whole path. Records beyond the capacity are dropped
+    and counted.
+
+    The owner writes the records to the trace file by calling flush() on
+    the recording thread, e.g., from its periodic status timer; a warning
+    reports records dropped since the last flush. Pending records are also
+    written on destruction. Trace files can be analyzed with the tstrace
+    tool. The timestamps are taken from the
+    system clock, so records from several nodes can only be compared if
+    their clocks are synchronized (e.g., using PTP). */
+
+class TraceRecorder {
+public:
+  static constexpr size_t default_capacity = size_t(1) << 20;
+
+  TraceRecorder(std::string filename,
+                uint64_t sampling = 1,
+                size_t capacity = default_capacity);
+
+  TraceRecorder(const TraceRecorder&) = delete;
+  void operator=(const TraceRecorder&) = delete;
+
+  /// The TraceRecorder destructor, writes the trace file.
+  ~TraceRecorder();
+
+  /// Check if a given timeslice is traced.
+  bool enabled(uint64_t timeslice) const {
+    return timeslice % sampling_ == 0;
+  }
+
+  /// Record a trace point for a given timeslice.
+  void record(uint64_t timeslice, TraceStage stage, uint32_t component) {
+    if (!enabled(timeslice)) {
+      return;
+    }
+    if (size_ == records_.size()) {
+      ++dropped_;
+      return;
+    }
+    records_[size_++] = {
+        timeslice,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count(),
+        static_cast<uint32_t>(stage), component};
+  }
+
+  /// Write all pending records to the trace file.
+  void flush();
+
+  /// Check if the buffer is at least half full and should be flushed.
+  bool should_flush() const { return size_ >= records_.size() / 2; }
+
+  /// Construct the file name for a given prefix and component.
+  static std::string filename(const std::string& prefix,
+                              const std::string& component);
+
+  /// Read all records from a trace file.
+  static std::vector<TraceRecord> read(const std::string& filename);
+
+private:
+  std::string filename_;
+  uint64_t sampling_;
+  std::vector<TraceRecord> records_;
+  size_t size_ = 0;
+  uint64_t written_ = 0;
+  uint64_t dropped_ = 0;
+  uint64_t reported_dropped_ = 0;
+};
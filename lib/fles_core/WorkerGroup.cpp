@@ -0,0 +1,45 @@
+// Copyright 2026 agent <agent@local>
+
+#include "WorkerGroup.hpp"
+#include <exception>
+
+void WorkerGroup::operator()() {
+  if (cpu_ >= 0) {
+    set_cpu(cpu_);
+  }
+
+  std::vector<ConnectionGroupWorker*> active;
+  for (auto* worker : workers_) {
+    try {
+      worker->start();
+      active.push_back(worker);
+    } catch (std::exception& e) {
+      L_(error) << "exception in worker group: " << e.what();
+    }
+  }
+
+  std::vector<ConnectionGroupWorker*> done;
+  while (!active.empty()) {
+    auto it = active.begin();
+    while (it != active.end()) {
+      bool running = false;
+      try {
+        running = (*it)->step();
+        if (!running) {
+          done.push_back(*it);
+        }
+      } catch (std::exception& e) {
+        L_(error) << "exception in worker group: " << e.what();
+      }
+      it = running ? it + 1 : active.erase(it);
+    }
+  }
+
+  for (auto* worker : done) {
+    try {
+      worker->stop();
+    } catch (std::exception& e) {
+      L_(error) << "exception in worker group: " << e.what();
+    }
+  }
+}
@@ -0,0 +1,40 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "ConnectionGroupWorker.hpp"
+#include <vector>
+
+/// Worker group class.
+/** A WorkerGroup drives several ConnectionGroupWorker objects (typically
+    input channel senders) from a single thread. The workers are started
+    one after the other, then their main loops are interleaved by calling
+    step() on each unfinished worker in turn, so that a single polling
+    thread serves the completion queues of all workers in the group.
+
+    A worker that throws an exception is logged and dropped from the
+    group, just as a worker in its own thread would terminate. */
+
+class WorkerGroup : public ConnectionGroupWorker {
+public:
+  /// The WorkerGroup constructor, optionally pinning the thread to a CPU.
+  explicit WorkerGroup(int cpu = -1) : cpu_(cpu) {}
+
+  WorkerGroup(const WorkerGroup&) = delete;
+  void operator=(const WorkerGroup&) = delete;
+
+  /// Add a worker to the group. The worker is not owned by the group.
+  void add(ConnectionGroupWorker& worker) { workers_.push_back(&worker); }
+
+  /// Retrieve the number of workers in the group.
+  size_t size() const { return workers_.size(); }
+
+  /// The thread main function.
+  void operator()() override;
+
+private:
+  /// The CPU to pin the thread to (-1 for no pinning).
+  int cpu_;
+
+  /// The workers driven by this group.
+  std::vector<ConnectionGroupWorker*> workers_;
+};
@@ -0,0 +1,222 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::WorkerPoolSink parallel stream stage.
+#pragma once
+
+#include "BoundedQueue.hpp"
+#include "Sink.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fles {
+
+/**
+ * \brief The WorkerPoolSink class processes items in parallel.
+ *
+ * Items passed to a WorkerPoolSink are dispatched to a pool of worker
+ * threads, each of which passes them to its own sink instance (created by
+ * a factory for the given worker index). As the workers finish in any
+ * order, an optional downstream sink is fed through a reorder buffer, so
+ * that it receives the items in their original order. The number of items
+ * in flight (queued, being processed or waiting for reordering) is limited
+ * by the reorder window; put() waits when the window is full, e.g. when a
+ * single item takes very long.
+ *
+ * An exception thrown by a sink stops further processing; all remaining
+ * items are released, and the exception is rethrown by the next call to
+ * put() or close().
+ */
+template <class T> class WorkerPoolSink : public Sink<T> {
+public:
+  using sink_t = Sink<T>;
+  using factory_t = std::function<std::unique_ptr<sink_t>(uint32_t)>;
+
+  /// Construct a WorkerPoolSink with a given number of workers.
+  WorkerPoolSink(uint32_t num_workers,
+                 const factory_t& factory,
+                 size_t reorder_window)
+      : queue_(std::max<size_t>(num_workers, 1)),
+        reorder_window_(std::max<size_t>(reorder_window, num_workers)) {
+    for (uint32_t i = 0; i < std::max<uint32_t>(num_workers, 1); ++i) {
+      workers_.push_back(factory(i));
+    }
+    for (auto& worker : workers_) {
+      sink_t* sink = worker.get();
+      threads_.emplace_back([this, sink] { run(*sink); });
+    }
+  }
+
+  WorkerPoolSink(const WorkerPoolSink&) = delete;
+  void operator=(const WorkerPoolSink&) = delete;
+
+  ~WorkerPoolSink() override { join(); }
+
+  /// Set the downstream sink, which receives all items in order after they
+  /// have been processed. Must be called before the first put().
+  void set_ordered_sink(std::unique_ptr<sink_t> sink) {
+    ordered_sink_ = std::move(sink);
+  }
+
+  void put(std::shared_ptr<const T> item) override {
+    rethrow_error();
+    uint64_t sequence;
+    {
+      // wait until the item fits into the reorder window
+      std::unique_lock<std::mutex> lock(mutex_);
+      window_cv_.wait(lock, [this] {
+        return next_sequence_ - next_emit_ < reorder_window_ || failed_;
+      });
+      sequence = next_sequence_++;
+    }
+    queue_.push(std::make_pair(sequence, std::move(item)));
+  }
+
+  /// Close the stage and signal the end of the stream to all sinks.
+  void end_stream() override {
+    end_stream_ = true;
+    close();
+  }
+
+  /// Wait until all items are processed and stop the worker threads.
+  /// Rethrows the first exception thrown by a sink.
+  void close() {
+    join();
+    if (end_stream_ && ordered_sink_ && !failed_) {
+      ordered_sink_->end_stream();
+    }
+    rethrow_error();
+  }
+
+  /// Retrieve the number of workers.
+  size_t size() const { return workers_.size(); }
+
+  /// Retrieve the maximum number of items waiting for reordering.
+  size_t max_reorder_depth() const { return max_reorder_depth_; }
+
+private:
+  using entry_t = std::pair<uint64_t, std::shared_ptr<const T>>;
+
+  /// The worker thread main function.
+  void run(sink_t& sink) {
+    entry_t entry;
+    while (queue_.pop(entry)) {
+      if (!failed_) {
+        try {
+          sink.put(entry.second);
+        } catch (...) {
+          fail(std::current_exception());
+        }
+      }
+      complete(entry.first, std::move(entry.second));
+    }
+    if (end_stream_ && !failed_) {
+      try {
+        sink.end_stream();
+      } catch (...) {
+        fail(std::current_exception());
+      }
+    }
+  }
+
+  /// Pass a processed item on in order. The worker finding the next item
+  /// in sequence emits all consecutive items that are ready, the others
+  /// just leave their item in the reorder buffer.
+  void complete(uint64_t sequence, std::shared_ptr<const T> item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    reorder_buffer_.emplace(sequence, ordered_sink_ ? std::move(item)
+                                                    : nullptr);
+    max_reorder_depth_ = std::max(max_reorder_depth_, reorder_buffer_.size());
+    if (emitting_) {
+      return;
+    }
+    emitting_ = true;
+    while (!reorder_buffer_.empty() &&
+           reorder_buffer_.begin()->first == next_emit_) {
+      std::shared_ptr<const T> ready =
+          std::move(reorder_buffer_.begin()->second);
+      reorder_buffer_.erase(reorder_buffer_.begin());
+      if (ready && !failed_) {
+        lock.unlock();
+        try {
+          ordered_sink_->put(std::move(ready));
+        } catch (...) {
+          fail(std::current_exception());
+        }
+        ready.reset();
+        lock.lock();
+      }
+      ++next_emit_;
+      window_cv_.notify_all();
+    }
+    emitting_ = false;
+  }
+
+  void fail(std::exception_ptr error) {
+    {
+      std::lock_guard<std::mutex> lock(error_mutex_);
+      if (!error_) {
+        error_ = error;
+      }
+      failed_ = true;
+    }
+    // wake up a producer waiting for the reorder window
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    window_cv_.notify_all();
+  }
+
+  void rethrow_error() {
+    if (failed_) {
+      std::lock_guard<std::mutex> lock(error_mutex_);
+      std::rethrow_exception(error_);
+    }
+  }
+
+  void join() {
+    queue_.close();
+    for (auto& thread : threads_) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<sink_t>> workers_;
+  std::unique_ptr<sink_t> ordered_sink_;
+
+  BoundedQueue<entry_t> queue_;
+  std::vector<std::thread> threads_;
+
+  /// Sequence number of the next item passed to put().
+  uint64_t next_sequence_ = 0;
+
+  /// Sequence number of the next item to pass to the ordered sink.
+  uint64_t next_emit_ = 0;
+
+  size_t reorder_window_;
+  std::map<uint64_t, std::shared_ptr<const T>> reorder_buffer_;
+  size_t max_reorder_depth_ = 0;
+  bool emitting_ = false;
+
+  std::mutex mutex_;
+  std::condition_variable window_cv_;
+
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+  std::atomic<bool> failed_{false};
+  std::atomic<bool> end_stream_{false};
+};
+
+class Timeslice;
+using TimesliceWorkerPool = WorkerPoolSink<Timeslice>;
+
+} // namespace fles
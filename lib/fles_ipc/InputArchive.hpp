@@ -9,6 +9,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace fles {
 
@@ -79,6 +80,21 @@ private:
     return sts;
   }
 
+  // read the items without a virtual call each
+  std::size_t do_get_batch(std::vector<std::unique_ptr<Base>>& items,
+                           std::size_t max_items) override {
+    std::size_t n = 0;
+    while (n < max_items) {
+      Derived* sts = InputArchive::do_get();
+      if (sts == nullptr) {
+        break;
+      }
+      items.emplace_back(sts);
+      ++n;
+    }
+    return n;
+  }
+
   std::unique_ptr<std::ifstream> ifstream_;
   std::unique_ptr<boost::archive::binary_iarchive> iarchive_;
   ArchiveDescriptor descriptor_;
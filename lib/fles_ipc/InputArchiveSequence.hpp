@@ -12,6 +12,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace fles {
 
@@ -147,6 +148,21 @@ private:
     }
     return sts;
   }
+
+  // read the items without a virtual call each
+  std::size_t do_get_batch(std::vector<std::unique_ptr<Base>>& items,
+                           std::size_t max_items) override {
+    std::size_t n = 0;
+    while (n < max_items) {
+      Derived* sts = InputArchiveSequence::do_get();
+      if (sts == nullptr) {
+        break;
+      }
+      items.emplace_back(sts);
+      ++n;
+    }
+    return n;
+  }
 };
 
 } // namespace fles
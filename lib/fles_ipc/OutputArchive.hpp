@@ -8,6 +8,7 @@
 #include <boost/archive/binary_oarchive.hpp>
 #include <fstream>
 #include <string>
+#include <vector>
 
 namespace fles {
 
@@ -38,6 +39,14 @@ public:
   /// Store an item.
   void put(std::shared_ptr<const Base> item) override { do_put(*item); }
 
+  /// Store a batch of items.
+  void put_batch(
+      const std::vector<std::shared_ptr<const Base>>& items) override {
+    for (const auto& item : items) {
+      do_put(*item);
+    }
+  }
+
   void end_stream() override { ofstream_.close(); }
 
 private:
@@ -13,6 +13,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace fles {
 
@@ -63,6 +64,14 @@ public:
   /// Store an item.
   void put(std::shared_ptr<const Base> item) override { do_put(*item); }
 
+  /// Store a batch of items.
+  void put_batch(
+      const std::vector<std::shared_ptr<const Base>>& items) override {
+    for (const auto& item : items) {
+      do_put(*item);
+    }
+  }
+
   void end_stream() override {
     oarchive_ = nullptr;
     ofstream_ = nullptr;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 namespace fles {
 
@@ -18,6 +19,13 @@ public:
   /// Receive an item to sink.
   virtual void put(std::shared_ptr<const T> item) = 0;
 
+  /// Receive a batch of items to sink (default: one by one).
+  virtual void put_batch(const std::vector<std::shared_ptr<const T>>& items) {
+    for (const auto& item : items) {
+      put(item);
+    }
+  }
+
   virtual void end_stream(){};
 
   virtual ~Sink() = default;
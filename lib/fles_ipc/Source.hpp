@@ -3,7 +3,9 @@
 /// \brief Defines the fles::Source template class.
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 namespace fles {
 
@@ -24,12 +26,45 @@ public:
    */
   std::unique_ptr<T> get() { return std::unique_ptr<T>(do_get()); };
 
+  /**
+   * \brief Retrieve up to max_items items and append them to a vector.
+   *
+   * This function blocks until at least one item is available. It may return
+   * fewer than max_items items before the end of the stream.
+   *
+   * \return number of items appended, or 0 if end-of-file
+   */
+  std::size_t get_batch(std::vector<std::unique_ptr<T>>& items,
+                        std::size_t max_items) {
+    return do_get_batch(items, max_items);
+  }
+
   virtual bool eos() const = 0;
 
   virtual ~Source() = default;
 
 private:
   virtual T* do_get() = 0;
+
+  /**
+   * \brief Default batch adapter retrieving a single item.
+   *
+   * The base class cannot tell if a further item is available without
+   * blocking, so it returns after the first one. Sources that can tell
+   * (e.g., archives or buffered sources) override it to return more items.
+   */
+  virtual std::size_t do_get_batch(std::vector<std::unique_ptr<T>>& items,
+                                   std::size_t max_items) {
+    if (max_items == 0) {
+      return 0;
+    }
+    T* item = do_get();
+    if (item == nullptr) {
+      return 0;
+    }
+    items.emplace_back(item);
+    return 1;
+  }
 };
 
 } // namespace fles
@@ -15,12 +15,15 @@ namespace fles {
  */
 struct TimesliceCompletion {
   uint64_t ts_pos; ///< Start offset (in items) of this timeslice
+  /// Index of the consumer that processed this timeslice (or UINT32_MAX)
+  uint32_t consumer_index;
 
   friend class boost::serialization::access;
   /// Provide boost serialization access.
   template <class Archive>
   void serialize(Archive& ar, const unsigned int /* version */) {
     ar& ts_pos;
+    ar& consumer_index;
   }
 };
 
@@ -1,13 +1,14 @@
 // Copyright 2013 Jan de Cuveland <cmail@cuveland.de>
 
 #include "TimesliceReceiver.hpp"
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/version.hpp>
 #include <memory>
 
 namespace fles {
 
 TimesliceReceiver::TimesliceReceiver(
-    const std::string& shared_memory_identifier)
+    const std::string& shared_memory_identifier, int32_t consumer_index)
     : shared_memory_identifier_(shared_memory_identifier) {
   data_shm_ = std::unique_ptr<boost::interprocess::shared_memory_object>(
       new boost::interprocess::shared_memory_object(
@@ -37,6 +38,27 @@ TimesliceReceiver::TimesliceReceiver(
   completions_mq_ = std::make_shared<boost::interprocess::message_queue>(
       boost::interprocess::open_only,
       (shared_memory_identifier + "completions_").c_str());
+
+  // open all per-consumer queues to be able to steal work from other
+  // consumers; a receiver without a consumer index takes all its work from
+  // there once the buffer dispatches to the per-consumer queues
+  try {
+    for (uint32_t i = 0;; ++i) {
+      consumer_mqs_.push_back(
+          std::unique_ptr<boost::interprocess::message_queue>(
+              new boost::interprocess::message_queue(
+                  boost::interprocess::open_only,
+                  (shared_memory_identifier + "work_items_" +
+                   std::to_string(i) + "_")
+                      .c_str())));
+    }
+  } catch (boost::interprocess::interprocess_exception&) {
+    // no (further) per-consumer queue available
+  }
+
+  if (!consumer_mqs_.empty() && consumer_index >= 0) {
+    consumer_index_ = static_cast<uint32_t>(consumer_index);
+  }
 }
 
 #if BOOST_VERSION < 105600
@@ -74,6 +96,57 @@ void mq_receive_workaround(boost::interprocess::message_queue& mq,
 }
 #endif
 
+bool TimesliceReceiver::try_receive_any(
+    TimesliceWorkItem& wi,
+    std::size_t& recvd_size,
+    boost::interprocess::message_queue*& mq) {
+  unsigned int priority;
+  auto num_consumers = static_cast<uint32_t>(consumer_mqs_.size());
+
+  // own queue first, then the shared queue, then steal from other consumers
+  if (consumer_index_ < num_consumers) {
+    mq = consumer_mqs_[consumer_index_].get();
+    if (mq->try_receive(&wi, sizeof(wi), recvd_size, priority)) {
+      return true;
+    }
+  }
+  mq = work_items_mq_.get();
+  if (mq->try_receive(&wi, sizeof(wi), recvd_size, priority)) {
+    return true;
+  }
+  uint32_t first = (consumer_index_ < num_consumers) ? consumer_index_ + 1 : 0;
+  for (uint32_t n = 0; n < num_consumers; ++n) {
+    uint32_t i = (first + n) % num_consumers;
+    if (i == consumer_index_) {
+      continue;
+    }
+    mq = consumer_mqs_[i].get();
+    if (mq->try_receive(&wi, sizeof(wi), recvd_size, priority)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+TimesliceView*
+TimesliceReceiver::handle_work_item(const TimesliceWorkItem& wi,
+                                    std::size_t recvd_size,
+                                    boost::interprocess::message_queue& mq) {
+  if (recvd_size == 0) {
+    eos_ = true;
+    // put end work item back for other consumers
+    mq.send(nullptr, 0, 0);
+    return nullptr;
+  }
+  assert(recvd_size == sizeof(wi));
+
+  return new TimesliceView(
+      wi, reinterpret_cast<uint8_t*>(data_region_->get_address()),
+      reinterpret_cast<TimesliceComponentDescriptor*>(
+          desc_region_->get_address()),
+      completions_mq_, consumer_index_);
+}
+
 TimesliceView* TimesliceReceiver::do_get() {
   if (eos_) {
     return nullptr;
@@ -83,24 +156,31 @@ TimesliceView* TimesliceReceiver::do_get() {
   std::size_t recvd_size;
   unsigned int priority;
 
+  if (!consumer_mqs_.empty()) {
+    boost::interprocess::message_queue* mq = nullptr;
+    while (!try_receive_any(wi, recvd_size, mq)) {
+      // wait for work on the own queue, but keep looking for work elsewhere
+      mq = work_items_mq_.get();
+      if (consumer_index_ < consumer_mqs_.size()) {
+        mq = consumer_mqs_[consumer_index_].get();
+      }
+      boost::posix_time::ptime abs_time =
+          boost::posix_time::microsec_clock::universal_time() +
+          boost::posix_time::milliseconds(1);
+      if (mq->timed_receive(&wi, sizeof(wi), recvd_size, priority,
+                            abs_time)) {
+        break;
+      }
+    }
+    return handle_work_item(wi, recvd_size, *mq);
+  }
+
 #if BOOST_VERSION >= 105600
   work_items_mq_->receive(&wi, sizeof(wi), recvd_size, priority);
 #else
   mq_receive_workaround(*work_items_mq_, &wi, sizeof(wi), recvd_size, priority);
 #endif
-  if (recvd_size == 0) {
-    eos_ = true;
-    // put end work item back for other consumers
-    work_items_mq_->send(nullptr, 0, 0);
-    return nullptr;
-  }
-  assert(recvd_size == sizeof(wi));
-
-  return new TimesliceView(
-      wi, reinterpret_cast<uint8_t*>(data_region_->get_address()),
-      reinterpret_cast<TimesliceComponentDescriptor*>(
-          desc_region_->get_address()),
-      completions_mq_);
+  return handle_work_item(wi, recvd_size, *work_items_mq_);
 }
 
 } // namespace fles
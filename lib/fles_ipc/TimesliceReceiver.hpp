@@ -10,6 +10,7 @@
 #include <boost/interprocess/shared_memory_object.hpp>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace fles {
 
@@ -19,8 +20,18 @@ namespace fles {
  */
 class TimesliceReceiver : public TimesliceSource {
 public:
-  /// Construct timeslice receiver connected to a given shared memory.
-  explicit TimesliceReceiver(const std::string& shared_memory_identifier);
+  /**
+   * \brief Construct timeslice receiver connected to a given shared memory.
+   *
+   * If a consumer index is given and the timeslice buffer provides
+   * per-consumer work item queues, work items are preferably taken from the
+   * queue of this consumer. When idle, work is taken from the shared queue or
+   * stolen from the queues of other consumers. A receiver without a consumer
+   * index takes its work from the shared queue and from all per-consumer
+   * queues.
+   */
+  explicit TimesliceReceiver(const std::string& shared_memory_identifier,
+                             int32_t consumer_index = -1);
 
   /// Delete copy constructor (non-copyable).
   TimesliceReceiver(const TimesliceReceiver&) = delete;
@@ -45,6 +56,15 @@ public:
 private:
   TimesliceView* do_get() override;
 
+  /// Try to receive a work item from the per-consumer queues.
+  bool try_receive_any(TimesliceWorkItem& wi, std::size_t& recvd_size,
+                       boost::interprocess::message_queue*& mq);
+
+  /// Create a timeslice view or handle the end-of-stream marker.
+  TimesliceView* handle_work_item(const TimesliceWorkItem& wi,
+                                  std::size_t recvd_size,
+                                  boost::interprocess::message_queue& mq);
+
   const std::string shared_memory_identifier_;
 
   std::unique_ptr<boost::interprocess::shared_memory_object> data_shm_;
@@ -56,6 +76,13 @@ private:
   std::unique_ptr<boost::interprocess::message_queue> work_items_mq_;
   std::shared_ptr<boost::interprocess::message_queue> completions_mq_;
 
+  /// The per-consumer work item queues (if provided by the buffer).
+  std::vector<std::unique_ptr<boost::interprocess::message_queue>>
+      consumer_mqs_;
+
+  /// The index of this consumer (or UINT32_MAX if not applicable).
+  uint32_t consumer_index_ = UINT32_MAX;
+
   /// The end-of-stream flag.
   bool eos_ = false;
 };
@@ -9,10 +9,11 @@ TimesliceView::TimesliceView(
     TimesliceWorkItem work_item,
     uint8_t* data,
     TimesliceComponentDescriptor* desc,
-    std::shared_ptr<boost::interprocess::message_queue> completions_mq)
+    std::shared_ptr<boost::interprocess::message_queue> completions_mq,
+    uint32_t consumer_index)
     : completions_mq_(std::move(completions_mq)) {
   timeslice_descriptor_ = work_item.ts_desc;
-  completion_ = {timeslice_descriptor_.ts_pos};
+  completion_ = {timeslice_descriptor_.ts_pos, consumer_index};
 
   // initialize access pointer vectors
   data_ptr_.resize(num_components());
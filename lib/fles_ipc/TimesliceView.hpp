@@ -33,7 +33,8 @@ private:
       TimesliceWorkItem work_item,
       uint8_t* data,
       TimesliceComponentDescriptor* desc,
-      std::shared_ptr<boost::interprocess::message_queue> completions_mq);
+      std::shared_ptr<boost::interprocess::message_queue> completions_mq,
+      uint32_t consumer_index = UINT32_MAX);
 
   TimesliceCompletion completion_ = TimesliceCompletion();
 
@@ -70,6 +70,11 @@ public:
 
   void inc_ack_pointers(uint64_t ack_pos);
 
+  /// Set the schedule announcement sent with the next status message.
+  void set_schedule(const ScheduleAnnouncement& schedule) {
+    schedule_ = schedule;
+  }
+
   void on_complete_recv();
 
   void on_complete_send();
@@ -141,6 +146,7 @@ public:
 private:
   ComputeNodeStatusMessage send_status_message_ = ComputeNodeStatusMessage();
   ComputeNodeBufferPosition cn_ack_ = ComputeNodeBufferPosition();
+  ScheduleAnnouncement schedule_ = ScheduleAnnouncement();
 
   InputChannelStatusMessage recv_status_message_ = InputChannelStatusMessage();
   ComputeNodeBufferPosition cn_wp_ = ComputeNodeBufferPosition();
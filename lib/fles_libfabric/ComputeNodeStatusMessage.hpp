@@ -4,6 +4,7 @@
 #pragma once
 
 #include "ComputeNodeBufferPosition.hpp"
+#include "ScheduleAnnouncement.hpp"
 #include "ComputeNodeInfo.hpp"
 
 #pragma pack(1)
@@ -15,6 +16,7 @@ struct ComputeNodeStatusMessage {
   ComputeNodeBufferPosition ack;
   bool request_abort;
   bool final;
+  ScheduleAnnouncement schedule;
   //
   bool connect;
   ComputeNodeInfo info;
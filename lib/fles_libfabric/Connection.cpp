@@ -51,13 +51,15 @@ void Connection::connect(const std::string& hostname,
                          const std::string& service,
                          struct fid_domain* domain,
                          struct fid_cq* cq,
-                         struct fid_av* av) {
+                         struct fid_av* av,
+                         struct fi_info* source_info) {
   auto private_data = get_private_data();
   assert(private_data->size() <= 255);
 
   L_(debug) << "connect: " << hostname << ":" << service;
   struct fi_info* info2 = nullptr;
-  struct fi_info* hints = fi_dupinfo(Provider::getInst()->get_info());
+  struct fi_info* hints = fi_dupinfo(
+      source_info != nullptr ? source_info : Provider::getInst()->get_info());
 
   hints->rx_attr->size = max_recv_wr_;
   hints->rx_attr->iov_limit = max_recv_sge_;
@@ -66,8 +68,11 @@ void Connection::connect(const std::string& hostname,
   hints->tx_attr->iov_limit = max_send_sge_;
   hints->tx_attr->inject_size = max_inline_data_;
 
-  hints->src_addr = nullptr;
-  hints->src_addrlen = 0;
+  // keep the source address of a rail to select the local device
+  if (source_info == nullptr) {
+    hints->src_addr = nullptr;
+    hints->src_addrlen = 0;
+  }
 
   int err = fi_getinfo(
       FI_VERSION(1, 1), hostname.empty() ? nullptr : hostname.c_str(),
@@ -85,6 +90,7 @@ void Connection::connect(const std::string& hostname,
     L_(fatal) << "fi_endpoint failed: " << err << "=" << fi_strerror(-err);
     throw LibfabricException("fi_endpoint failed");
   }
+  domain_ = domain;
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
@@ -171,6 +177,7 @@ void Connection::on_connect_request(struct fi_eq_cm_entry* event,
     L_(fatal) << "fi_endpoint failed: " << err << "=" << fi_strerror(-err);
     throw LibfabricException("fi_endpoint failed");
   }
+  domain_ = pd;
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
@@ -243,6 +250,7 @@ void Connection::make_endpoint(struct fi_info* info,
     L_(fatal) << "fi_endpoint failed: " << err << "=" << fi_strerror(-err);
     throw LibfabricException("fi_endpoint failed");
   }
+  domain_ = pd;
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
@@ -39,14 +39,17 @@ public:
   //
   /// Initiate a connection request to target hostname and service.
   /**
-     \param hostname The target hostname
-     \param service  The target service or port number
+     \param hostname    The target hostname
+     \param service     The target service or port number
+     \param source_info Provider information of the local rail to connect
+                        from, default if null
   */
   void connect(const std::string& hostname,
                const std::string& service,
                struct fid_domain* domain,
                struct fid_cq* cq,
-               struct fid_av* av);
+               struct fid_av* av,
+               struct fi_info* source_info = nullptr);
 
   void disconnect();
 
@@ -90,6 +93,11 @@ public:
 
   bool done() const { return done_; }
 
+  /// Retrieve the domain of the connection endpoint.
+  struct fid_domain* domain() const {
+    return domain_;
+  }
+
   /// Retrieve the total number of bytes transmitted.
   uint64_t total_bytes_sent() const { return total_bytes_sent_; }
 
@@ -139,6 +147,9 @@ protected:
 
   struct fid_ep* ep_ = nullptr;
 
+  /// Domain of the endpoint.
+  struct fid_domain* domain_ = nullptr;
+
   bool connection_oriented_ = false;
 
 private:
@@ -25,7 +25,8 @@
 namespace tl_libfabric {
 /// Libfabric connection group base class.
 /** An ConnectionGroup object represents a group of Libfabric
- connections that use the same completion queue. */
+ connections that use the same completion queue (per local network
+ rail). */
 
 template <typename CONNECTION>
 class ConnectionGroup : public ConnectionGroupWorker {
@@ -57,6 +58,12 @@ public:
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
+    for (auto& rail : rail_contexts_) {
+      fi_close((fid_t)rail.cq);
+      fi_close((fid_t)rail.pd);
+      fi_freeinfo(rail.info);
+    }
+    rail_contexts_.clear();
     fi_close((fid_t)eq_);
     if (pep_ != nullptr) {
       fi_close((fid_t)pep_);
@@ -128,6 +135,18 @@ public:
 
   /// The Libfabric completion notification handler.
   int poll_completion() {
+    int ne_total = 0;
+    if (cq_ != nullptr) {
+      ne_total += poll_completion(cq_);
+    }
+    for (auto& rail : rail_contexts_) {
+      ne_total += poll_completion(rail.cq);
+    }
+    return ne_total;
+  }
+
+  /// Handle the completion notifications of a single completion queue.
+  int poll_completion(struct fid_cq* cq) {
     const int ne_max = 10;
 
     struct fi_cq_entry wc[ne_max];
@@ -135,13 +154,13 @@ public:
     int ne_total = 0;
 
     while (ne_total < int(conn_.size()) &&
-           (ne = fi_cq_read(cq_, &wc, ne_max))) {
+           (ne = fi_cq_read(cq, &wc, ne_max))) {
       if (ne == -FI_EAVAIL) { // error available
         struct fi_cq_err_entry err;
         char buffer[256];
-        ne = fi_cq_readerr(cq_, &err, 0);
+        ne = fi_cq_readerr(cq, &err, 0);
         L_(fatal) << fi_strerror(err.err);
-        L_(fatal) << fi_cq_strerror(cq_, err.prov_errno, err.err_data, buffer,
+        L_(fatal) << fi_cq_strerror(cq, err.prov_errno, err.err_data, buffer,
                                     256);
         throw LibfabricException("fi_cq_read failed (fi_cq_readerr)");
       }
@@ -210,7 +229,7 @@ protected:
 
     conn->on_established(event);
     ++connected_;
-    on_connected(pd_);
+    on_connected(conn->domain());
   }
 
   /// Handle RDMA_CM_EVENT_CONNECT_REQUEST event.
@@ -247,20 +266,7 @@ protected:
       throw LibfabricException("fi_domain failed");
     }
 
-    struct fi_cq_attr cq_attr;
-    memset(&cq_attr, 0, sizeof(cq_attr));
-    cq_attr.size = num_cqe_;
-    cq_attr.flags = 0;
-    cq_attr.format = FI_CQ_FORMAT_CONTEXT;
-    cq_attr.wait_obj = FI_WAIT_NONE;
-    cq_attr.signaling_vector = Provider::vector++; // ??
-    cq_attr.wait_cond = FI_CQ_COND_NONE;
-    cq_attr.wait_set = nullptr;
-    res = fi_cq_open(pd_, &cq_attr, &cq_, nullptr);
-    if (cq_ == nullptr) {
-      L_(fatal) << "fi_cq_open failed: " << -res << "=" << fi_strerror(-res);
-      throw LibfabricException("fi_cq_open failed");
-    }
+    cq_ = open_cq(pd_);
 
     if (Provider::getInst()->has_av()) {
       struct fi_av_attr av_attr;
@@ -281,6 +287,48 @@ protected:
     }
   }
 
+  /// Open a domain and completion queue for a local network rail address.
+  /// Returns the index of the rail context.
+  size_t init_rail_context(const std::string& address) {
+    L_(debug) << "create Libfabric objects for rail " << address;
+
+    struct fi_info* info = nullptr;
+    int res = fi_getinfo(FI_VERSION(1, 1), address.c_str(), nullptr, FI_SOURCE,
+                         Provider::getInst()->get_info(), &info);
+    if (res != 0) {
+      L_(fatal) << "lookup of rail " << address << " failed: " << res << "="
+                << fi_strerror(-res);
+      throw LibfabricException("lookup of rail " + address + " failed");
+    }
+
+    struct fid_domain* pd = nullptr;
+    res = fi_domain(Provider::getInst()->get_fabric(), info, &pd, nullptr);
+    if (pd == nullptr) {
+      L_(fatal) << "fi_domain failed for rail " << address << ": " << -res
+                << "=" << fi_strerror(-res);
+      fi_freeinfo(info);
+      throw LibfabricException("fi_domain failed");
+    }
+
+    rail_contexts_.push_back({info, pd, open_cq(pd)});
+    return rail_contexts_.size() - 1;
+  }
+
+  /// Libfabric objects of a local network rail.
+  struct RailContext {
+    /// Provider information bound to the local rail address.
+    struct fi_info* info;
+
+    /// Libfabric protection domain.
+    struct fid_domain* pd;
+
+    /// Libfabric completion queue
+    struct fid_cq* cq;
+  };
+
+  /// Libfabric objects of the local network rails (if configured).
+  std::vector<RailContext> rail_contexts_;
+
   const uint32_t num_cqe_ = 1000000;
 
   /// Libfabric protection domain.
@@ -323,6 +371,26 @@ protected:
   bool connection_oriented_ = false;
 
 private:
+  /// Open a completion queue in a given domain.
+  struct fid_cq* open_cq(struct fid_domain* pd) {
+    struct fi_cq_attr cq_attr;
+    memset(&cq_attr, 0, sizeof(cq_attr));
+    cq_attr.size = num_cqe_;
+    cq_attr.flags = 0;
+    cq_attr.format = FI_CQ_FORMAT_CONTEXT;
+    cq_attr.wait_obj = FI_WAIT_NONE;
+    cq_attr.signaling_vector = Provider::vector++; // ??
+    cq_attr.wait_cond = FI_CQ_COND_NONE;
+    cq_attr.wait_set = nullptr;
+    struct fid_cq* cq = nullptr;
+    int res = fi_cq_open(pd, &cq_attr, &cq, nullptr);
+    if (cq == nullptr) {
+      L_(fatal) << "fi_cq_open failed: " << -res << "=" << fi_strerror(-res);
+      throw LibfabricException("fi_cq_open failed");
+    }
+    return cq;
+  }
+
   /// Connection manager event dispatcher. Called by the CM event loop.
   void on_cm_event(uint32_t event_kind,
                    struct fi_eq_cm_entry* event,
@@ -7,7 +7,9 @@
 #include "ComputeNodeStatusMessage.hpp"
 #include "Connection.hpp"
 #include "InputChannelStatusMessage.hpp"
+#include "StatusMessagePolicy.hpp"
 
+#include <chrono>
 #include <sys/uio.h>
 
 namespace tl_libfabric {
@@ -48,12 +50,27 @@ public:
   // Get number of bytes to skip in advance (to avoid buffer wrap)
   uint64_t skip_required(uint64_t data_size);
 
-  bool try_sync_buffer_positions();
+  /// Send a status message if it is our turn and an update is due.
+  bool try_sync_buffer_positions(std::chrono::steady_clock::time_point now);
+
+  /// Send a status message on the next turn regardless of the policy.
+  void request_status_update() { status_requested_ = true; }
+
+  void set_status_message_policy(const StatusMessagePolicy& policy) {
+    status_policy_ = policy;
+  }
+
+  const StatusMessageStatistics& status_message_statistics() const {
+    return status_stats_;
+  }
 
   void finalize(bool abort);
 
   bool request_abort_flag() { return recv_status_message_.request_abort; }
 
+  /// Latest schedule announcement received from the compute node.
+  const ScheduleAnnouncement& schedule() const { return schedule_; }
+
   void on_complete_write();
 
   /// Handle Libfabric receive completion notification.
@@ -81,7 +98,8 @@ public:
                struct fid_domain* domain,
                struct fid_cq* cq,
                struct fid_av* av,
-               fi_addr_t fi_addr);
+               fi_addr_t fi_addr,
+               struct fi_info* source_info = nullptr);
 
   void reconnect();
 
@@ -101,6 +119,17 @@ private:
   /// Flag, true if it is the input nodes's turn to send a pointer update.
   bool our_turn_ = true;
 
+  /// Decides when a pointer update is due.
+  StatusMessagePolicy status_policy_;
+
+  /// Flag, true if an update is due on the next turn.
+  bool status_requested_ = false;
+
+  /// Time of the last pointer update.
+  std::chrono::steady_clock::time_point last_status_time_;
+
+  StatusMessageStatistics status_stats_;
+
   bool finalize_ = false;
   bool abort_ = false;
 
@@ -110,6 +139,9 @@ private:
   /// Local copy of acknowledged-by-CN pointers
   ComputeNodeBufferPosition cn_ack_ = ComputeNodeBufferPosition();
 
+  /// Local copy of the schedule announcement of the CN
+  ScheduleAnnouncement schedule_ = ScheduleAnnouncement();
+
   /// Receive buffer for CN status (including acknowledged-by-CN pointers)
   ComputeNodeStatusMessage recv_status_message_ = ComputeNodeStatusMessage();
 
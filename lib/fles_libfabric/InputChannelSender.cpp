@@ -21,11 +21,16 @@ InputChannelSender::InputChannelSender(
     uint32_t timeslice_size,
     uint32_t overlap_size,
     uint32_t max_timeslice_number,
-    const std::string& input_node_name)
+    const std::string& input_node_name,
+    const std::string& scheduling_policy,
+    const std::vector<NetworkRail>& rails)
     : ConnectionGroup(input_node_name), input_index_(input_index),
       data_source_(data_source), compute_hostnames_(compute_hostnames),
       compute_services_(compute_services), timeslice_size_(timeslice_size),
       overlap_size_(overlap_size), max_timeslice_number_(max_timeslice_number),
+      policy_(SchedulingPolicy::create(
+          scheduling_policy,
+          static_cast<uint32_t>(compute_hostnames.size()))),
       min_acked_desc_(data_source.desc_buffer().size() / 4),
       min_acked_data_(data_source.data_buffer().size() / 4) {
 
@@ -43,26 +48,45 @@ InputChannelSender::InputChannelSender(
   } else {
     connection_oriented_ = false;
   }
+
+  if (!rails.empty()) {
+    if (!connection_oriented_) {
+      L_(warning) << "[i" << input_index_ << "] "
+                  << "rails require a connection-oriented provider, ignored";
+    } else {
+      int numa_node =
+          NetworkRail::numa_node_of_memory(data_source_.data_buffer().ptr());
+      rails_ = NetworkRail::select(rails, numa_node);
+      for (const auto& rail : rails_) {
+        L_(info) << "[i" << input_index_ << "] "
+                 << "using rail " << rail.address() << " (NUMA node "
+                 << rail.numa_node() << ", buffer on node " << numa_node
+                 << ")";
+      }
+    }
+  }
 }
 
 InputChannelSender::~InputChannelSender() {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
-  if (mr_desc_ != nullptr) {
-    fi_close((struct fid*)mr_desc_);
-    mr_desc_ = nullptr;
+  for (auto& mr : mr_desc_) {
+    if (mr != nullptr) {
+      fi_close((struct fid*)mr);
+      mr = nullptr;
+    }
   }
 
-  if (mr_data_ != nullptr) {
-    fi_close((struct fid*)(mr_data_));
-    mr_data_ = nullptr;
+  for (auto& mr : mr_data_) {
+    if (mr != nullptr) {
+      fi_close((struct fid*)(mr));
+      mr = nullptr;
+    }
   }
 #pragma GCC diagnostic pop
 }
 
 void InputChannelSender::report_status() {
-  constexpr auto interval = std::chrono::seconds(1);
-
   // if data_source.written pointers are lagging behind due to lazy updates,
   // use sent value instead
   uint64_t written_desc = data_source_.get_write_index().desc;
@@ -88,6 +112,15 @@ void InputChannelSender::report_status() {
                                sent_data_,
                                written_data};
 
+  metrics_.set_buffer_fill(
+      1.0 - status_data.percentage(status_data.unused()),
+      1.0 - status_desc.percentage(status_desc.unused()));
+  metrics_.telemetry().data.set(cached_acked_data_, written_data,
+                                data_source_.data_buffer().size());
+  metrics_.telemetry().desc.set(cached_acked_desc_, written_desc,
+                                data_source_.desc_buffer().size());
+  metrics_.update_rates();
+
   double delta_t =
       std::chrono::duration<double, std::chrono::seconds::period>(
           status_desc.time - previous_send_buffer_status_desc_.time)
@@ -101,6 +134,14 @@ void InputChannelSender::report_status() {
                           previous_send_buffer_status_data_.acked) /
       delta_t;
 
+  StatusMessageStatistics status_messages;
+  for (auto& c : conn_) {
+    status_messages += c->status_message_statistics();
+  }
+  double rate_status = static_cast<double>(status_messages.sent -
+                                           previous_status_messages_.sent) /
+                       delta_t;
+
   L_(debug) << "[i" << input_index_ << "] desc " << status_desc.percentages()
             << " (used..free) | "
             << human_readable_count(status_desc.acked, true, "") << " ("
@@ -111,6 +152,10 @@ void InputChannelSender::report_status() {
             << human_readable_count(status_data.acked, true) << " ("
             << human_readable_count(rate_data, true, "B/s") << ")";
 
+  L_(debug) << "[i" << input_index_ << "] status messages "
+            << human_readable_count(status_messages.sent, true, "") << " ("
+            << human_readable_count(rate_status, true, "Hz") << ")";
+
   L_(info) << "[i" << input_index_ << "]   |"
            << bar_graph(status_data.vector(), "#x._", 20) << "|"
            << bar_graph(status_desc.vector(), "#x._", 10) << "| "
@@ -119,33 +164,25 @@ void InputChannelSender::report_status() {
 
   previous_send_buffer_status_desc_ = status_desc;
   previous_send_buffer_status_data_ = status_data;
+  previous_status_messages_ = status_messages;
 
-  scheduler_.add(std::bind(&InputChannelSender::report_status, this),
-                 now + interval);
+  if (trace_) {
+    trace_->flush();
+  }
 }
 
 void InputChannelSender::sync_buffer_positions() {
   for (auto& c : conn_) {
-    c->try_sync_buffer_positions();
+    c->try_sync_buffer_positions(scheduler_.now());
   }
-
-  auto now = std::chrono::system_clock::now();
-  scheduler_.add(std::bind(&InputChannelSender::sync_buffer_positions, this),
-                 now + std::chrono::milliseconds(0));
 }
 
-void InputChannelSender::sync_data_source(bool schedule) {
+void InputChannelSender::sync_data_source() {
   if (acked_data_ > cached_acked_data_ || acked_desc_ > cached_acked_desc_) {
     cached_acked_data_ = acked_data_;
     cached_acked_desc_ = acked_desc_;
     data_source_.set_read_index({cached_acked_desc_, cached_acked_data_});
   }
-
-  if (schedule) {
-    auto now = std::chrono::system_clock::now();
-    scheduler_.add(std::bind(&InputChannelSender::sync_data_source, this, true),
-                   now + std::chrono::milliseconds(100));
-  }
 }
 
 void InputChannelSender::bootstrap_with_connections() {
@@ -190,62 +227,106 @@ void InputChannelSender::bootstrap_wo_connections() {
 /// The thread main function.
 void InputChannelSender::operator()() {
   try {
-
-    if (Provider::getInst()->is_connection_oriented()) {
-      bootstrap_with_connections();
-    } else {
-      bootstrap_wo_connections();
+    start();
+    while (step()) {
     }
+    stop();
+  } catch (std::exception& e) {
+    L_(fatal) << "exception in InputChannelSender: " << e.what();
+  }
+}
 
-    data_source_.proceed();
-    time_begin_ = std::chrono::high_resolution_clock::now();
+void InputChannelSender::start() {
+  if (Provider::getInst()->is_connection_oriented()) {
+    bootstrap_with_connections();
+  } else {
+    bootstrap_wo_connections();
+  }
+  L_(debug) << "[i" << input_index_ << "] "
+            << "scheduling policy: " << policy_->description();
+
+  data_source_.proceed();
+  time_begin_ = std::chrono::high_resolution_clock::now();
+
+  scheduler_.timer();
+  sync_buffer_positions();
+  sync_data_source();
+  report_status();
+  scheduler_.add_periodic(sync_data_source_timer_,
+                          std::chrono::milliseconds(100));
+  scheduler_.add_periodic(report_status_timer_, std::chrono::seconds(1));
+}
 
-    uint64_t timeslice = 0;
-    sync_buffer_positions();
-    sync_data_source(true);
-    report_status();
-    while (timeslice < max_timeslice_number_ && !abort_) {
-      if (try_send_timeslice(timeslice)) {
-        timeslice++;
+bool InputChannelSender::step() {
+  if (!finalized_) {
+    if (timeslice_ < max_timeslice_number_ && !abort_) {
+      if (try_send_timeslice(timeslice_)) {
+        timeslice_++;
       }
       poll_completion();
       data_source_.proceed();
       scheduler_.timer();
+      sync_buffer_positions();
+      return true;
     }
 
     // wait for pending send completions
-    while (acked_desc_ < timeslice_size_ * timeslice + start_index_desc_) {
+    if (acked_desc_ < timeslice_size_ * timeslice_ + start_index_desc_) {
       poll_completion();
       scheduler_.timer();
+      sync_buffer_positions();
+      return true;
     }
-    sync_data_source(false);
+    sync_data_source();
 
     L_(debug) << "[i " << input_index_ << "] "
               << "Finalize Connections";
     for (auto& c : conn_) {
       c->finalize(abort_);
     }
+    finalized_ = true;
 
     L_(debug) << "[i" << input_index_ << "] "
               << "SENDER loop done";
-    while (!all_done_) {
-      poll_completion();
-      scheduler_.timer();
-    }
-    time_end_ = std::chrono::high_resolution_clock::now();
+  }
 
-    if (connection_oriented_) {
-      disconnect();
-    }
+  if (!all_done_) {
+    poll_completion();
+    scheduler_.timer();
+    sync_buffer_positions();
+    return true;
+  }
+  time_end_ = std::chrono::high_resolution_clock::now();
+  return false;
+}
 
-    while (connected_ != 0) {
-      poll_cm_events();
-    }
+void InputChannelSender::stop() {
+  if (connection_oriented_) {
+    disconnect();
+  }
 
-    summary();
-  } catch (std::exception& e) {
-    L_(fatal) << "exception in InputChannelSender: " << e.what();
+  while (connected_ != 0) {
+    poll_cm_events();
   }
+
+  summary();
+  if (rails_.size() > 1) {
+    std::vector<uint64_t> rail_bytes(rails_.size());
+    for (auto& c : conn_) {
+      rail_bytes[rail_index(c->index())] += c->total_bytes_sent();
+    }
+    for (size_t r = 0; r < rails_.size(); ++r) {
+      L_(info) << "[i" << input_index_ << "] rail " << rails_[r].address()
+               << ": " << human_readable_count(rail_bytes[r]) << " sent";
+    }
+  }
+  StatusMessageStatistics status_messages;
+  for (auto& c : conn_) {
+    status_messages += c->status_message_statistics();
+  }
+  L_(info) << "[i" << input_index_ << "] " << status_messages.sent
+           << " status messages sent, " << status_messages.received
+           << " received";
 }
 
 bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
@@ -258,6 +339,11 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
   }
   // check if microslice no. (desc_offset + desc_length - 1) is avail
   if (write_index_desc_ >= desc_offset + desc_length) {
+    if (trace_ && timeslice != trace_written_ts_) {
+      trace_written_ts_ = timeslice;
+      trace_->record(timeslice, TraceStage::InputWritten,
+                     static_cast<uint32_t>(input_index_));
+    }
 
     uint64_t data_offset = data_source_.desc_buffer().at(desc_offset).offset;
     uint64_t data_end =
@@ -278,6 +364,13 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
     }
 
     int cn = target_cn_index(timeslice);
+    if (cn < 0) {
+      // assignment not yet announced by all compute nodes
+      for (auto& c : conn_) {
+        c->request_status_update();
+      }
+      return false;
+    }
 
     if (!conn_[cn]->write_request_available()) {
       return false;
@@ -293,12 +386,25 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
                      data_length, skip);
 
       conn_[cn]->inc_write_pointers(total_length, 1);
+      if (trace_) {
+        trace_->record(timeslice, TraceStage::SendPosted,
+                       static_cast<uint32_t>(input_index_));
+      }
 
       sent_desc_ = desc_offset + desc_length;
       sent_data_ = data_end;
 
+      metrics_.add_timeslice(data_length +
+                             desc_length * sizeof(fles::MicrosliceDescriptor));
+
       return true;
     }
+    // blocked, ask the compute node for its acknowledged pointers
+    conn_[cn]->request_status_update();
+    if (timeslice != stalled_ts_) {
+      stalled_ts_ = timeslice;
+      metrics_.add_stall();
+    }
   }
 
   return false;
@@ -323,38 +429,73 @@ InputChannelSender::create_input_node_connection(uint_fast16_t index) {
 }
 
 void InputChannelSender::connect() {
-  if (pd_ == nullptr) { // pd, cq2, av
-    init_context(Provider::getInst()->get_info(), compute_hostnames_,
-                 compute_services_);
+  if (rails_.empty()) {
+    if (pd_ == nullptr) { // pd, cq2, av
+      init_context(Provider::getInst()->get_info(), compute_hostnames_,
+                   compute_services_);
+    }
+  } else if (rail_contexts_.empty()) {
+    for (const auto& rail : rails_) {
+      init_rail_context(rail.address());
+    }
   }
 
   for (unsigned int i = 0; i < compute_hostnames_.size(); ++i) {
     std::unique_ptr<InputChannelConnection> connection =
         create_input_node_connection(i);
-    connection->connect(compute_hostnames_[i], compute_services_[i], pd_, cq_,
-                        av_, FI_ADDR_UNSPEC);
+    initiate_connection(*connection);
     conn_.push_back(std::move(connection));
   }
 }
 
+void InputChannelSender::initiate_connection(
+    InputChannelConnection& connection) {
+  uint_fast16_t i = connection.index();
+  if (rails_.empty()) {
+    connection.connect(compute_hostnames_[i], compute_services_[i], pd_, cq_,
+                       av_, FI_ADDR_UNSPEC);
+  } else {
+    const RailContext& rail = rail_contexts_.at(rail_index(i));
+    connection.connect(compute_hostnames_[i], compute_services_[i], rail.pd,
+                       rail.cq, av_, FI_ADDR_UNSPEC, rail.info);
+  }
+}
+
 int InputChannelSender::target_cn_index(uint64_t timeslice) {
-  return timeslice % conn_.size();
+  return policy_->target(timeslice);
+}
+
+size_t InputChannelSender::rail_index(uint_fast16_t index) const {
+  assert(!rails_.empty());
+  // alternate rails between compute nodes (and thereby timeslices), shifted
+  // by input index to balance rails across inputs
+  return (index + input_index_) % rails_.size();
 }
 
 void InputChannelSender::on_connected(struct fid_domain* pd) {
-  if (mr_data_ == nullptr) {
+  // without rails, the single domain has index 0
+  size_t domain = 0;
+  while (domain < rail_contexts_.size() && rail_contexts_[domain].pd != pd) {
+    ++domain;
+  }
+  if (domain >= mr_data_.size()) {
+    mr_data_.resize(domain + 1, nullptr);
+    mr_desc_.resize(domain + 1, nullptr);
+  }
+
+  if (mr_data_[domain] == nullptr) {
     // Register memory regions.
     int err =
         fi_mr_reg(pd, const_cast<uint8_t*>(data_source_.data_buffer().ptr()),
                   data_source_.data_buffer().bytes(), FI_WRITE, 0,
-                  Provider::requested_key++, 0, &mr_data_, nullptr);
+                  Provider::requested_key++, 0, &mr_data_[domain], nullptr);
     if (err != 0) {
       L_(fatal) << "fi_mr_reg failed for data_send_buffer: " << err << "="
                 << fi_strerror(-err);
       throw LibfabricException("fi_mr_reg failed for data_send_buffer");
     }
 
-    if (mr_data_ == nullptr) {
+    if (mr_data_[domain] == nullptr) {
       L_(fatal) << "fi_mr_reg failed for mr_data: " << strerror(errno);
       throw LibfabricException("registration of memory region failed");
     }
@@ -363,14 +504,14 @@ void InputChannelSender::on_connected(struct fid_domain* pd) {
                     const_cast<fles::MicrosliceDescriptor*>(
                         data_source_.desc_buffer().ptr()),
                     data_source_.desc_buffer().bytes(), FI_WRITE, 0,
-                    Provider::requested_key++, 0, &mr_desc_, nullptr);
+                    Provider::requested_key++, 0, &mr_desc_[domain], nullptr);
     if (err != 0) {
       L_(fatal) << "fi_mr_reg failed for desc_send_buffer: " << err << "="
                 << fi_strerror(-err);
       throw LibfabricException("fi_mr_reg failed for desc_send_buffer");
     }
 
-    if (mr_desc_ == nullptr) {
+    if (mr_desc_[domain] == nullptr) {
       L_(fatal) << "fi_mr_reg failed for mr_desc: " << strerror(errno);
       throw LibfabricException("registration of memory region failed");
     }
@@ -391,8 +532,7 @@ void InputChannelSender::on_rejected(struct fi_eq_err_entry* event) {
   // immediately initiate retry
   std::unique_ptr<InputChannelConnection> connection =
       create_input_node_connection(i);
-  connection->connect(compute_hostnames_[i], compute_services_[i], pd_, cq_,
-                      av_, FI_ADDR_UNSPEC);
+  initiate_connection(*connection);
   conn_.at(i) = std::move(connection);
 }
 
@@ -429,6 +569,9 @@ void InputChannelSender::post_send_data(uint64_t timeslice,
   int num_sge = 0;
   struct iovec sge[4];
   void* descs[4];
+  size_t domain = rails_.empty() ? 0 : rail_index(cn);
+  void* desc_mr_desc = fi_mr_desc(mr_desc_[domain]);
+  void* data_mr_desc = fi_mr_desc(mr_data_[domain]);
   // descriptors
   if ((desc_offset & data_source_.desc_buffer().size_mask()) <=
       ((desc_offset + desc_length - 1) &
@@ -436,9 +579,7 @@ void InputChannelSender::post_send_data(uint64_t timeslice,
     // one chunk
     sge[num_sge].iov_base = &data_source_.desc_buffer().at(desc_offset);
     sge[num_sge].iov_len = sizeof(fles::MicrosliceDescriptor) * desc_length;
-    assert(mr_desc_ != nullptr);
-    descs[num_sge++] = fi_mr_desc(mr_desc_);
-    // sge[num_sge++].lkey = mr_desc_->lkey;
+    descs[num_sge++] = desc_mr_desc;
   } else {
     // two chunks
     sge[num_sge].iov_base = &data_source_.desc_buffer().at(desc_offset);
@@ -446,13 +587,13 @@ void InputChannelSender::post_send_data(uint64_t timeslice,
         sizeof(fles::MicrosliceDescriptor) *
         (data_source_.desc_buffer().size() -
          (desc_offset & data_source_.desc_buffer().size_mask()));
-    descs[num_sge++] = fi_mr_desc(mr_desc_);
+    descs[num_sge++] = desc_mr_desc;
     sge[num_sge].iov_base = data_source_.desc_buffer().ptr();
     sge[num_sge].iov_len =
         sizeof(fles::MicrosliceDescriptor) *
         (desc_length - data_source_.desc_buffer().size() +
          (desc_offset & data_source_.desc_buffer().size_mask()));
-    descs[num_sge++] = fi_mr_desc(mr_desc_);
+    descs[num_sge++] = desc_mr_desc;
   }
   // data
   if (data_length == 0) {
@@ -463,19 +604,19 @@ void InputChannelSender::post_send_data(uint64_t timeslice,
     // one chunk
     sge[num_sge].iov_base = &data_source_.data_buffer().at(data_offset);
     sge[num_sge].iov_len = data_length;
-    descs[num_sge++] = fi_mr_desc(mr_data_);
+    descs[num_sge++] = data_mr_desc;
   } else {
     // two chunks
     sge[num_sge].iov_base = &data_source_.data_buffer().at(data_offset);
     sge[num_sge].iov_len =
         data_source_.data_buffer().size() -
         (data_offset & data_source_.data_buffer().size_mask());
-    descs[num_sge++] = fi_mr_desc(mr_data_);
+    descs[num_sge++] = data_mr_desc;
     sge[num_sge].iov_base = data_source_.data_buffer().ptr();
     sge[num_sge].iov_len =
         data_length - data_source_.data_buffer().size() +
         (data_offset & data_source_.data_buffer().size_mask());
-    descs[num_sge++] = fi_mr_desc(mr_data_);
+    descs[num_sge++] = data_mr_desc;
   }
 
   conn_[cn]->send_data(sge, descs, num_sge, timeslice, desc_length, data_length,
@@ -486,6 +627,10 @@ void InputChannelSender::on_completion(uint64_t wr_id) {
   switch (wr_id & 0xFF) {
   case ID_WRITE_DESC: {
     uint64_t ts = wr_id >> 24;
+    if (trace_) {
+      trace_->record(ts, TraceStage::SendCompleted,
+                     static_cast<uint32_t>(input_index_));
+    }
 
     int cn = (wr_id >> 8) & 0xFFFF;
     conn_[cn]->on_complete_write();
@@ -521,6 +666,7 @@ void InputChannelSender::on_completion(uint64_t wr_id) {
   case ID_RECEIVE_STATUS: {
     int cn = wr_id >> 8;
     conn_[cn]->on_complete_recv();
+    policy_->on_announcement(cn, conn_[cn]->schedule());
     if (!connection_oriented_ && (conn_[cn]->get_partner_addr() == 0u)) {
       conn_[cn]->set_partner_addr(av_);
       conn_[cn]->set_remote_info();
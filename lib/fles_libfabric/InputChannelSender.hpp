@@ -6,7 +6,11 @@
 #include "ConnectionGroup.hpp"
 #include "DualRingBuffer.hpp"
 #include "InputChannelConnection.hpp"
+#include "Metrics.hpp"
+#include "NetworkRail.hpp"
 #include "RingBuffer.hpp"
+#include "SchedulingPolicy.hpp"
+#include "TraceRecorder.hpp"
 #include <boost/format.hpp>
 #include <cassert>
 
@@ -31,7 +35,10 @@ public:
                      uint32_t timeslice_size,
                      uint32_t overlap_size,
                      uint32_t max_timeslice_number,
-                     const std::string& input_node_name);
+                     const std::string& input_node_name,
+                     const std::string& scheduling_policy = "round-robin",
+                     const std::vector<NetworkRail>& rails =
+                         std::vector<NetworkRail>());
 
   InputChannelSender(const InputChannelSender&) = delete;
   void operator=(const InputChannelSender&) = delete;
@@ -42,10 +49,24 @@ public:
   void report_status();
 
   void sync_buffer_positions();
-  void sync_data_source(bool schedule);
+  void sync_data_source();
 
   void operator()() override;
 
+  /// Connect to the compute nodes and prepare the sender loop.
+  void start() override;
+
+  /// Perform one iteration of the sender loop, return false when done.
+  bool step() override;
+
+  /// Disconnect from the compute nodes and report statistics.
+  void stop() override;
+
+  /// Record the input and send trace points of this input channel.
+  void set_trace(std::unique_ptr<TraceRecorder> trace) {
+    trace_ = std::move(trace);
+  }
+
   /// The central function for distributing timeslice data.
   bool try_send_timeslice(uint64_t timeslice);
 
@@ -61,6 +82,13 @@ private:
   /// Return target computation node for given timeslice.
   int target_cn_index(uint64_t timeslice);
 
+  /// Return index of the rail used for a compute node connection.
+  size_t rail_index(uint_fast16_t index) const;
+
+  /// Initiate connection request to the compute node of a connection,
+  /// using the rail assigned to it.
+  void initiate_connection(InputChannelConnection& connection);
+
   /// Handle RDMA_CM_REJECTED event.
   void on_rejected(struct fi_eq_err_entry* event) override;
 
@@ -87,11 +115,16 @@ private:
 
   uint64_t input_index_;
 
-  /// Libfabric memory region descriptor for input data buffer.
-  struct fid_mr* mr_data_ = nullptr;
+  /// Libfabric memory region descriptors for input data buffer (one per
+  /// domain).
+  std::vector<struct fid_mr*> mr_data_;
 
-  /// Libfabric memory region descriptor for input descriptor buffer.
-  struct fid_mr* mr_desc_ = nullptr;
+  /// Libfabric memory region descriptors for input descriptor buffer (one
+  /// per domain).
+  std::vector<struct fid_mr*> mr_desc_;
+
+  /// Local network rails, distributed over the compute node connections.
+  std::vector<NetworkRail> rails_;
 
   /// Buffer to store acknowledged status of timeslices.
   RingBuffer<uint64_t, true> ack_;
@@ -118,6 +151,9 @@ private:
   const uint32_t overlap_size_;
   const uint32_t max_timeslice_number_;
 
+  /// Assignment of timeslices to compute nodes.
+  std::unique_ptr<SchedulingPolicy> policy_;
+
   const uint64_t min_acked_desc_;
   const uint64_t min_acked_data_;
 
@@ -133,6 +169,12 @@ private:
 
   bool abort_ = false;
 
+  /// The next timeslice to send.
+  uint64_t timeslice_ = 0;
+
+  /// Flag indicating that all connections have been finalized.
+  bool finalized_ = false;
+
   struct SendBufferStatus {
     std::chrono::system_clock::time_point time;
     uint64_t size;
@@ -187,5 +229,24 @@ private:
 
   SendBufferStatus previous_send_buffer_status_desc_ = SendBufferStatus();
   SendBufferStatus previous_send_buffer_status_data_ = SendBufferStatus();
+  StatusMessageStatistics previous_status_messages_ = StatusMessageStatistics();
+
+  /// Progress and buffer metrics of this input channel.
+  ComponentMetrics metrics_{"input", input_index_};
+
+  /// Optional timeslice trace recorder.
+  std::unique_ptr<TraceRecorder> trace_;
+
+  /// The last timeslice recorded as available in the input buffer.
+  uint64_t trace_written_ts_ = UINT64_MAX;
+
+  /// Last timeslice counted as stalled (blocked by a full buffer).
+  uint64_t stalled_ts_ = UINT64_MAX;
+
+  /// Timer for the periodic update of the data source read index.
+  Scheduler::Timer sync_data_source_timer_{[this] { sync_data_source(); }};
+
+  /// Timer for the periodic status report.
+  Scheduler::Timer report_status_timer_{[this] { report_status(); }};
 };
 } // namespace tl_libfabric
@@ -7,7 +7,9 @@
 #include "RequestIdentifier.hpp"
 #include "TimesliceCompletion.hpp"
 #include "TimesliceWorkItem.hpp"
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
+#include <limits>
 //#include <boost/lexical_cast.hpp>
 //#include <log.hpp>
 //#include <random>
@@ -16,20 +18,23 @@
 
 namespace tl_libfabric {
 
-TimesliceBuilder::TimesliceBuilder(uint64_t compute_index,
-                                   TimesliceBuffer& timeslice_buffer,
-                                   unsigned short service,
-                                   uint32_t num_input_nodes,
-                                   uint32_t timeslice_size,
-                                   volatile sig_atomic_t* signal_status,
-                                   bool drop,
-                                   const std::string& local_node_name)
+TimesliceBuilder::TimesliceBuilder(
+    uint64_t compute_index,
+    TimesliceBuffer& timeslice_buffer,
+    unsigned short service,
+    uint32_t num_input_nodes,
+    uint32_t timeslice_size,
+    volatile sig_atomic_t* signal_status,
+    bool drop,
+    const std::string& local_node_name,
+    std::unique_ptr<ScheduleAnnouncer> announcer)
     : ConnectionGroup(local_node_name), compute_index_(compute_index),
       timeslice_buffer_(timeslice_buffer), service_(service),
       num_input_nodes_(num_input_nodes), timeslice_size_(timeslice_size),
       ack_(timeslice_buffer_.get_desc_size_exp()),
+      completion_time_(timeslice_buffer_.get_desc_size_exp()),
       signal_status_(signal_status), local_node_name_(local_node_name),
-      drop_(drop) {
+      drop_(drop), announcer_(std::move(announcer)) {
   assert(timeslice_buffer_.get_num_input_nodes() == num_input_nodes);
   assert(not local_node_name_.empty());
   if (Provider::getInst()->is_connection_oriented()) {
@@ -42,16 +47,21 @@ TimesliceBuilder::TimesliceBuilder(uint64_t compute_index,
 TimesliceBuilder::~TimesliceBuilder() = default;
 
 void TimesliceBuilder::report_status() {
-  constexpr auto interval = std::chrono::seconds(1);
-
   std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
 
   L_(debug) << "[c" << compute_index_ << "] " << completely_written_
             << " completely written, " << acked_ << " acked";
 
+  float min_free_desc = std::numeric_limits<float>::max();
+  float min_free_data = std::numeric_limits<float>::max();
+
   for (auto& c : conn_) {
     auto status_desc = c->buffer_status_desc();
     auto status_data = c->buffer_status_data();
+    min_free_desc =
+        std::min(min_free_desc, status_desc.percentage(status_desc.unused()));
+    min_free_data =
+        std::min(min_free_data, status_data.percentage(status_data.unused()));
     L_(debug) << "[c" << compute_index_ << "] desc "
               << status_desc.percentages() << " (used..free) | "
               << human_readable_count(status_desc.acked, true, "")
@@ -64,8 +74,14 @@ void TimesliceBuilder::report_status() {
              << bar_graph(status_desc.vector(), "#._", 10) << "| ";
   }
 
-  scheduler_.add(std::bind(&TimesliceBuilder::report_status, this),
-                 now + interval);
+  if (!conn_.empty()) {
+    metrics_.set_buffer_fill(1. - min_free_data, 1. - min_free_desc);
+  }
+  metrics_.update_rates();
+
+  if (TraceRecorder* trace = timeslice_buffer_.trace()) {
+    trace->flush();
+  }
 }
 
 void TimesliceBuilder::request_abort() {
@@ -322,6 +338,7 @@ void TimesliceBuilder::operator()() {
     time_begin_ = std::chrono::high_resolution_clock::now();
 
     report_status();
+    scheduler_.add_periodic(report_status_timer_, std::chrono::seconds(1));
     while (!all_done_ || connected_ != 0) {
       if (!all_done_) {
         poll_completion();
@@ -343,6 +360,16 @@ void TimesliceBuilder::operator()() {
     timeslice_buffer_.send_end_completion();
 
     summary();
+    timeslice_buffer_.log_consumer_statistics(
+        "[c" + std::to_string(compute_index_) + "] ");
+    L_(info) << "[c" << compute_index_ << "] " << ack_stats_.completions
+             << " completions in " << ack_stats_.batches << " batches, "
+             << ack_stats_.updates << " ack updates, latency mean "
+             << ack_stats_.mean_latency_us() << " us, max "
+             << std::chrono::duration<double, std::micro>(
+                    ack_stats_.latency_max)
+                    .count()
+             << " us";
   } catch (std::exception& e) {
     L_(error) << "exception in TimesliceBuilder: " << e.what();
   }
@@ -420,18 +447,41 @@ void TimesliceBuilder::on_completion(uint64_t wr_id) {
 
       for (uint64_t tpos = completely_written_; tpos < new_completely_written;
            ++tpos) {
+        uint64_t ts_bytes = 0;
+        for (size_t c = 0; c < conn_.size(); ++c) {
+          ts_bytes += timeslice_buffer_.get_desc(c, tpos).size;
+        }
+        metrics_.add_timeslice(ts_bytes);
         if (!drop_) {
           uint64_t ts_index = UINT64_MAX;
           if (!conn_.empty()) {
             ts_index = timeslice_buffer_.get_desc(0, tpos).ts_num;
           }
+          if (TraceRecorder* trace = timeslice_buffer_.trace()) {
+            trace->record(ts_index, TraceStage::BuilderComplete,
+                          static_cast<uint32_t>(compute_index_));
+          }
           timeslice_buffer_.send_work_item(
               {{ts_index, tpos, timeslice_size_,
                 static_cast<uint32_t>(conn_.size())},
                timeslice_buffer_.get_data_size_exp(),
                timeslice_buffer_.get_desc_size_exp()});
         } else {
-          timeslice_buffer_.send_completion({tpos});
+          timeslice_buffer_.send_completion({tpos, UINT32_MAX});
+        }
+      }
+
+      if (announcer_ && new_completely_written > completely_written_) {
+        // announce weights for upcoming epochs based on buffer occupancy
+        double fill_level =
+            static_cast<double>(new_completely_written - acked_) /
+            static_cast<double>(UINT64_C(1)
+                                << timeslice_buffer_.get_desc_size_exp());
+        announcer_->update(
+            timeslice_buffer_.get_desc(0, new_completely_written - 1).ts_num,
+            fill_level);
+        for (auto& connection : conn_) {
+          connection->set_schedule(announcer_->announcement());
         }
       }
 
@@ -445,19 +495,40 @@ void TimesliceBuilder::on_completion(uint64_t wr_id) {
 }
 
 void TimesliceBuilder::poll_ts_completion() {
+  auto now = std::chrono::steady_clock::now();
   fles::TimesliceCompletion c;
-  if (!timeslice_buffer_.try_receive_completion(c)) {
+  size_t count = 0;
+  while (count < max_completion_batch_ &&
+         timeslice_buffer_.try_receive_completion(c)) {
+    // mark as done, stale entries of the previous buffer cycle never match
+    ack_.at(c.ts_pos) = c.ts_pos + 1;
+    completion_time_.at(c.ts_pos) = now;
+    ++count;
+  }
+  if (count == 0) {
     return;
   }
-  if (c.ts_pos == acked_) {
-    do {
-      ++acked_;
-    } while (ack_.at(acked_) > c.ts_pos);
-    for (auto& connection : conn_) {
-      connection->inc_ack_pointers(acked_);
-    }
-  } else {
-    ack_.at(c.ts_pos) = c.ts_pos;
+  ack_stats_.completions += count;
+  ++ack_stats_.batches;
+
+  uint64_t new_acked = acked_;
+  while (ack_.at(new_acked) == new_acked + 1) {
+    ++new_acked;
+  }
+  if (new_acked == acked_) {
+    return;
+  }
+
+  // publish the whole advance as a single update per connection
+  now = std::chrono::steady_clock::now();
+  for (; acked_ < new_acked; ++acked_) {
+    auto latency = now - completion_time_.at(acked_);
+    ack_stats_.latency_sum += latency;
+    ack_stats_.latency_max = std::max(ack_stats_.latency_max, latency);
+  }
+  for (auto& connection : conn_) {
+    connection->inc_ack_pointers(acked_);
   }
+  ++ack_stats_.updates;
 }
 } // namespace tl_libfabric
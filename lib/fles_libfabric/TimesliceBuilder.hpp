@@ -4,13 +4,16 @@
 
 #include "ComputeNodeConnection.hpp"
 #include "ConnectionGroup.hpp"
+#include "Metrics.hpp"
 #include "RingBuffer.hpp"
+#include "SchedulingPolicy.hpp"
 #include "TimesliceComponentDescriptor.hpp"
 
 #include <boost/interprocess/ipc/message_queue.hpp>
 #include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/shared_memory_object.hpp>
 
+#include <chrono>
 #include <csignal>
 #include <cstdint>
 #include <set>
@@ -37,7 +40,8 @@ public:
                    uint32_t timeslice_size,
                    volatile sig_atomic_t* signal_status,
                    bool drop,
-                   const std::string& local_node_name);
+                   const std::string& local_node_name,
+                   std::unique_ptr<ScheduleAnnouncer> announcer = nullptr);
 
   TimesliceBuilder(const TimesliceBuilder&) = delete;
   void operator=(const TimesliceBuilder&) = delete;
@@ -58,8 +62,29 @@ public:
   /// Completion notification event dispatcher. Called by the event loop.
   void on_completion(uint64_t wr_id) override;
 
+  /// Receive all pending timeslice completions and advance the
+  /// acknowledgement pointers of all connections once per batch.
   void poll_ts_completion();
 
+  /// Completion-to-acknowledgement latency statistics.
+  struct AckStatistics {
+    uint64_t completions = 0; ///< Timeslice completions received
+    uint64_t batches = 0;     ///< Non-empty completion batches
+    uint64_t updates = 0;     ///< Advances of the acknowledgement pointer
+    std::chrono::steady_clock::duration latency_sum{0};
+    std::chrono::steady_clock::duration latency_max{0};
+
+    double mean_latency_us() const {
+      if (completions == 0) {
+        return 0.0;
+      }
+      return std::chrono::duration<double, std::micro>(latency_sum).count() /
+             static_cast<double>(completions);
+    }
+  };
+
+  const AckStatistics& ack_statistics() const { return ack_stats_; }
+
 private:
   /// setup connections between nodes
   void bootstrap_with_connections();
@@ -96,10 +121,27 @@ private:
   /// Buffer to store acknowledged status of timeslices.
   RingBuffer<uint64_t, true> ack_;
 
+  /// Maximum number of timeslice completions received per batch.
+  static constexpr size_t max_completion_batch_ = 1024;
+
+  /// Buffer to store the arrival time of timeslice completions.
+  RingBuffer<std::chrono::steady_clock::time_point> completion_time_;
+
+  AckStatistics ack_stats_;
+
   volatile sig_atomic_t* signal_status_;
 
   std::string local_node_name_;
 
   bool drop_;
+
+  /// Announces scheduling weights to the inputs (occupancy-aware policy).
+  std::unique_ptr<ScheduleAnnouncer> announcer_;
+
+  /// Progress and buffer metrics of this timeslice builder.
+  ComponentMetrics metrics_{"output", compute_index_};
+
+  /// Timer for the periodic status report.
+  Scheduler::Timer report_status_timer_{[this] { report_status(); }};
 };
 } // namespace tl_libfabric
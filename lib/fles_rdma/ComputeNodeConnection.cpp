@@ -164,6 +164,7 @@ void ComputeNodeConnection::on_complete_recv() {
   cn_wp_ = recv_status_message_.wp;
   post_recv_status_message();
   send_status_message_.ack = cn_ack_;
+  send_status_message_.schedule = schedule_;
   post_send_status_message();
 }
 
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "ComputeNodeBufferPosition.hpp"
+#include "ScheduleAnnouncement.hpp"
 
 #pragma pack(1)
 
@@ -11,6 +12,7 @@ struct ComputeNodeStatusMessage {
   ComputeNodeBufferPosition ack;
   bool request_abort;
   bool final;
+  ScheduleAnnouncement schedule;
 };
 
 #pragma pack()
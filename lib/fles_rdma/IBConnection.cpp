@@ -42,7 +42,8 @@ IBConnection::~IBConnection() {
 }
 
 void IBConnection::connect(const std::string& hostname,
-                           const std::string& service) {
+                           const std::string& service,
+                           const std::string& source_address) {
   struct addrinfo hints;
   memset(&hints, 0, sizeof(struct addrinfo));
   hints.ai_family = AF_UNSPEC;
@@ -54,21 +55,48 @@ void IBConnection::connect(const std::string& hostname,
     throw InfinibandException("getaddrinfo failed");
   }
 
+  struct addrinfo* src_res = nullptr;
+  if (!source_address.empty()) {
+    err = getaddrinfo(source_address.c_str(), nullptr, &hints, &src_res);
+    if (err != 0) {
+      freeaddrinfo(res);
+      throw InfinibandException("getaddrinfo failed for source address");
+    }
+  }
+
   L_(debug) << "[" << index_ << "] "
-            << "resolution of server address and route";
+            << "resolution of server address and route"
+            << (source_address.empty() ? "" : " from " + source_address);
 
+  err = -1;
   for (struct addrinfo* t = res; t != nullptr; t = t->ai_next) {
-    err = rdma_resolve_addr(cm_id_, nullptr, t->ai_addr, RESOLVE_TIMEOUT_MS);
+    struct sockaddr* src_addr = nullptr;
+    for (struct addrinfo* s = src_res; s != nullptr; s = s->ai_next) {
+      if (s->ai_family == t->ai_family) {
+        src_addr = s->ai_addr;
+        break;
+      }
+    }
+    if (src_res != nullptr && src_addr == nullptr) {
+      continue;
+    }
+    err = rdma_resolve_addr(cm_id_, src_addr, t->ai_addr, RESOLVE_TIMEOUT_MS);
     if (err == 0) {
       break;
     }
   }
+  int resolve_errno = errno;
+
+  // the addresses are copied by rdma_resolve_addr, free them in any case
+  if (src_res != nullptr) {
+    freeaddrinfo(src_res);
+  }
+  freeaddrinfo(res);
+
   if (err != 0) {
-    L_(fatal) << "rdma_resolve_addr failed: " << strerror(errno);
+    L_(fatal) << "rdma_resolve_addr failed: " << strerror(resolve_errno);
     throw InfinibandException("rdma_resolve_addr failed");
   }
-
-  freeaddrinfo(res);
 }
 
 void IBConnection::disconnect() {
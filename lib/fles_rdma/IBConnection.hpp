@@ -31,10 +31,14 @@ public:
 
   /// Initiate a connection request to target hostname and service.
   /**
-     \param hostname The target hostname
-     \param service  The target service or port number
+     \param hostname       The target hostname
+     \param service        The target service or port number
+     \param source_address The local address to connect from (selects the
+                           local InfiniBand device), default if empty
   */
-  void connect(const std::string& hostname, const std::string& service);
+  void connect(const std::string& hostname,
+               const std::string& service,
+               const std::string& source_address = std::string());
 
   void disconnect();
 
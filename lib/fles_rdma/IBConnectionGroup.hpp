@@ -13,7 +13,8 @@
 
 /// InfiniBand connection group base class.
 /** An IBConnectionGroup object represents a group of InfiniBand
-    connections that use the same completion queue. */
+    connections that use the same completion queue per InfiniBand
+    device. */
 
 template <typename CONNECTION>
 class IBConnectionGroup : public ConnectionGroupWorker {
@@ -44,21 +45,18 @@ public:
       listen_id_ = nullptr;
     }
 
-    if (cq_) {
-      int err = ibv_destroy_cq(cq_);
+    for (auto& device : devices_) {
+      int err = ibv_destroy_cq(device.cq);
       if (err != 0) {
         L_(error) << "ibv_destroy_cq() failed";
       }
-      cq_ = nullptr;
-    }
 
-    if (pd_) {
-      int err = ibv_dealloc_pd(pd_);
+      err = ibv_dealloc_pd(device.pd);
       if (err != 0) {
         L_(error) << "ibv_dealloc_pd() failed";
       }
-      pd_ = nullptr;
     }
+    devices_.clear();
 
     rdma_destroy_event_channel(ec_);
   }
@@ -149,13 +147,22 @@ public:
 
   /// The InfiniBand completion notification handler.
   int poll_completion() {
+    int ne_total = 0;
+    for (auto& device : devices_) {
+      ne_total += poll_completion(device.cq);
+    }
+    return ne_total;
+  }
+
+  /// Handle the completion notifications of a single completion queue.
+  int poll_completion(struct ibv_cq* cq) {
     const int ne_max = 10;
 
     struct ibv_wc wc[ne_max];
     int ne;
     int ne_total = 0;
 
-    while (ne_total < 1000 && (ne = ibv_poll_cq(cq_, ne_max, wc))) {
+    while (ne_total < 1000 && (ne = ibv_poll_cq(cq, ne_max, wc))) {
       if (ne < 0) {
         throw InfinibandException("ibv_poll_cq failed");
       }
@@ -178,15 +185,8 @@ public:
     return ne_total;
   }
 
-  /// Retrieve the InfiniBand protection domain.
-  struct ibv_pd* protection_domain() const {
-    return pd_;
-  }
-
-  /// Retrieve the InfiniBand completion queue.
-  struct ibv_cq* completion_queue() const {
-    return cq_;
-  }
+  /// Retrieve the number of InfiniBand devices in use.
+  size_t num_devices() const { return devices_.size(); }
 
   size_t size() const { return conn_.size(); }
 
@@ -213,13 +213,11 @@ public:
 protected:
   /// Handle RDMA_CM_EVENT_ADDR_RESOLVED event.
   virtual void on_addr_resolved(struct rdma_cm_id* id) {
-    if (pd_ == nullptr) {
-      init_context(id->verbs);
-    }
+    const DeviceContext& device = devices_.at(device_index(id->verbs));
 
     CONNECTION* conn = static_cast<CONNECTION*>(id->context);
 
-    conn->on_addr_resolved(pd_, cq_);
+    conn->on_addr_resolved(device.pd, device.cq);
   }
 
   /// Handle RDMA_CM_EVENT_ROUTE_RESOLVED event.
@@ -264,34 +262,54 @@ protected:
     --timewait_;
   }
 
-  /// Initialize the InfiniBand verbs context.
-  void init_context(struct ibv_context* context) {
-    context_ = context;
+  /// Verbs objects of a single InfiniBand device (network rail).
+  struct DeviceContext {
+    /// InfiniBand verbs context
+    struct ibv_context* context;
 
-    L_(debug) << "create verbs objects";
+    /// InfiniBand protection domain.
+    struct ibv_pd* pd;
 
-    pd_ = ibv_alloc_pd(context);
-    if (pd_ == nullptr) {
+    /// InfiniBand completion queue
+    struct ibv_cq* cq;
+  };
+
+  /// Retrieve the index of the verbs objects of a device. The objects are
+  /// created when the device is first used.
+  size_t device_index(struct ibv_context* context) {
+    for (size_t i = 0; i < devices_.size(); ++i) {
+      if (devices_[i].context == context) {
+        return i;
+      }
+    }
+
+    L_(debug) << "create verbs objects for device "
+              << ibv_get_device_name(context->device);
+
+    struct ibv_pd* pd = ibv_alloc_pd(context);
+    if (pd == nullptr) {
       throw InfinibandException("ibv_alloc_pd failed");
     }
 
-    cq_ = ibv_create_cq(context, num_cqe_, nullptr, nullptr, 0);
-    if (cq_ == nullptr) {
+    struct ibv_cq* cq = ibv_create_cq(context, num_cqe_, nullptr, nullptr, 0);
+    if (cq == nullptr) {
+      ibv_dealloc_pd(pd);
       throw InfinibandException("ibv_create_cq failed");
     }
 
-    if (ibv_req_notify_cq(cq_, 0)) {
+    devices_.push_back({context, pd, cq});
+
+    if (ibv_req_notify_cq(cq, 0)) {
       throw InfinibandException("ibv_req_notify_cq failed");
     }
+
+    return devices_.size() - 1;
   }
 
   const uint32_t num_cqe_ = 1000000;
 
-  /// InfiniBand protection domain.
-  struct ibv_pd* pd_ = nullptr;
-
-  /// InfiniBand completion queue
-  struct ibv_cq* cq_ = nullptr;
+  /// Verbs objects of all InfiniBand devices in use.
+  std::vector<DeviceContext> devices_;
 
   /// Vector of associated connection objects.
   std::vector<std::unique_ptr<CONNECTION>> conn_;
@@ -363,9 +381,6 @@ private:
   /// Completion notification event dispatcher. Called by the event loop.
   virtual void on_completion(const struct ibv_wc& wc) = 0;
 
-  /// InfiniBand verbs context
-  struct ibv_context* context_ = nullptr;
-
   struct rdma_cm_id* listen_id_ = nullptr;
 
   /// Total number of bytes transmitted.
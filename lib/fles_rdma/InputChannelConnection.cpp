@@ -172,14 +172,27 @@ void InputChannelConnection::inc_write_pointers(uint64_t data_size,
   cn_wp_.desc += desc_size;
 }
 
-bool InputChannelConnection::try_sync_buffer_positions() {
-  if (our_turn_) {
-    our_turn_ = false;
-    send_status_message_.wp = cn_wp_;
-    post_send_status_message();
-    return true;
+bool InputChannelConnection::try_sync_buffer_positions(
+    std::chrono::steady_clock::time_point now) {
+  if (!our_turn_) {
+    return false;
   }
-  return false;
+  StatusMessagePolicy::Positions desc{
+      cn_wp_.desc, send_status_message_.wp.desc, cn_ack_.desc,
+      UINT64_C(1) << remote_info_.desc_buffer_size_exp};
+  StatusMessagePolicy::Positions data{
+      cn_wp_.data, send_status_message_.wp.data, cn_ack_.data,
+      UINT64_C(1) << remote_info_.data_buffer_size_exp};
+  if (!status_requested_ &&
+      !status_policy_.due(desc, data, now - last_status_time_)) {
+    return false;
+  }
+  our_turn_ = false;
+  status_requested_ = false;
+  send_status_message_.wp = cn_wp_;
+  last_status_time_ = now;
+  post_send_status_message();
+  return true;
 }
 
 uint64_t InputChannelConnection::skip_required(uint64_t data_size) {
@@ -219,7 +232,9 @@ void InputChannelConnection::on_complete_recv() {
               << "receive completion, new cn_ack_.data="
               << recv_status_message_.ack.data;
   }
+  ++status_stats_.received;
   cn_ack_ = recv_status_message_.ack;
+  schedule_ = recv_status_message_.schedule;
   post_recv_status_message();
 
   if (cn_wp_ == send_status_message_.wp && finalize_) {
@@ -335,4 +350,5 @@ void InputChannelConnection::post_send_status_message() {
               << " wp.desc=" << send_status_message_.wp.desc << ")";
   }
   post_send(&send_wr);
+  ++status_stats_.sent;
 }
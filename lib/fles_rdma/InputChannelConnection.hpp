@@ -5,6 +5,8 @@
 #include "ComputeNodeStatusMessage.hpp"
 #include "IBConnection.hpp"
 #include "InputChannelStatusMessage.hpp"
+#include "StatusMessagePolicy.hpp"
+#include <chrono>
 
 /// Input node connection class.
 /** An InputChannelConnection object represents the endpoint of a single
@@ -43,12 +45,27 @@ public:
   // Get number of bytes to skip in advance (to avoid buffer wrap)
   uint64_t skip_required(uint64_t data_size);
 
-  bool try_sync_buffer_positions();
+  /// Send a status message if it is our turn and an update is due.
+  bool try_sync_buffer_positions(std::chrono::steady_clock::time_point now);
+
+  /// Send a status message on the next turn regardless of the policy.
+  void request_status_update() { status_requested_ = true; }
+
+  void set_status_message_policy(const StatusMessagePolicy& policy) {
+    status_policy_ = policy;
+  }
+
+  const StatusMessageStatistics& status_message_statistics() const {
+    return status_stats_;
+  }
 
   void finalize(bool abort);
 
   bool request_abort_flag() { return recv_status_message_.request_abort; }
 
+  /// Latest schedule announcement received from the compute node.
+  const ScheduleAnnouncement& schedule() const { return schedule_; }
+
   void on_complete_write();
 
   /// Handle Infiniband receive completion notification.
@@ -80,6 +97,17 @@ private:
   /// Flag, true if it is the input nodes's turn to send a pointer update.
   bool our_turn_ = true;
 
+  /// Decides when a pointer update is due.
+  StatusMessagePolicy status_policy_;
+
+  /// Flag, true if an update is due on the next turn.
+  bool status_requested_ = false;
+
+  /// Time of the last pointer update.
+  std::chrono::steady_clock::time_point last_status_time_;
+
+  StatusMessageStatistics status_stats_;
+
   bool finalize_ = false;
   bool abort_ = false;
 
@@ -89,6 +117,9 @@ private:
   /// Local copy of acknowledged-by-CN pointers
   ComputeNodeBufferPosition cn_ack_ = ComputeNodeBufferPosition();
 
+  /// Local copy of the schedule announcement of the CN
+  ScheduleAnnouncement schedule_ = ScheduleAnnouncement();
+
   /// Receive buffer for CN status (including acknowledged-by-CN pointers)
   ComputeNodeStatusMessage recv_status_message_ = ComputeNodeStatusMessage();
 
@@ -18,11 +18,16 @@ InputChannelSender::InputChannelSender(
     uint32_t timeslice_size,
     uint32_t overlap_size,
     uint32_t max_timeslice_number,
-    const std::string& monitor_uri)
+    const std::string& monitor_uri,
+    const std::string& scheduling_policy,
+    const std::vector<NetworkRail>& rails)
     : input_index_(input_index), data_source_(data_source),
       compute_hostnames_(compute_hostnames),
       compute_services_(compute_services), timeslice_size_(timeslice_size),
       overlap_size_(overlap_size), max_timeslice_number_(max_timeslice_number),
+      policy_(SchedulingPolicy::create(
+          scheduling_policy,
+          static_cast<uint32_t>(compute_hostnames.size()))),
       min_acked_desc_(data_source.desc_buffer().size() / 4),
       min_acked_data_(data_source.data_buffer().size() / 4) {
   start_index_desc_ = sent_desc_ = acked_desc_ = cached_acked_desc_ =
@@ -34,6 +39,18 @@ InputChannelSender::InputChannelSender(
       data_source_.desc_buffer().size() / timeslice_size_ + 1;
   ack_.alloc_with_size(min_ack_buffer_size);
 
+  conn_device_.resize(compute_hostnames.size());
+  if (!rails.empty()) {
+    int numa_node =
+        NetworkRail::numa_node_of_memory(data_source_.data_buffer().ptr());
+    rails_ = NetworkRail::select(rails, numa_node);
+    for (const auto& rail : rails_) {
+      L_(info) << "[i" << input_index_ << "] "
+               << "using rail " << rail.address() << " (NUMA node "
+               << rail.numa_node() << ", buffer on node " << numa_node << ")";
+    }
+  }
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
   VALGRIND_MAKE_MEM_DEFINED(data_source_.data_buffer().ptr(),
@@ -55,20 +72,22 @@ InputChannelSender::InputChannelSender(
 }
 
 InputChannelSender::~InputChannelSender() {
-  if (mr_desc_ != nullptr) {
-    ibv_dereg_mr(mr_desc_);
-    mr_desc_ = nullptr;
+  for (auto& mr : mr_desc_) {
+    if (mr != nullptr) {
+      ibv_dereg_mr(mr);
+      mr = nullptr;
+    }
   }
 
-  if (mr_data_ != nullptr) {
-    ibv_dereg_mr(mr_data_);
-    mr_data_ = nullptr;
+  for (auto& mr : mr_data_) {
+    if (mr != nullptr) {
+      ibv_dereg_mr(mr);
+      mr = nullptr;
+    }
   }
 }
 
 void InputChannelSender::report_status() {
-  constexpr auto interval = std::chrono::seconds(1);
-
   // if data_source.written pointers are lagging behind due to lazy updates,
   // use sent value instead
   uint64_t written_desc = data_source_.get_write_index().desc;
@@ -94,6 +113,15 @@ void InputChannelSender::report_status() {
                                sent_data_,
                                written_data};
 
+  metrics_.set_buffer_fill(
+      1.0 - status_data.percentage(status_data.unused()),
+      1.0 - status_desc.percentage(status_desc.unused()));
+  metrics_.telemetry().data.set(cached_acked_data_, written_data,
+                                data_source_.data_buffer().size());
+  metrics_.telemetry().desc.set(cached_acked_desc_, written_desc,
+                                data_source_.desc_buffer().size());
+  metrics_.update_rates();
+
   double delta_t =
       std::chrono::duration<double, std::chrono::seconds::period>(
           status_desc.time - previous_send_buffer_status_desc_.time)
@@ -107,6 +135,14 @@ void InputChannelSender::report_status() {
                           previous_send_buffer_status_data_.acked) /
       delta_t;
 
+  StatusMessageStatistics status_messages;
+  for (auto& c : conn_) {
+    status_messages += c->status_message_statistics();
+  }
+  double rate_status = static_cast<double>(status_messages.sent -
+                                           previous_status_messages_.sent) /
+                       delta_t;
+
   // retrieve SubsystemIdentifier from most current MicrosliceDescriptor
   fles::SubsystemIdentifier sys_id = static_cast<fles::SubsystemIdentifier>(0);
   if (written_desc > 0) {
@@ -124,6 +160,10 @@ void InputChannelSender::report_status() {
             << human_readable_count(status_data.acked, true) << " ("
             << human_readable_count(rate_data, true, "B/s") << ")";
 
+  L_(debug) << "[i" << input_index_ << "] status messages "
+            << human_readable_count(status_messages.sent, true, "") << " ("
+            << human_readable_count(rate_status, true, "Hz") << ")";
+
   L_(status) << "[i" << input_index_ << "]   |"
              << bar_graph(status_data.vector(), "#x._", 20) << "|"
              << bar_graph(status_desc.vector(), "#x._", 10) << "| "
@@ -160,7 +200,8 @@ void InputChannelSender::report_status() {
           "i,desc_sending=" + std::to_string(status_desc.sending()) +
           "i,desc_freeing=" + std::to_string(status_desc.freeing()) +
           "i,desc_free=" + std::to_string(status_desc.unused()) +
-          "i,desc_rate=" + std::to_string(rate_desc) + "\n";
+          "i,desc_rate=" + std::to_string(rate_desc) +
+          ",status_rate=" + std::to_string(rate_status) + "\n";
 
       auto task =
           monitor_client_
@@ -182,57 +223,67 @@ void InputChannelSender::report_status() {
 
   previous_send_buffer_status_desc_ = status_desc;
   previous_send_buffer_status_data_ = status_data;
+  previous_status_messages_ = status_messages;
 
-  scheduler_.add(std::bind(&InputChannelSender::report_status, this),
-                 now + interval);
+  if (trace_) {
+    trace_->flush();
+  }
 }
 
 void InputChannelSender::sync_buffer_positions() {
   for (auto& c : conn_) {
-    c->try_sync_buffer_positions();
+    c->try_sync_buffer_positions(scheduler_.now());
   }
-
-  auto now = std::chrono::system_clock::now();
-  scheduler_.add(std::bind(&InputChannelSender::sync_buffer_positions, this),
-                 now + std::chrono::milliseconds(0));
 }
 
-void InputChannelSender::sync_data_source(bool schedule) {
+void InputChannelSender::sync_data_source() {
   if (acked_data_ > cached_acked_data_ || acked_desc_ > cached_acked_desc_) {
     cached_acked_data_ = acked_data_;
     cached_acked_desc_ = acked_desc_;
     data_source_.set_read_index({cached_acked_desc_, cached_acked_data_});
   }
-
-  if (schedule) {
-    auto now = std::chrono::system_clock::now();
-    scheduler_.add(std::bind(&InputChannelSender::sync_data_source, this, true),
-                   now + std::chrono::milliseconds(100));
-  }
 }
 
 /// The thread main function.
 void InputChannelSender::operator()() {
   try {
-
-    connect();
-    while (connected_ != compute_hostnames_.size()) {
-      poll_cm_events();
+    start();
+    while (step()) {
     }
-    L_(info) << "[i" << input_index_ << "] "
-             << "connection to compute nodes established";
+    stop();
+  } catch (std::exception& e) {
+    L_(error) << "exception in InputChannelSender: " << e.what();
+  }
+}
 
-    data_source_.proceed();
-    time_begin_ = std::chrono::high_resolution_clock::now();
+void InputChannelSender::start() {
+  connect();
+  while (connected_ != compute_hostnames_.size()) {
+    poll_cm_events();
+  }
+  L_(info) << "[i" << input_index_ << "] "
+           << "connection to compute nodes established";
+  L_(debug) << "[i" << input_index_ << "] "
+            << "scheduling policy: " << policy_->description();
+
+  data_source_.proceed();
+  time_begin_ = std::chrono::high_resolution_clock::now();
+
+  scheduler_.timer();
+  sync_buffer_positions();
+  sync_data_source();
+  report_status();
+  scheduler_.add_periodic(sync_data_source_timer_,
+                          std::chrono::milliseconds(100));
+  scheduler_.add_periodic(report_status_timer_, std::chrono::seconds(1));
+}
 
-    uint64_t timeslice = 0;
-    sync_buffer_positions();
-    sync_data_source(true);
-    report_status();
-    while (timeslice < max_timeslice_number_ && !abort_) {
-      if (try_send_timeslice(timeslice)) {
-        timeslice++;
-        if (timeslice == 1) {
+bool InputChannelSender::step() {
+  if (!finalized_) {
+    if (timeslice_ < max_timeslice_number_ && !abort_) {
+      if (try_send_timeslice(timeslice_)) {
+        timeslice_++;
+        if (timeslice_ == 1) {
           L_(info) << "[i" << input_index_ << "] "
                    << "first timeslice processed";
         }
@@ -240,41 +291,65 @@ void InputChannelSender::operator()() {
       poll_completion();
       data_source_.proceed();
       scheduler_.timer();
+      sync_buffer_positions();
+      return true;
     }
 
     // wait for pending send completions
-    while (acked_desc_ < timeslice_size_ * timeslice + start_index_desc_) {
+    if (acked_desc_ < timeslice_size_ * timeslice_ + start_index_desc_) {
       poll_completion();
       scheduler_.timer();
+      sync_buffer_positions();
+      return true;
     }
-    sync_data_source(false);
+    sync_data_source();
 
     for (auto& c : conn_) {
       c->finalize(abort_);
     }
+    finalized_ = true;
 
     L_(debug) << "[i" << input_index_ << "] "
               << "SENDER loop done";
+  }
 
-    while (!all_done_) {
-      poll_completion();
-      scheduler_.timer();
-    }
+  if (!all_done_) {
+    poll_completion();
+    scheduler_.timer();
+    sync_buffer_positions();
+    return true;
+  }
+  time_end_ = std::chrono::high_resolution_clock::now();
+  return false;
+}
 
-    time_end_ = std::chrono::high_resolution_clock::now();
+void InputChannelSender::stop() {
+  // this should not be neccessary
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
-    // this should not be neccessary
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  disconnect();
+  while (connected_ != 0 || timewait_ != 0) {
+    poll_cm_events();
+  }
 
-    disconnect();
-    while (connected_ != 0 || timewait_ != 0) {
-      poll_cm_events();
+  summary();
+  if (rails_.size() > 1) {
+    std::vector<uint64_t> rail_bytes(rails_.size());
+    for (auto& c : conn_) {
+      rail_bytes[rail_index(c->index())] += c->total_bytes_sent();
     }
-
-    summary();
-  } catch (std::exception& e) {
-    L_(error) << "exception in InputChannelSender: " << e.what();
+    for (size_t r = 0; r < rails_.size(); ++r) {
+      L_(info) << "[i" << input_index_ << "] rail " << rails_[r].address()
+               << ": " << human_readable_count(rail_bytes[r]) << " sent";
+    }
+  }
+  StatusMessageStatistics status_messages;
+  for (auto& c : conn_) {
+    status_messages += c->status_message_statistics();
   }
+  L_(info) << "[i" << input_index_ << "] " << status_messages.sent
+           << " status messages sent, " << status_messages.received
+           << " received";
 }
 
 bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
@@ -287,6 +362,11 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
   }
   // check if microslice no. (desc_offset + desc_length - 1) is avail
   if (write_index_desc_ >= desc_offset + desc_length) {
+    if (trace_ && timeslice != trace_written_ts_) {
+      trace_written_ts_ = timeslice;
+      trace_->record(timeslice, TraceStage::InputWritten,
+                     static_cast<uint32_t>(input_index_));
+    }
 
     uint64_t data_offset = data_source_.desc_buffer().at(desc_offset).offset;
     uint64_t data_end =
@@ -307,6 +387,13 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
     }
 
     int cn = target_cn_index(timeslice);
+    if (cn < 0) {
+      // assignment not yet announced by all compute nodes
+      for (auto& c : conn_) {
+        c->request_status_update();
+      }
+      return false;
+    }
 
     if (!conn_[cn]->write_request_available()) {
       return false;
@@ -322,12 +409,25 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
                      data_length, skip);
 
       conn_[cn]->inc_write_pointers(total_length, 1);
+      if (trace_) {
+        trace_->record(timeslice, TraceStage::SendPosted,
+                       static_cast<uint32_t>(input_index_));
+      }
 
       sent_desc_ = desc_offset + desc_length;
       sent_data_ = data_end;
 
+      metrics_.add_timeslice(data_length +
+                             desc_length * sizeof(fles::MicrosliceDescriptor));
+
       return true;
     }
+    // blocked, ask the compute node for its acknowledged pointers
+    conn_[cn]->request_status_update();
+    if (timeslice != stalled_ts_) {
+      stalled_ts_ = timeslice;
+      metrics_.add_stall();
+    }
   }
 
   return false;
@@ -352,13 +452,28 @@ void InputChannelSender::connect() {
   for (unsigned int i = 0; i < compute_hostnames_.size(); ++i) {
     std::unique_ptr<InputChannelConnection> connection =
         create_input_node_connection(i);
-    connection->connect(compute_hostnames_[i], compute_services_[i]);
+    connection->connect(compute_hostnames_[i], compute_services_[i],
+                        rail_address(i));
     conn_.push_back(std::move(connection));
   }
 }
 
 int InputChannelSender::target_cn_index(uint64_t timeslice) {
-  return timeslice % conn_.size();
+  return policy_->target(timeslice);
+}
+
+size_t InputChannelSender::rail_index(uint_fast16_t index) const {
+  assert(!rails_.empty());
+  // alternate rails between compute nodes (and thereby timeslices), shifted
+  // by input index to balance rails across inputs
+  return (index + input_index_) % rails_.size();
+}
+
+std::string InputChannelSender::rail_address(uint_fast16_t index) const {
+  if (rails_.empty()) {
+    return std::string();
+  }
+  return rails_[rail_index(index)].address();
 }
 
 void InputChannelSender::dump_mr(struct ibv_mr* mr) {
@@ -373,29 +488,40 @@ void InputChannelSender::dump_mr(struct ibv_mr* mr) {
 void InputChannelSender::on_addr_resolved(struct rdma_cm_id* id) {
   IBConnectionGroup<InputChannelConnection>::on_addr_resolved(id);
 
-  if (mr_data_ == nullptr) {
-    // Register memory regions.
-    mr_data_ =
-        ibv_reg_mr(pd_, const_cast<uint8_t*>(data_source_.data_buffer().ptr()),
+  size_t device = device_index(id->verbs);
+  InputChannelConnection* conn =
+      static_cast<InputChannelConnection*>(id->context);
+  conn_device_.at(conn->index()) = device;
+
+  if (device >= mr_data_.size()) {
+    mr_data_.resize(device + 1, nullptr);
+    mr_desc_.resize(device + 1, nullptr);
+  }
+
+  if (mr_data_[device] == nullptr) {
+    // Register memory regions in the protection domain of the device.
+    struct ibv_pd* pd = devices_[device].pd;
+    mr_data_[device] =
+        ibv_reg_mr(pd, const_cast<uint8_t*>(data_source_.data_buffer().ptr()),
                    data_source_.data_buffer().bytes(), IBV_ACCESS_LOCAL_WRITE);
-    if (mr_data_ == nullptr) {
+    if (mr_data_[device] == nullptr) {
       L_(error) << "ibv_reg_mr failed for mr_data: " << strerror(errno);
       throw InfinibandException("registration of memory region failed");
     }
 
-    mr_desc_ =
-        ibv_reg_mr(pd_,
+    mr_desc_[device] =
+        ibv_reg_mr(pd,
                    const_cast<fles::MicrosliceDescriptor*>(
                        data_source_.desc_buffer().ptr()),
                    data_source_.desc_buffer().bytes(), IBV_ACCESS_LOCAL_WRITE);
-    if (mr_desc_ == nullptr) {
+    if (mr_desc_[device] == nullptr) {
       L_(error) << "ibv_reg_mr failed for mr_desc: " << strerror(errno);
       throw InfinibandException("registration of memory region failed");
     }
 
     if (true) {
-      dump_mr(mr_desc_);
-      dump_mr(mr_data_);
+      dump_mr(mr_desc_[device]);
+      dump_mr(mr_data_[device]);
     }
   }
 }
@@ -411,7 +537,8 @@ void InputChannelSender::on_rejected(struct rdma_cm_event* event) {
   // immediately initiate retry
   std::unique_ptr<InputChannelConnection> connection =
       create_input_node_connection(i);
-  connection->connect(compute_hostnames_[i], compute_services_[i]);
+  connection->connect(compute_hostnames_[i], compute_services_[i],
+                      rail_address(i));
   conn_.at(i) = std::move(connection);
 }
 
@@ -447,6 +574,9 @@ void InputChannelSender::post_send_data(uint64_t timeslice,
                                         uint64_t skip) {
   int num_sge = 0;
   struct ibv_sge sge[4];
+  size_t device = conn_device_[cn];
+  uint32_t desc_lkey = mr_desc_[device]->lkey;
+  uint32_t data_lkey = mr_data_[device]->lkey;
   // descriptors
   if ((desc_offset & data_source_.desc_buffer().size_mask()) <=
       ((desc_offset + desc_length - 1) &
@@ -455,7 +585,7 @@ void InputChannelSender::post_send_data(uint64_t timeslice,
     sge[num_sge].addr = reinterpret_cast<uintptr_t>(
         &data_source_.desc_buffer().at(desc_offset));
     sge[num_sge].length = sizeof(fles::MicrosliceDescriptor) * desc_length;
-    sge[num_sge++].lkey = mr_desc_->lkey;
+    sge[num_sge++].lkey = desc_lkey;
   } else {
     // two chunks
     sge[num_sge].addr = reinterpret_cast<uintptr_t>(
@@ -464,14 +594,14 @@ void InputChannelSender::post_send_data(uint64_t timeslice,
         sizeof(fles::MicrosliceDescriptor) *
         (data_source_.desc_buffer().size() -
          (desc_offset & data_source_.desc_buffer().size_mask()));
-    sge[num_sge++].lkey = mr_desc_->lkey;
+    sge[num_sge++].lkey = desc_lkey;
     sge[num_sge].addr =
         reinterpret_cast<uintptr_t>(data_source_.desc_buffer().ptr());
     sge[num_sge].length =
         sizeof(fles::MicrosliceDescriptor) *
         (desc_length - data_source_.desc_buffer().size() +
          (desc_offset & data_source_.desc_buffer().size_mask()));
-    sge[num_sge++].lkey = mr_desc_->lkey;
+    sge[num_sge++].lkey = desc_lkey;
   }
   // data
   if (data_length == 0) {
@@ -483,7 +613,7 @@ void InputChannelSender::post_send_data(uint64_t timeslice,
     sge[num_sge].addr = reinterpret_cast<uintptr_t>(
         &data_source_.data_buffer().at(data_offset));
     sge[num_sge].length = data_length;
-    sge[num_sge++].lkey = mr_data_->lkey;
+    sge[num_sge++].lkey = data_lkey;
   } else {
     // two chunks
     sge[num_sge].addr = reinterpret_cast<uintptr_t>(
@@ -491,13 +621,13 @@ void InputChannelSender::post_send_data(uint64_t timeslice,
     sge[num_sge].length =
         data_source_.data_buffer().size() -
         (data_offset & data_source_.data_buffer().size_mask());
-    sge[num_sge++].lkey = mr_data_->lkey;
+    sge[num_sge++].lkey = data_lkey;
     sge[num_sge].addr =
         reinterpret_cast<uintptr_t>(data_source_.data_buffer().ptr());
     sge[num_sge].length =
         data_length - data_source_.data_buffer().size() +
         (data_offset & data_source_.data_buffer().size_mask());
-    sge[num_sge++].lkey = mr_data_->lkey;
+    sge[num_sge++].lkey = data_lkey;
   }
 
   conn_[cn]->send_data(sge, num_sge, timeslice, desc_length, data_length, skip);
@@ -507,6 +637,10 @@ void InputChannelSender::on_completion(const struct ibv_wc& wc) {
   switch (wc.wr_id & 0xFF) {
   case ID_WRITE_DESC: {
     uint64_t ts = wc.wr_id >> 24;
+    if (trace_) {
+      trace_->record(ts, TraceStage::SendCompleted,
+                     static_cast<uint32_t>(input_index_));
+    }
 
     int cn = (wc.wr_id >> 8) & 0xFFFF;
     conn_[cn]->on_complete_write();
@@ -541,6 +675,7 @@ void InputChannelSender::on_completion(const struct ibv_wc& wc) {
   case ID_RECEIVE_STATUS: {
     int cn = wc.wr_id >> 8;
     conn_[cn]->on_complete_recv();
+    policy_->on_announcement(cn, conn_[cn]->schedule());
     if (conn_[cn]->request_abort_flag()) {
       abort_ = true;
     }
@@ -4,7 +4,11 @@
 #include "DualRingBuffer.hpp"
 #include "IBConnectionGroup.hpp"
 #include "InputChannelConnection.hpp"
+#include "Metrics.hpp"
+#include "NetworkRail.hpp"
 #include "RingBuffer.hpp"
+#include "SchedulingPolicy.hpp"
+#include "TraceRecorder.hpp"
 #include <boost/format.hpp>
 #include <cassert>
 #include <cpprest/http_client.h>
@@ -24,7 +28,10 @@ public:
                      uint32_t timeslice_size,
                      uint32_t overlap_size,
                      uint32_t max_timeslice_number,
-                     const std::string& monitor_uri);
+                     const std::string& monitor_uri,
+                     const std::string& scheduling_policy = "round-robin",
+                     const std::vector<NetworkRail>& rails =
+                         std::vector<NetworkRail>());
 
   InputChannelSender(const InputChannelSender&) = delete;
   void operator=(const InputChannelSender&) = delete;
@@ -35,10 +42,24 @@ public:
   void report_status();
 
   void sync_buffer_positions();
-  void sync_data_source(bool schedule);
+  void sync_data_source();
 
   void operator()() override;
 
+  /// Connect to the compute nodes and prepare the sender loop.
+  void start() override;
+
+  /// Perform one iteration of the sender loop, return false when done.
+  bool step() override;
+
+  /// Disconnect from the compute nodes and report statistics.
+  void stop() override;
+
+  /// Record the input and send trace points of this input channel.
+  void set_trace(std::unique_ptr<TraceRecorder> trace) {
+    trace_ = std::move(trace);
+  }
+
   /// The central function for distributing timeslice data.
   bool try_send_timeslice(uint64_t timeslice);
 
@@ -52,6 +73,13 @@ private:
   /// Return target computation node for given timeslice.
   int target_cn_index(uint64_t timeslice);
 
+  /// Return index of the rail used for a compute node connection.
+  size_t rail_index(uint_fast16_t index) const;
+
+  /// Return local address to connect to a compute node from (empty if
+  /// no rails are configured).
+  std::string rail_address(uint_fast16_t index) const;
+
   void dump_mr(struct ibv_mr* mr);
 
   void on_addr_resolved(struct rdma_cm_id* id) override;
@@ -76,11 +104,19 @@ private:
 
   uint64_t input_index_;
 
-  /// InfiniBand memory region descriptor for input data buffer.
-  struct ibv_mr* mr_data_ = nullptr;
+  /// InfiniBand memory region descriptors for input data buffer (one per
+  /// device).
+  std::vector<struct ibv_mr*> mr_data_;
+
+  /// InfiniBand memory region descriptors for input descriptor buffer (one
+  /// per device).
+  std::vector<struct ibv_mr*> mr_desc_;
 
-  /// InfiniBand memory region descriptor for input descriptor buffer.
-  struct ibv_mr* mr_desc_ = nullptr;
+  /// Local network rails, distributed over the compute node connections.
+  std::vector<NetworkRail> rails_;
+
+  /// Device index of each compute node connection.
+  std::vector<size_t> conn_device_;
 
   /// Buffer to store acknowledged status of timeslices.
   RingBuffer<uint64_t, true> ack_;
@@ -107,6 +143,9 @@ private:
   const uint32_t overlap_size_;
   const uint32_t max_timeslice_number_;
 
+  /// Assignment of timeslices to compute nodes.
+  std::unique_ptr<SchedulingPolicy> policy_;
+
   const uint64_t min_acked_desc_;
   const uint64_t min_acked_data_;
 
@@ -120,6 +159,12 @@ private:
 
   bool abort_ = false;
 
+  /// The next timeslice to send.
+  uint64_t timeslice_ = 0;
+
+  /// Flag indicating that all connections have been finalized.
+  bool finalized_ = false;
+
   std::unique_ptr<web::http::client::http_client> monitor_client_;
   std::unique_ptr<pplx::task<void>> monitor_task_;
   std::string hostname_;
@@ -178,4 +223,23 @@ private:
 
   SendBufferStatus previous_send_buffer_status_desc_ = SendBufferStatus();
   SendBufferStatus previous_send_buffer_status_data_ = SendBufferStatus();
+  StatusMessageStatistics previous_status_messages_ = StatusMessageStatistics();
+
+  /// Progress and buffer metrics of this input channel.
+  ComponentMetrics metrics_{"input", input_index_};
+
+  /// Optional timeslice trace recorder.
+  std::unique_ptr<TraceRecorder> trace_;
+
+  /// The last timeslice recorded as available in the input buffer.
+  uint64_t trace_written_ts_ = UINT64_MAX;
+
+  /// Last timeslice counted as stalled (blocked by a full buffer).
+  uint64_t stalled_ts_ = UINT64_MAX;
+
+  /// Timer for the periodic update of the data source read index.
+  Scheduler::Timer sync_data_source_timer_{[this] { sync_data_source(); }};
+
+  /// Timer for the periodic status report.
+  Scheduler::Timer report_status_timer_{[this] { report_status(); }};
 };
@@ -10,19 +10,23 @@
 #include <algorithm>
 #include <limits>
 
-TimesliceBuilder::TimesliceBuilder(uint64_t compute_index,
-                                   TimesliceBuffer& timeslice_buffer,
-                                   unsigned short service,
-                                   uint32_t num_input_nodes,
-                                   uint32_t timeslice_size,
-                                   volatile sig_atomic_t* signal_status,
-                                   bool drop,
-                                   const std::string& monitor_uri)
+TimesliceBuilder::TimesliceBuilder(
+    uint64_t compute_index,
+    TimesliceBuffer& timeslice_buffer,
+    unsigned short service,
+    uint32_t num_input_nodes,
+    uint32_t timeslice_size,
+    volatile sig_atomic_t* signal_status,
+    bool drop,
+    const std::string& monitor_uri,
+    std::unique_ptr<ScheduleAnnouncer> announcer)
     : compute_index_(compute_index), timeslice_buffer_(timeslice_buffer),
       service_(service), num_input_nodes_(num_input_nodes),
       timeslice_size_(timeslice_size),
       ack_(timeslice_buffer_.get_desc_size_exp()),
-      signal_status_(signal_status), drop_(drop) {
+      completion_time_(timeslice_buffer_.get_desc_size_exp()),
+      signal_status_(signal_status), drop_(drop),
+      announcer_(std::move(announcer)) {
   assert(timeslice_buffer_.get_num_input_nodes() == num_input_nodes);
 
   if (!monitor_uri.empty()) {
@@ -43,8 +47,6 @@ TimesliceBuilder::TimesliceBuilder(uint64_t compute_index,
 TimesliceBuilder::~TimesliceBuilder() = default;
 
 void TimesliceBuilder::report_status() {
-  constexpr auto interval = std::chrono::seconds(1);
-
   std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
 
   L_(debug) << "[c" << compute_index_ << "] " << completely_written_
@@ -142,6 +144,14 @@ void TimesliceBuilder::report_status() {
   auto total_status_desc = std::vector<double>{min_used_desc, mixed_desc,
                                                min_freeing_desc, min_free_desc};
 
+  if (!conn_.empty()) {
+    metrics_.set_buffer_fill(1. - min_free_data, 1. - min_free_desc);
+  }
+  metrics_.update_rates();
+  if (TraceRecorder* trace = timeslice_buffer_.trace()) {
+    trace->flush();
+  }
+
   L_(status) << "[c" << compute_index_ << "]   |"
              << bar_graph(total_status_data, "#=._", 20) << "|"
              << bar_graph(total_status_desc, "#=._", 10) << "| "
@@ -198,8 +208,6 @@ void TimesliceBuilder::report_status() {
     }
   }
 
-  scheduler_.add(std::bind(&TimesliceBuilder::report_status, this),
-                 now + interval);
 }
 
 void TimesliceBuilder::request_abort() {
@@ -226,6 +234,7 @@ void TimesliceBuilder::operator()() {
     time_begin_ = std::chrono::high_resolution_clock::now();
 
     report_status();
+    scheduler_.add_periodic(report_status_timer_, std::chrono::seconds(1));
     while (!all_done_ || connected_ != 0 || timewait_ != 0) {
       if (!all_done_) {
         poll_completion();
@@ -247,15 +256,24 @@ void TimesliceBuilder::operator()() {
     timeslice_buffer_.send_end_completion();
 
     summary();
+    timeslice_buffer_.log_consumer_statistics(
+        "[c" + std::to_string(compute_index_) + "] ");
+    L_(info) << "[c" << compute_index_ << "] " << ack_stats_.completions
+             << " completions in " << ack_stats_.batches << " batches, "
+             << ack_stats_.updates << " ack updates, latency mean "
+             << ack_stats_.mean_latency_us() << " us, max "
+             << std::chrono::duration<double, std::micro>(
+                    ack_stats_.latency_max)
+                    .count()
+             << " us";
   } catch (std::exception& e) {
     L_(error) << "exception in TimesliceBuilder: " << e.what();
   }
 }
 
 void TimesliceBuilder::on_connect_request(struct rdma_cm_event* event) {
-  if (pd_ == nullptr) {
-    init_context(event->id->verbs);
-  }
+  // connection requests may arrive on any local device
+  const DeviceContext& device = devices_.at(device_index(event->id->verbs));
 
   assert(event->param.conn.private_data_len >= sizeof(InputNodeInfo));
   InputNodeInfo remote_info =
@@ -272,7 +290,7 @@ void TimesliceBuilder::on_connect_request(struct rdma_cm_event* event) {
       timeslice_buffer_.get_desc_size_exp()));
   conn_.at(index) = std::move(conn);
 
-  conn_.at(index)->on_connect_request(event, pd_, cq_);
+  conn_.at(index)->on_connect_request(event, device.pd, device.cq);
 }
 
 /// Completion notification event dispatcher. Called by the event loop.
@@ -319,18 +337,41 @@ void TimesliceBuilder::on_completion(const struct ibv_wc& wc) {
 
       for (uint64_t tpos = completely_written_; tpos < new_completely_written;
            ++tpos) {
+        uint64_t ts_bytes = 0;
+        for (size_t c = 0; c < conn_.size(); ++c) {
+          ts_bytes += timeslice_buffer_.get_desc(c, tpos).size;
+        }
+        metrics_.add_timeslice(ts_bytes);
         if (!drop_) {
           uint64_t ts_index = UINT64_MAX;
           if (!conn_.empty()) {
             ts_index = timeslice_buffer_.get_desc(0, tpos).ts_num;
           }
+          if (TraceRecorder* trace = timeslice_buffer_.trace()) {
+            trace->record(ts_index, TraceStage::BuilderComplete,
+                          static_cast<uint32_t>(compute_index_));
+          }
           timeslice_buffer_.send_work_item(
               {{ts_index, tpos, timeslice_size_,
                 static_cast<uint32_t>(conn_.size())},
                timeslice_buffer_.get_data_size_exp(),
                timeslice_buffer_.get_desc_size_exp()});
         } else {
-          timeslice_buffer_.send_completion({tpos});
+          timeslice_buffer_.send_completion({tpos, UINT32_MAX});
+        }
+      }
+
+      if (announcer_ && new_completely_written > completely_written_) {
+        // announce weights for upcoming epochs based on buffer occupancy
+        double fill_level =
+            static_cast<double>(new_completely_written - acked_) /
+            static_cast<double>(UINT64_C(1)
+                                << timeslice_buffer_.get_desc_size_exp());
+        announcer_->update(
+            timeslice_buffer_.get_desc(0, new_completely_written - 1).ts_num,
+            fill_level);
+        for (auto& connection : conn_) {
+          connection->set_schedule(announcer_->announcement());
         }
       }
 
@@ -344,18 +385,39 @@ void TimesliceBuilder::on_completion(const struct ibv_wc& wc) {
 }
 
 void TimesliceBuilder::poll_ts_completion() {
+  auto now = std::chrono::steady_clock::now();
   fles::TimesliceCompletion c;
-  if (!timeslice_buffer_.try_receive_completion(c)) {
+  size_t count = 0;
+  while (count < max_completion_batch_ &&
+         timeslice_buffer_.try_receive_completion(c)) {
+    // mark as done, stale entries of the previous buffer cycle never match
+    ack_.at(c.ts_pos) = c.ts_pos + 1;
+    completion_time_.at(c.ts_pos) = now;
+    ++count;
+  }
+  if (count == 0) {
     return;
   }
-  if (c.ts_pos == acked_) {
-    do {
-      ++acked_;
-    } while (ack_.at(acked_) > c.ts_pos);
-    for (auto& connection : conn_) {
-      connection->inc_ack_pointers(acked_);
-    }
-  } else {
-    ack_.at(c.ts_pos) = c.ts_pos;
+  ack_stats_.completions += count;
+  ++ack_stats_.batches;
+
+  uint64_t new_acked = acked_;
+  while (ack_.at(new_acked) == new_acked + 1) {
+    ++new_acked;
+  }
+  if (new_acked == acked_) {
+    return;
+  }
+
+  // publish the whole advance as a single update per connection
+  now = std::chrono::steady_clock::now();
+  for (; acked_ < new_acked; ++acked_) {
+    auto latency = now - completion_time_.at(acked_);
+    ack_stats_.latency_sum += latency;
+    ack_stats_.latency_max = std::max(ack_stats_.latency_max, latency);
+  }
+  for (auto& connection : conn_) {
+    connection->inc_ack_pointers(acked_);
   }
+  ++ack_stats_.updates;
 }
@@ -3,9 +3,12 @@
 
 #include "ComputeNodeConnection.hpp"
 #include "IBConnectionGroup.hpp"
+#include "Metrics.hpp"
 #include "RingBuffer.hpp"
+#include "SchedulingPolicy.hpp"
 #include "TimesliceBuffer.hpp"
 #include <cpprest/http_client.h>
+#include <chrono>
 #include <csignal>
 #include <memory>
 #include <vector>
@@ -24,7 +27,8 @@ public:
                    uint32_t timeslice_size,
                    volatile sig_atomic_t* signal_status,
                    bool drop,
-                   const std::string& monitor_uri);
+                   const std::string& monitor_uri,
+                   std::unique_ptr<ScheduleAnnouncer> announcer = nullptr);
 
   TimesliceBuilder(const TimesliceBuilder&) = delete;
   void operator=(const TimesliceBuilder&) = delete;
@@ -44,8 +48,29 @@ public:
   /// Completion notification event dispatcher. Called by the event loop.
   void on_completion(const struct ibv_wc& wc) override;
 
+  /// Receive all pending timeslice completions and advance the
+  /// acknowledgement pointers of all connections once per batch.
   void poll_ts_completion();
 
+  /// Completion-to-acknowledgement latency statistics.
+  struct AckStatistics {
+    uint64_t completions = 0; ///< Timeslice completions received
+    uint64_t batches = 0;     ///< Non-empty completion batches
+    uint64_t updates = 0;     ///< Advances of the acknowledgement pointer
+    std::chrono::steady_clock::duration latency_sum{0};
+    std::chrono::steady_clock::duration latency_max{0};
+
+    double mean_latency_us() const {
+      if (completions == 0) {
+        return 0.0;
+      }
+      return std::chrono::duration<double, std::micro>(latency_sum).count() /
+             static_cast<double>(completions);
+    }
+  };
+
+  const AckStatistics& ack_statistics() const { return ack_stats_; }
+
 private:
   uint64_t compute_index_;
   TimesliceBuffer& timeslice_buffer_;
@@ -62,9 +87,26 @@ private:
   /// Buffer to store acknowledged status of timeslices.
   RingBuffer<uint64_t, true> ack_;
 
+  /// Maximum number of timeslice completions received per batch.
+  static constexpr size_t max_completion_batch_ = 1024;
+
+  /// Buffer to store the arrival time of timeslice completions.
+  RingBuffer<std::chrono::steady_clock::time_point> completion_time_;
+
+  AckStatistics ack_stats_;
+
   volatile sig_atomic_t* signal_status_;
   bool drop_;
 
+  /// Announces scheduling weights to the inputs (occupancy-aware policy).
+  std::unique_ptr<ScheduleAnnouncer> announcer_;
+
+  /// Progress and buffer metrics of this timeslice builder.
+  ComponentMetrics metrics_{"output", compute_index_};
+
+  /// Timer for the periodic status report.
+  Scheduler::Timer report_status_timer_{[this] { report_status(); }};
+
   std::vector<ComputeNodeConnection::BufferStatus>
       previous_recv_buffer_status_desc_;
   std::vector<ComputeNodeConnection::BufferStatus>
@@ -60,6 +60,7 @@ void ComponentSenderZeromq::run_begin() {
   data_source_.proceed();
   time_begin_ = std::chrono::high_resolution_clock::now();
   report_status();
+  scheduler_.add_periodic(report_status_timer_, std::chrono::seconds(1));
 }
 
 bool ComponentSenderZeromq::run_cycle() {
@@ -152,6 +153,9 @@ bool ComponentSenderZeromq::try_send_timeslice(uint64_t ts) {
     rc = zmq_msg_send(&data_msg, socket_, 0);
   } while (rc == -1 && errno == EAGAIN && *signal_status_ == 0);
 
+  metrics_.add_timeslice(data_length +
+                         desc_length * sizeof(fles::MicrosliceDescriptor));
+
   return true;
 }
 
@@ -221,8 +225,6 @@ void ComponentSenderZeromq::sync_data_source() {
 }
 
 void ComponentSenderZeromq::report_status() {
-  constexpr auto interval = std::chrono::seconds(1);
-
   std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
 
   DualIndex written = data_source_.get_write_index();
@@ -240,6 +242,15 @@ void ComponentSenderZeromq::report_status() {
                                sent_.data,
                                written.data};
 
+  metrics_.set_buffer_fill(
+      1.0 - status_data.percentage(status_data.unused()),
+      1.0 - status_desc.percentage(status_desc.unused()));
+  metrics_.telemetry().data.set(cached_acked_.data, written.data,
+                                data_source_.data_buffer().size());
+  metrics_.telemetry().desc.set(cached_acked_.desc, written.desc,
+                                data_source_.desc_buffer().size());
+  metrics_.update_rates();
+
   double delta_t =
       std::chrono::duration<double, std::chrono::seconds::period>(
           status_desc.time - previous_send_buffer_status_desc_.time)
@@ -272,6 +283,4 @@ void ComponentSenderZeromq::report_status() {
   previous_send_buffer_status_desc_ = status_desc;
   previous_send_buffer_status_data_ = status_data;
 
-  scheduler_.add(std::bind(&ComponentSenderZeromq::report_status, this),
-                 now + interval);
 }
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "DualRingBuffer.hpp"
+#include "Metrics.hpp"
 #include "RingBuffer.hpp"
 #include "Scheduler.hpp"
 #include <boost/format.hpp>
@@ -144,9 +145,15 @@ private:
   SendBufferStatus previous_send_buffer_status_desc_ = SendBufferStatus();
   SendBufferStatus previous_send_buffer_status_data_ = SendBufferStatus();
 
+  /// Progress and buffer metrics of this component sender.
+  ComponentMetrics metrics_{"input", input_index_};
+
   /// Scheduler for periodic events.
   Scheduler scheduler_;
 
+  /// Timer for the periodic status report.
+  Scheduler::Timer report_status_timer_{[this] { report_status(); }};
+
   /// Setup at begin of run.
   void run_begin();
 
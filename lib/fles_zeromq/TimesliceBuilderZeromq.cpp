@@ -6,6 +6,7 @@
 #include "TimesliceWorkItem.hpp"
 #include "Utility.hpp"
 #include "log.hpp"
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -68,6 +69,7 @@ void TimesliceBuilderZeromq::run_begin() {
   assert(!connections_.empty());
   time_begin_ = std::chrono::high_resolution_clock::now();
   report_status();
+  scheduler_.add_periodic(report_status_timer_, std::chrono::seconds(1));
 }
 
 bool TimesliceBuilderZeromq::run_cycle() {
@@ -148,6 +150,16 @@ bool TimesliceBuilderZeromq::run_cycle() {
 
     handle_timeslice_completions();
 
+    uint64_t ts_bytes = 0;
+    for (auto& conn : connections_) {
+      ts_bytes += conn->desc.at(tpos_).size;
+    }
+    metrics_.add_timeslice(ts_bytes);
+    if (TraceRecorder* trace = timeslice_buffer_.trace()) {
+      trace->record(ts_index_, TraceStage::BuilderComplete,
+                    static_cast<uint32_t>(compute_index_));
+    }
+
     timeslice_buffer_.send_work_item(
         {{ts_index_, tpos_, timeslice_size_,
           static_cast<uint32_t>(connections_.size())},
@@ -173,6 +185,8 @@ void TimesliceBuilderZeromq::run_end() {
   assert(timeslice_buffer_.get_num_completions() == 0);
   timeslice_buffer_.send_end_work_item();
   timeslice_buffer_.send_end_completion();
+  timeslice_buffer_.log_consumer_statistics(
+      "[c" + std::to_string(compute_index_) + "] ");
 }
 
 void TimesliceBuilderZeromq::handle_timeslice_completions() {
@@ -194,8 +208,6 @@ void TimesliceBuilderZeromq::handle_timeslice_completions() {
 }
 
 void TimesliceBuilderZeromq::report_status() {
-  constexpr auto interval = std::chrono::seconds(1);
-
   std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
 
   // FIXME: dummy code here...
@@ -232,6 +244,20 @@ void TimesliceBuilderZeromq::report_status() {
   previous_buffer_status_desc_ = status_desc;
   previous_buffer_status_data_ = status_data;
 
-  scheduler_.add(std::bind(&TimesliceBuilderZeromq::report_status, this),
-                 now + interval);
+  double data_fill = 0.;
+  double desc_fill = 0.;
+  for (auto& conn : connections_) {
+    data_fill = std::max(data_fill,
+                         static_cast<double>(conn->data.size_used()) /
+                             static_cast<double>(conn->data.size()));
+    desc_fill = std::max(desc_fill,
+                         static_cast<double>(conn->desc.size_used()) /
+                             static_cast<double>(conn->desc.size()));
+  }
+  metrics_.set_buffer_fill(data_fill, desc_fill);
+  metrics_.update_rates();
+
+  if (TraceRecorder* trace = timeslice_buffer_.trace()) {
+    trace->flush();
+  }
 }
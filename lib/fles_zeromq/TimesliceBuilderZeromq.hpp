@@ -2,6 +2,7 @@
 #pragma once
 
 #include "ManagedRingBuffer.hpp"
+#include "Metrics.hpp"
 #include "RingBuffer.hpp"
 #include "Scheduler.hpp"
 #include "TimesliceBuffer.hpp"
@@ -139,9 +140,15 @@ private:
   BufferStatus previous_buffer_status_desc_ = BufferStatus();
   BufferStatus previous_buffer_status_data_ = BufferStatus();
 
+  /// Progress and buffer metrics of this timeslice builder.
+  ComponentMetrics metrics_{"output", compute_index_};
+
   /// Scheduler for periodic events.
   Scheduler scheduler_;
 
+  /// Timer for the periodic status report.
+  Scheduler::Timer report_status_timer_{[this] { report_status(); }};
+
   /// Setup at begin of run.
   void run_begin();
 
@@ -0,0 +1,35 @@
+// Copyright 2026 agent <agent@local>
+
+#include "emu_device.hpp"
+#include <sstream>
+
+namespace flib {
+
+emu_device::emu_device(size_t num_links, emu_link_config config)
+    : m_config(config) {
+  for (size_t i = 0; i < num_links; ++i) {
+    m_link.push_back(std::unique_ptr<emu_link>(new emu_link(i, m_config)));
+  }
+}
+
+std::vector<emu_link*> emu_device::links() {
+  std::vector<emu_link*> links;
+  for (auto& l : m_link) {
+    links.push_back(l.get());
+  }
+  return links;
+}
+
+std::string emu_device::print_devinfo() {
+  std::stringstream ss;
+  ss << "software emulation, " << m_link.size() << " links, "
+     << m_config.content_size << " bytes per microslice, ";
+  if (m_config.rate > 0) {
+    ss << m_config.rate << " microslices/s per link";
+  } else {
+    ss << "unlimited rate";
+  }
+  return ss.str();
+}
+
+} // namespace flib
@@ -0,0 +1,35 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "emu_link.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace flib {
+
+/// Software emulation of a FLIB device.
+/** An emu_device provides a configurable number of emulated links, each of
+    them generating microslices in software. It can be used in place of a
+    flib_device to run and profile the shared memory server without FLIB
+    hardware. */
+
+class emu_device {
+
+public:
+  emu_device(size_t num_links, emu_link_config config);
+
+  emu_device(const emu_device&) = delete;
+  void operator=(const emu_device&) = delete;
+
+  size_t number_of_links() { return m_link.size(); }
+  std::vector<emu_link*> links();
+  emu_link* link(size_t n) { return m_link.at(n).get(); }
+
+  std::string print_devinfo();
+
+private:
+  std::vector<std::unique_ptr<emu_link>> m_link;
+  emu_link_config m_config;
+};
+} // namespace flib
@@ -0,0 +1,174 @@
+// Copyright 2026 agent <agent@local>
+
+#include "emu_dma_channel.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include "log.hpp"
+#include <cassert>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+
+namespace flib {
+
+emu_dma_channel::emu_dma_channel(size_t link_index,
+                                 void* data_buffer,
+                                 size_t data_buffer_log_size,
+                                 void* desc_buffer,
+                                 size_t desc_buffer_log_size,
+                                 size_t dma_transfer_size,
+                                 emu_link_config config)
+    : m_link_index(link_index),
+      m_data_buffer(reinterpret_cast<uint64_t*>(data_buffer)),
+      m_desc_buffer(desc_buffer), m_data_buffer_log_size(data_buffer_log_size),
+      m_desc_buffer_log_size(desc_buffer_log_size),
+      m_dma_transfer_size(dma_transfer_size), m_config(config) {
+  if (m_data_buffer_log_size < 3 ||
+      (UINT64_C(1) << m_data_buffer_log_size) <= m_dma_transfer_size) {
+    throw std::runtime_error("emulated data buffer too small");
+  }
+  if (m_desc_buffer_log_size < 6) {
+    throw std::runtime_error("emulated descriptor buffer too small");
+  }
+  m_config.content_size &= ~0x7u; // multiple of sizeof(uint64_t)
+
+  // initial read pointers as configured in the hardware
+  set_sw_read_pointers(
+      (UINT64_C(1) << m_data_buffer_log_size) - m_dma_transfer_size,
+      (UINT64_C(1) << m_desc_buffer_log_size) -
+          sizeof(fles::MicrosliceDescriptor));
+}
+
+emu_dma_channel::~emu_dma_channel() { set_enabled(false); }
+
+void emu_dma_channel::set_sw_read_pointers(uint64_t data_offset,
+                                           uint64_t desc_offset) {
+  assert(data_offset % m_dma_transfer_size == 0);
+  assert(desc_offset % sizeof(fles::MicrosliceDescriptor) == 0);
+
+  m_sw_read_data.store(data_offset, std::memory_order_release);
+  m_sw_read_desc.store(desc_offset, std::memory_order_release);
+}
+
+uint64_t emu_dma_channel::get_data_offset() {
+  return m_data_offset.load(std::memory_order_acquire) &
+         ((UINT64_C(1) << m_data_buffer_log_size) - 1);
+}
+
+uint64_t emu_dma_channel::get_desc_index() {
+  return m_desc_index.load(std::memory_order_acquire);
+}
+
+void emu_dma_channel::set_enabled(bool enable) {
+  if (enable == m_enabled) {
+    return;
+  }
+  m_enabled = enable;
+  if (enable) {
+    m_generator = std::thread(&emu_dma_channel::generate, this);
+  } else if (m_generator.joinable()) {
+    m_generator.join();
+  }
+}
+
+std::string emu_dma_channel::data_buffer_info() {
+  std::stringstream ss;
+  ss << "emulated data buffer: " << m_data_buffer << ", "
+     << (UINT64_C(1) << m_data_buffer_log_size) << " bytes";
+  return ss.str();
+}
+
+std::string emu_dma_channel::desc_buffer_info() {
+  std::stringstream ss;
+  ss << "emulated desc buffer: " << m_desc_buffer << ", "
+     << (UINT64_C(1) << m_desc_buffer_log_size) << " bytes";
+  return ss.str();
+}
+
+void emu_dma_channel::generate() {
+  L_(debug) << "emulated link " << m_link_index << ": generator started";
+
+  auto begin = std::chrono::steady_clock::now();
+  uint64_t count = 0;
+
+  while (m_enabled.load(std::memory_order_relaxed)) {
+    if (m_config.rate > 0) {
+      // rate limiting, generate all microslices that are due
+      auto due = begin + std::chrono::duration_cast<
+                             std::chrono::steady_clock::duration>(
+                             std::chrono::duration<double>(
+                                 static_cast<double>(count) / m_config.rate));
+      auto now = std::chrono::steady_clock::now();
+      if (now < due) {
+        std::this_thread::sleep_until(
+            std::min(due, now + std::chrono::milliseconds(1)));
+        continue;
+      }
+    }
+    if (write_microslice()) {
+      ++count;
+    } else {
+      // buffer full, the reader applies back pressure
+      std::this_thread::sleep_for(std::chrono::microseconds(10));
+    }
+  }
+
+  L_(debug) << "emulated link " << m_link_index << ": generator stopped after "
+            << count << " microslices";
+}
+
+bool emu_dma_channel::write_microslice() {
+  const uint64_t data_mask = (UINT64_C(1) << m_data_buffer_log_size) - 1;
+  const uint64_t desc_mask = (UINT64_C(1) << m_desc_buffer_log_size) /
+                                 sizeof(fles::MicrosliceDescriptor) -
+                             1;
+
+  const uint64_t data_offset = m_data_offset.load(std::memory_order_relaxed);
+  const uint64_t desc_index = m_desc_index.load(std::memory_order_relaxed);
+  const uint32_t size = m_config.content_size;
+
+  // free space up to the software read pointers, the write pointer never
+  // catches up with the read pointer so that equal pointers mean empty
+  const uint64_t read_data = m_sw_read_data.load(std::memory_order_acquire);
+  const uint64_t read_desc = m_sw_read_desc.load(std::memory_order_acquire) /
+                             sizeof(fles::MicrosliceDescriptor);
+  const uint64_t free_data = (read_data - data_offset - 1) & data_mask;
+  const uint64_t free_desc = (read_desc - desc_index - 1) & desc_mask;
+  if (size > free_data || free_desc == 0) {
+    return false;
+  }
+
+  // write to data buffer
+  uint32_t crc = 0x00000000;
+  if (m_config.pattern) {
+    for (uint64_t i = 0; i < size; i += sizeof(uint64_t)) {
+      uint64_t data_word = (static_cast<uint64_t>(m_link_index) << 48L) | i;
+      m_data_buffer[((data_offset + i) & data_mask) / sizeof(uint64_t)] =
+          data_word;
+      crc ^= (data_word & 0xffffffff) ^ (data_word >> 32L);
+    }
+  }
+
+  // write to descriptor buffer
+  const uint8_t hdr_id =
+      static_cast<uint8_t>(fles::HeaderFormatIdentifier::Standard);
+  const uint8_t hdr_ver =
+      static_cast<uint8_t>(fles::HeaderFormatVersion::Standard);
+  const uint16_t eq_id = static_cast<uint16_t>(0xE000 + m_link_index);
+  const uint16_t flags = 0x0000;
+  const uint8_t sys_id = static_cast<uint8_t>(fles::SubsystemIdentifier::FLES);
+  const uint8_t sys_ver = static_cast<uint8_t>(
+      m_config.pattern ? fles::SubsystemFormatFLES::BasicRampPattern
+                       : fles::SubsystemFormatFLES::Uninitialized);
+  reinterpret_cast<fles::MicrosliceDescriptor*>(
+      m_desc_buffer)[desc_index & desc_mask] =
+      fles::MicrosliceDescriptor({hdr_id, hdr_ver, eq_id, flags, sys_id,
+                                  sys_ver, desc_index, crc, size,
+                                  data_offset});
+
+  // publish, the descriptor count is read by the server
+  m_data_offset.store(data_offset + size, std::memory_order_release);
+  m_desc_index.store(desc_index + 1, std::memory_order_release);
+  return true;
+}
+
+} // namespace flib
@@ -0,0 +1,90 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace flib {
+
+/// Parameters of the software microslice generator of an emulated link.
+struct emu_link_config {
+  /// Content size of the generated microslices in bytes (multiple of 8).
+  uint32_t content_size = 1024;
+  /// Microslice rate per link in 1/s, zero means unlimited.
+  double rate = 0;
+  /// Fill the microslices with the FLES ramp pattern.
+  bool pattern = true;
+};
+
+/// Software emulation of the FLIB DMA engine.
+/** An emu_dma_channel writes microslices generated in software into regular
+    memory buffers. It follows the pointer semantics of the hardware DMA
+    engine: the descriptor count is read via get_desc_index(), buffer space
+    is released via set_sw_read_pointers() using byte offsets, and the data
+    read pointer has to be a multiple of the DMA transfer size. Data and
+    descriptors are only written into free buffer space, i.e., a slow reader
+    throttles the generator. */
+
+class emu_dma_channel {
+
+public:
+  emu_dma_channel(size_t link_index,
+                  void* data_buffer,
+                  size_t data_buffer_log_size,
+                  void* desc_buffer,
+                  size_t desc_buffer_log_size,
+                  size_t dma_transfer_size,
+                  emu_link_config config);
+
+  ~emu_dma_channel();
+
+  emu_dma_channel(const emu_dma_channel&) = delete;
+  void operator=(const emu_dma_channel&) = delete;
+
+  void set_sw_read_pointers(uint64_t data_offset, uint64_t desc_offset);
+
+  uint64_t get_data_offset();
+  uint64_t get_desc_index();
+
+  /// Start or stop the microslice generator thread.
+  void set_enabled(bool enable);
+
+  std::string data_buffer_info();
+  std::string desc_buffer_info();
+
+  void* data_buffer() const { return m_data_buffer; }
+  void* desc_buffer() const { return m_desc_buffer; }
+
+  size_t dma_transfer_size() { return m_dma_transfer_size; }
+
+private:
+  /// The generator thread main function.
+  void generate();
+
+  /// Write a single microslice if there is enough free buffer space.
+  bool write_microslice();
+
+  size_t m_link_index;
+  uint64_t* m_data_buffer;
+  void* m_desc_buffer;
+  size_t m_data_buffer_log_size;
+  size_t m_desc_buffer_log_size;
+  size_t m_dma_transfer_size;
+  emu_link_config m_config;
+
+  // software read pointers (byte offsets), set by the reader
+  std::atomic<uint64_t> m_sw_read_data{0};
+  std::atomic<uint64_t> m_sw_read_desc{0};
+
+  // hardware write pointers, data offset is an absolute byte index
+  std::atomic<uint64_t> m_data_offset{0};
+  std::atomic<uint64_t> m_desc_index{0};
+
+  std::atomic<bool> m_enabled{false};
+  std::thread m_generator;
+};
+
+} // namespace flib
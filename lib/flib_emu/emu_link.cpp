@@ -0,0 +1,42 @@
+// Copyright 2026 agent <agent@local>
+
+#include "emu_link.hpp"
+#include <stdexcept>
+
+#define DMA_TRANSFER_SIZE 128
+
+namespace flib {
+
+emu_link::emu_link(size_t link_index, emu_link_config config)
+    : m_link_index(link_index), m_config(config) {}
+
+emu_link::~emu_link() { deinit_dma(); }
+
+void emu_link::init_dma(void* data_buffer,
+                        size_t data_buffer_log_size,
+                        void* desc_buffer,
+                        size_t desc_buffer_log_size) {
+
+  m_dma_channel = std::unique_ptr<emu_dma_channel>(new emu_dma_channel(
+      m_link_index, data_buffer, data_buffer_log_size, desc_buffer,
+      desc_buffer_log_size, DMA_TRANSFER_SIZE, m_config));
+}
+
+void emu_link::deinit_dma() { m_dma_channel = nullptr; }
+
+void emu_link::enable_readout() {
+  if (m_data_sel != rx_disable) {
+    channel()->set_enabled(true);
+  }
+}
+
+void emu_link::disable_readout() { channel()->set_enabled(false); }
+
+emu_dma_channel* emu_link::channel() const {
+  if (m_dma_channel) {
+    return m_dma_channel.get();
+  }
+  throw std::runtime_error("DMA channel not initialized");
+}
+
+} // namespace flib
@@ -0,0 +1,56 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "emu_dma_channel.hpp"
+#include <iostream>
+#include <memory>
+
+namespace flib {
+
+/// Software emulation of a FLIB link.
+/** An emu_link provides the subset of the flib_link interface used by the
+    shared memory server. Its DMA channel is an emu_dma_channel, the data
+    source is always the internal pattern generator. */
+
+class emu_link {
+
+public:
+  emu_link(size_t link_index, emu_link_config config);
+  ~emu_link();
+
+  emu_link(const emu_link&) = delete;
+  void operator=(const emu_link&) = delete;
+
+  void init_dma(void* data_buffer,
+                size_t data_buffer_log_size,
+                void* desc_buffer,
+                size_t desc_buffer_log_size);
+
+  void deinit_dma();
+
+  typedef enum {
+    rx_disable = 0x0,
+    rx_emu = 0x1,
+    rx_link = 0x2,
+    rx_pgen = 0x3
+  } data_sel_t;
+
+  void set_data_sel(data_sel_t rx_sel) { m_data_sel = rx_sel; }
+  data_sel_t data_sel() { return m_data_sel; }
+
+  void enable_readout();
+  void disable_readout();
+
+  /*** Getter ***/
+  size_t link_index() { return m_link_index; };
+
+  emu_dma_channel* channel() const;
+
+private:
+  std::unique_ptr<emu_dma_channel> m_dma_channel;
+
+  size_t m_link_index = 0;
+  emu_link_config m_config;
+  data_sel_t m_data_sel = rx_pgen;
+};
+} // namespace flib
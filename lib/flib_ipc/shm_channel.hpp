@@ -4,12 +4,16 @@
 #pragma once
 
 #include "DualRingBuffer.hpp"
+#include <boost/date_time/gregorian/gregorian_types.hpp>
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/interprocess/managed_shared_memory.hpp>
 #include <boost/interprocess/sync/interprocess_condition.hpp>
 #include <boost/interprocess/sync/interprocess_mutex.hpp>
 #include <boost/interprocess/sync/scoped_lock.hpp>
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <thread>
 
 namespace ip = boost::interprocess;
 
@@ -50,81 +54,173 @@ public:
   size_t data_item_size() { return m_data_item_size; }
   size_t desc_item_size() { return m_desc_item_size; }
 
-  // getter / setter
-  bool req_read_index(ip::scoped_lock<ip::interprocess_mutex>& lock) {
-    assert(lock);
-    return m_req_read_index;
+  // Write and read indices are exchanged lock-free. Each component of an
+  // index only grows, so the components can be published individually. The
+  // writer publishes data before desc, the reader loads desc before data.
+  // This guarantees that the data of all visible descriptors is covered.
+
+  TimedDualIndex write_index() const {
+    TimedDualIndex write_index;
+    write_index.index.desc = m_write_index_desc.load(std::memory_order_acquire);
+    write_index.index.data = m_write_index_data.load(std::memory_order_acquire);
+    write_index.updated = from_us(m_write_index_updated.load());
+    return write_index;
   }
 
-  bool req_write_index(ip::scoped_lock<ip::interprocess_mutex>& lock) {
-    assert(lock);
-    return m_req_write_index;
+  void set_write_index(const TimedDualIndex write_index) {
+    m_write_index_data.store(write_index.index.data, std::memory_order_release);
+    m_write_index_desc.store(write_index.index.desc, std::memory_order_release);
+    m_write_index_updated.store(to_us(write_index.updated));
   }
 
-  void set_req_read_index(ip::scoped_lock<ip::interprocess_mutex>& lock,
-                          bool req) {
-    assert(lock);
-    m_req_read_index = req;
+  // The read index of the channel is the index up to which buffer space is
+  // released to the writer. It is the minimum of the read indices of all
+  // connected required readers. Lossy readers (e.g., monitoring taps) are not
+  // taken into account, they never hold back the writer. The device mutex is
+  // only needed to connect and disconnect readers.
+
+  DualIndex read_index() const {
+    DualIndex read_index;
+    read_index.desc = m_read_index_desc.load(std::memory_order_acquire);
+    read_index.data = m_read_index_data.load(std::memory_order_acquire);
+    return read_index;
   }
 
-  void set_req_write_index(ip::scoped_lock<ip::interprocess_mutex>& lock,
-                           bool req) {
-    assert(lock);
-    m_req_write_index = req;
+  DualIndex reader_index(size_t reader) const {
+    assert(reader < max_readers);
+    DualIndex read_index;
+    read_index.desc = m_readers[reader].desc.load(std::memory_order_acquire);
+    read_index.data = m_readers[reader].data.load(std::memory_order_acquire);
+    return read_index;
   }
 
-  TimedDualIndex write_index(ip::scoped_lock<ip::interprocess_mutex>& lock) {
-    assert(lock);
-    TimedDualIndex write_index = m_write_index;
-    return write_index;
+  void set_reader_index(size_t reader, const DualIndex read_index) {
+    assert(reader < max_readers);
+    m_readers[reader].data.store(read_index.data, std::memory_order_release);
+    m_readers[reader].desc.store(read_index.desc, std::memory_order_release);
   }
 
-  void set_write_index(ip::scoped_lock<ip::interprocess_mutex>& lock,
-                       const TimedDualIndex write_index) {
-    assert(lock);
-    m_write_index = write_index;
-    m_cond_write_index.notify_all();
+  // Recalculate the read index from the slowest required reader. This is
+  // lock-free, see connect() for a reader connecting concurrently.
+  DualIndex update_read_index() {
+    m_update_seq.fetch_add(1);
+    bool required_found = false;
+    DualIndex slowest{0, 0};
+    for (size_t i = 0; i < max_readers; ++i) {
+      if (!m_readers[i].connected.load() || m_readers[i].lossy.load()) {
+        continue;
+      }
+      DualIndex index = reader_index(i);
+      if (!required_found) {
+        slowest = index;
+        required_found = true;
+      } else {
+        slowest.desc = std::min(slowest.desc, index.desc);
+        slowest.data = std::min(slowest.data, index.data);
+      }
+    }
+    // keep released space if no required reader is connected
+    if (required_found) {
+      store_max(m_read_index_data, slowest.data);
+      store_max(m_read_index_desc, slowest.desc);
+    }
+    m_update_seq.fetch_add(1);
+    return read_index();
   }
 
-  DualIndex read_index(ip::scoped_lock<ip::interprocess_mutex>& lock) {
+  bool eof() const { return m_eof.load(); }
+
+  void set_eof(bool eof) { m_eof.store(eof); }
+
+  // Optional wakeup: waiting clients register themselves, the server only
+  // takes the lock to notify if there is a waiting client.
+  bool has_waiters() const { return m_waiters.load() != 0; }
+
+  bool wait_write_index(ip::scoped_lock<ip::interprocess_mutex>& lock,
+                        const boost::posix_time::ptime& abs_timeout) {
     assert(lock);
-    DualIndex read_index = m_read_index;
-    return read_index;
+    ++m_waiters;
+    bool ret = m_cond_write_index.timed_wait(lock, abs_timeout);
+    --m_waiters;
+    return ret;
   }
 
-  void set_read_index(ip::scoped_lock<ip::interprocess_mutex>& lock,
-                      const DualIndex read_index) {
+  void notify_write_index(ip::scoped_lock<ip::interprocess_mutex>& lock) {
     assert(lock);
-    m_read_index = read_index;
+    m_cond_write_index.notify_all();
   }
 
-  bool eof(ip::scoped_lock<ip::interprocess_mutex>& lock) {
+  // Connect a reader, returns the reader index or -1 if all slots are in use.
+  int connect(ip::scoped_lock<ip::interprocess_mutex>& lock, bool lossy) {
     assert(lock);
-    return m_eof;
+    for (size_t i = 0; i < max_readers; ++i) {
+      if (!m_readers[i].connected.load()) {
+        // start at the oldest data not yet released
+        set_reader_index(i, read_index());
+        m_readers[i].lossy.store(lossy);
+        m_readers[i].connected.store(true);
+        // an update running concurrently may have missed this reader and
+        // release space beyond its start, so wait for it to finish
+        uint64_t seq = m_update_seq.load();
+        if ((seq & 1) != 0) {
+          while (m_update_seq.load() == seq) {
+            std::this_thread::yield();
+          }
+        }
+        DualIndex index = reader_index(i);
+        DualIndex released = read_index();
+        index.desc = std::max(index.desc, released.desc);
+        index.data = std::max(index.data, released.data);
+        set_reader_index(i, index);
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
   }
 
-  void set_eof(ip::scoped_lock<ip::interprocess_mutex>& lock, bool eof) {
+  void disconnect(ip::scoped_lock<ip::interprocess_mutex>& lock,
+                  size_t reader) {
     assert(lock);
-    m_eof = eof;
+    assert(reader < max_readers);
+    // release the data consumed by this reader before it is disregarded
+    update_read_index();
+    m_readers[reader].connected.store(false);
   }
 
-  bool connect(ip::scoped_lock<ip::interprocess_mutex>& lock) {
-    assert(lock);
-    if (m_clients != 0) {
-      return false;
+  static constexpr size_t max_readers = 8;
+
+private:
+  static int64_t to_us(const boost::posix_time::ptime& time) {
+    if (time.is_neg_infinity()) {
+      return INT64_MIN;
     }
-    m_clients = 1;
-    return true;
+    if (time.is_pos_infinity()) {
+      return INT64_MAX;
+    }
+    return (time - epoch()).total_microseconds();
   }
 
-  void disconnect(ip::scoped_lock<ip::interprocess_mutex>& lock) {
-    assert(lock);
-    m_clients = 0;
+  static boost::posix_time::ptime from_us(int64_t us) {
+    if (us == INT64_MIN) {
+      return boost::posix_time::neg_infin;
+    }
+    if (us == INT64_MAX) {
+      return boost::posix_time::pos_infin;
+    }
+    return epoch() + boost::posix_time::microseconds(us);
   }
 
-  ip::interprocess_condition m_cond_write_index;
+  static boost::posix_time::ptime epoch() {
+    return boost::posix_time::ptime(boost::gregorian::date(1970, 1, 1));
+  }
+
+  // Advance an index component, never move it back.
+  static void store_max(std::atomic<uint64_t>& index, uint64_t value) {
+    uint64_t current = index.load();
+    while (current < value && !index.compare_exchange_weak(current, value)) {
+    }
+  }
 
-private:
   void set_buffer_handles(ip::managed_shared_memory* shm,
                           void* data_buffer,
                           void* desc_buffer) {
@@ -139,13 +235,31 @@ private:
   size_t m_data_item_size;
   size_t m_desc_item_size;
 
-  bool m_req_read_index = false;
-  bool m_req_write_index = false;
+  // INFO read index is not the actual hw value
+  std::atomic<uint64_t> m_read_index_desc{0};
+  std::atomic<uint64_t> m_read_index_data{0};
 
-  DualIndex m_read_index{0, 0}; // INFO not actual hw value
-  TimedDualIndex m_write_index{{0, 0}, boost::posix_time::neg_infin};
+  std::atomic<uint64_t> m_write_index_desc{0};
+  std::atomic<uint64_t> m_write_index_data{0};
+  std::atomic<int64_t> m_write_index_updated{INT64_MIN};
 
-  bool m_eof = false;
+  struct reader_slot {
+    std::atomic<bool> connected{false};
+    std::atomic<bool> lossy{false};
+    std::atomic<uint64_t> desc{0};
+    std::atomic<uint64_t> data{0};
+  };
+  reader_slot m_readers[max_readers];
+
+  // odd while the lock-free update of the read index (by the single writer)
+  // is in progress, updates by disconnect() hold the lock like connect()
+  std::atomic<uint64_t> m_update_seq{0};
+
+  std::atomic<bool> m_eof{false};
+
+  std::atomic<uint32_t> m_waiters{0};
+  ip::interprocess_condition m_cond_write_index;
 
-  size_t m_clients = 0;
+  // atomics are placed in shared memory and have to be address-free
+  static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "64 bit atomics not lock-free");
 };
@@ -4,12 +4,15 @@
 #include "shm_channel_client.hpp"
 #include "log.hpp"
 #include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <algorithm>
 #include <cassert>
 
 template <typename T_DESC, typename T_DATA>
 shm_channel_client<T_DESC, T_DATA>::shm_channel_client(
-    const std::shared_ptr<flib_shm_device_client>& dev, size_t index)
-    : m_dev(dev), m_shm(dev->shm()) {
+    const std::shared_ptr<flib_shm_device_client>& dev,
+    size_t index,
+    bool lossy)
+    : m_dev(dev), m_shm(dev->shm()), m_lossy(lossy) {
 
   // connect to global exchange object
   std::string device_name = "shm_device";
@@ -27,9 +30,12 @@ shm_channel_client<T_DESC, T_DATA>::shm_channel_client(
 
   {
     ip::scoped_lock<ip::interprocess_mutex> lock(m_shm_dev->m_mutex);
-    if (!m_shm_ch->connect(lock)) {
-      throw std::runtime_error("Channel " + channel_name + " already in use");
+    int reader = m_shm_ch->connect(lock, m_lossy);
+    if (reader < 0) {
+      throw std::runtime_error("Channel " + channel_name +
+                               " has no free reader slot");
     }
+    m_reader = static_cast<size_t>(reader);
   }
 
   if (m_shm_ch->desc_item_size() != sizeof(T_DESC) ||
@@ -56,7 +62,7 @@ template <typename T_DESC, typename T_DATA>
 shm_channel_client<T_DESC, T_DATA>::~shm_channel_client() {
   try {
     ip::scoped_lock<ip::interprocess_mutex> lock(m_shm_dev->m_mutex);
-    m_shm_ch->disconnect(lock);
+    m_shm_ch->disconnect(lock, m_reader);
   } catch (ip::interprocess_exception const& e) {
     L_(error) << "Failed to disconnect client: " << e.what();
   }
@@ -64,31 +70,32 @@ shm_channel_client<T_DESC, T_DATA>::~shm_channel_client() {
 
 template <typename T_DESC, typename T_DATA>
 void shm_channel_client<T_DESC, T_DATA>::set_read_index(DualIndex read_index) {
-  ip::scoped_lock<ip::interprocess_mutex> lock(m_shm_dev->m_mutex);
-  m_shm_ch->set_read_index(lock, read_index);
-  m_shm_ch->set_req_read_index(lock, true);
-  m_shm_dev->m_cond_req.notify_one();
+  // published lock-free, the server picks it up on its next poll
+  m_shm_ch->set_reader_index(m_reader, read_index);
 }
 
 template <typename T_DESC, typename T_DATA>
 DualIndex shm_channel_client<T_DESC, T_DATA>::get_read_index() {
-  ip::scoped_lock<ip::interprocess_mutex> lock(m_shm_dev->m_mutex);
-  return m_shm_ch->read_index(lock);
+  DualIndex read_index = m_shm_ch->reader_index(m_reader);
+  if (m_lossy) {
+    // data older than the released read index may have been overwritten
+    DualIndex released = m_shm_ch->read_index();
+    read_index.desc = std::max(read_index.desc, released.desc);
+    read_index.data = std::max(read_index.data, released.data);
+  }
+  return read_index;
 }
 
 template <typename T_DESC, typename T_DATA>
 void shm_channel_client<T_DESC, T_DATA>::update_write_index() {
-  ip::scoped_lock<ip::interprocess_mutex> lock(m_shm_dev->m_mutex);
-  m_shm_ch->set_req_write_index(lock, true);
+  // wake up the server in case it is idle
   m_shm_dev->m_cond_req.notify_one();
 }
 
 // get cached write_index
 template <typename T_DESC, typename T_DATA>
 TimedDualIndex shm_channel_client<T_DESC, T_DATA>::get_write_index_cached() {
-  // TODO(Dirk): could be a shared lock
-  ip::scoped_lock<ip::interprocess_mutex> lock(m_shm_dev->m_mutex);
-  return m_shm_ch->write_index(lock);
+  return m_shm_ch->write_index();
 }
 
 // get latest write_index (blocking)
@@ -97,11 +104,10 @@ std::pair<TimedDualIndex, bool>
 shm_channel_client<T_DESC, T_DATA>::get_write_index_latest(
     const boost::posix_time::ptime& abs_timeout) {
   ip::scoped_lock<ip::interprocess_mutex> lock(m_shm_dev->m_mutex);
-  m_shm_ch->set_req_write_index(lock, true);
   m_shm_dev->m_cond_req.notify_one();
-  bool ret = m_shm_ch->m_cond_write_index.timed_wait(lock, abs_timeout);
-  TimedDualIndex write_index = m_shm_ch->write_index(lock);
-  return std::make_pair(write_index, ret);
+  bool ret = m_shm_ch->wait_write_index(lock, abs_timeout);
+  lock.unlock();
+  return std::make_pair(m_shm_ch->write_index(), ret);
 }
 
 // get write_index newer than given relative timepoint (blocking)
@@ -119,20 +125,18 @@ shm_channel_client<T_DESC, T_DATA>::get_write_index_newer_than(
   if (ret.first.updated < abs_time) {
     ret = get_write_index_latest(abs_timeout);
   }
-  assert(!(ret.second && (ret.first.updated < abs_time)));
   return ret;
 }
 
 template <typename T_DESC, typename T_DATA>
 DualIndex shm_channel_client<T_DESC, T_DATA>::get_write_index() {
-  return get_write_index_newer_than(boost::posix_time::microseconds(1))
-      .first.index;
+  // the server publishes the write index continuously, no round trip needed
+  return get_write_index_cached().index;
 }
 
 template <typename T_DESC, typename T_DATA>
 bool shm_channel_client<T_DESC, T_DATA>::get_eof() {
-  ip::scoped_lock<ip::interprocess_mutex> lock(m_shm_dev->m_mutex);
-  return m_shm_ch->eof(lock);
+  return m_shm_ch->eof();
 }
 
 template class shm_channel_client<fles::MicrosliceDescriptor, uint8_t>;
@@ -20,8 +20,11 @@ template <typename T_DESC, typename T_DATA>
 class shm_channel_client : public DualRingBufferReadInterface<T_DESC, T_DATA> {
 
 public:
+  /// Connect to a channel. A lossy client does not hold back the writer, its
+  /// data may be overwritten if it falls behind (see get_read_index()).
   shm_channel_client(const std::shared_ptr<flib_shm_device_client>& dev,
-                     size_t index);
+                     size_t index,
+                     bool lossy = false);
   shm_channel_client(const shm_channel_client&) = delete;
   void operator=(const shm_channel_client&) = delete;
 
@@ -29,8 +32,12 @@ public:
 
   void set_read_index(DualIndex read_index) override;
 
+  /// Get the read index of this client. For a lossy client, this is advanced
+  /// to the oldest index that is still protected from being overwritten.
   DualIndex get_read_index() override;
 
+  bool lossy() const { return m_lossy; }
+
   void update_write_index();
 
   // get cached write_index
@@ -62,6 +69,8 @@ private:
   shm_device* m_shm_dev;
 
   shm_channel* m_shm_ch;
+  size_t m_reader = 0;
+  bool m_lossy;
   void* m_data_buffer;
   void* m_desc_buffer;
   size_t m_data_buffer_size_exp;
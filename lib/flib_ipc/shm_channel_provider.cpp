@@ -37,31 +37,29 @@ shm_channel_provider<T_DESC, T_DATA>::shm_channel_provider(
 
 template <typename T_DESC, typename T_DATA>
 DualIndex shm_channel_provider<T_DESC, T_DATA>::get_read_index() {
-  ip::scoped_lock<ip::interprocess_mutex> lock(shm_dev_->m_mutex);
-  shm_ch_->set_req_read_index(lock, false);
-  return shm_ch_->read_index(lock);
+  return shm_ch_->update_read_index();
 }
 
 template <typename T_DESC, typename T_DATA>
 void shm_channel_provider<T_DESC, T_DATA>::set_write_index(
     DualIndex new_write_index) {
   TimedDualIndex write_index = {new_write_index, boost::posix_time::pos_infin};
-  ip::scoped_lock<ip::interprocess_mutex> lock(shm_dev_->m_mutex);
-  shm_ch_->set_req_write_index(lock, false);
-  shm_ch_->set_write_index(lock, write_index);
+  shm_ch_->set_write_index(write_index);
+  if (shm_ch_->has_waiters()) {
+    ip::scoped_lock<ip::interprocess_mutex> lock(shm_dev_->m_mutex);
+    shm_ch_->notify_write_index(lock);
+  }
 }
 
 template <typename T_DESC, typename T_DATA>
 void shm_channel_provider<T_DESC, T_DATA>::set_eof(bool eof) {
-  ip::scoped_lock<ip::interprocess_mutex> lock(shm_dev_->m_mutex);
-  shm_ch_->set_eof(lock, eof);
+  shm_ch_->set_eof(eof);
 }
 
 template <typename T_DESC, typename T_DATA>
 DualIndex shm_channel_provider<T_DESC, T_DATA>::get_occupied_size() {
-  ip::scoped_lock<ip::interprocess_mutex> lock(shm_dev_->m_mutex);
-  DualIndex read_index = shm_ch_->read_index(lock);
-  DualIndex write_index = shm_ch_->write_index(lock).index;
+  DualIndex read_index = get_read_index();
+  DualIndex write_index = shm_ch_->write_index().index;
   return write_index - read_index;
 }
 
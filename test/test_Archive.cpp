@@ -6,6 +6,8 @@
 #include "MicrosliceOutputArchive.hpp"
 #include "TimesliceInputArchive.hpp"
 #include "TimesliceOutputArchive.hpp"
+#include <iterator>
+#include <vector>
 
 BOOST_AUTO_TEST_CASE(timeslice_output_archive_sequence_test) {
   fles::TimesliceInputArchiveLoop source("example1.tsa", 3);
@@ -73,3 +75,30 @@ BOOST_AUTO_TEST_CASE(microslice_input_archive_sequence_test) {
   }
   BOOST_CHECK_EQUAL(count, 8);
 }
+
+BOOST_AUTO_TEST_CASE(microslice_archive_batch_test) {
+  fles::MicrosliceInputArchiveSequence source("test3_%n.msa");
+  fles::MicrosliceOutputArchive sink("test5.msa");
+  std::vector<std::unique_ptr<fles::Microslice>> items;
+  std::vector<std::shared_ptr<const fles::Microslice>> batch;
+  uint64_t count = 0;
+  uint64_t batches = 0;
+  while (source.get_batch(items, 3) != 0) {
+    batch.assign(std::make_move_iterator(items.begin()),
+                 std::make_move_iterator(items.end()));
+    items.clear();
+    sink.put_batch(batch);
+    count += batch.size();
+    ++batches;
+  }
+  sink.end_stream();
+  BOOST_CHECK_EQUAL(count, 8);
+  BOOST_CHECK_EQUAL(batches, 3);
+
+  fles::MicrosliceInputArchive check("test5.msa");
+  count = 0;
+  while (auto microslice = check.get()) {
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(count, 8);
+}
@@ -3,14 +3,18 @@
 #include <boost/test/unit_test.hpp>
 
 #include "Filter.hpp"
+#include "FilterChain.hpp"
 #include "FilterExamples.hpp"
 #include "MicrosliceInputArchive.hpp"
 #include "MicrosliceOutputArchive.hpp"
 #include "Source.hpp"
+#include "ThreadedSource.hpp"
 #include <cstdint>
 #include <iostream>
 #include <limits>
+#include <stdexcept>
 #include <type_traits>
+#include <vector>
 
 // example source: integer counter
 template <typename T> class Counter : public fles::Source<T> {
@@ -76,6 +80,41 @@ private:
   }
 };
 
+// example source: microslices, remembering the last one returned
+class MicrosliceGenerator : public fles::Source<fles::Microslice> {
+public:
+  bool eos() const override { return false; }
+
+  fles::Microslice* last = nullptr;
+
+private:
+  fles::Microslice* do_get() override {
+    fles::MicrosliceDescriptor desc = fles::MicrosliceDescriptor();
+    desc.size = 16;
+    last = new fles::StorableMicroslice(desc, std::vector<uint8_t>(16));
+    return last;
+  }
+};
+
+// example source: integer counter failing after a given number of items
+class FailingCounter : public fles::Source<int> {
+public:
+  explicit FailingCounter(int arg_limit) : limit(arg_limit) {}
+
+  bool eos() const override { return false; }
+
+private:
+  int count = 0;
+  int limit;
+
+  int* do_get() override {
+    if (count == limit) {
+      throw std::runtime_error("counter failed");
+    }
+    return new int(count++);
+  }
+};
+
 BOOST_AUTO_TEST_CASE(int_filter_test) {
   Counter<int> counter(12);
 
@@ -178,3 +217,109 @@ BOOST_AUTO_TEST_CASE(filter_example3_test) {
 
   BOOST_CHECK_EQUAL(count, 4);
 }
+
+BOOST_AUTO_TEST_CASE(filter_chain_test) {
+  std::vector<int> results[2];
+  for (int threaded = 0; threaded < 2; ++threaded) {
+    Counter<int> counter(1000);
+    Doubler<int> doubler1;
+    PairAdder<int> pair_adder;
+    Doubler<int> doubler2;
+    std::size_t queue_capacity = threaded != 0 ? 4 : 0;
+
+    fles::FilterChain<int> chain(counter);
+    chain.add(doubler1, queue_capacity);
+    chain.add(pair_adder, queue_capacity);
+    chain.add(doubler2);
+
+    while (auto item = chain.get()) {
+      results[threaded].push_back(*item);
+    }
+    BOOST_CHECK(chain.eos());
+  }
+
+  BOOST_REQUIRE_EQUAL(results[0].size(), 500);
+  BOOST_CHECK_EQUAL(results[0][0], 4);
+  BOOST_CHECK_EQUAL(results[0][499], 4 * (998 + 999));
+  BOOST_CHECK(results[0] == results[1]);
+}
+
+BOOST_AUTO_TEST_CASE(filter_chain_example_test) {
+  fles::DescriptorOverrideFilter filter1(
+      static_cast<uint8_t>(fles::SubsystemIdentifier::FLES),
+      static_cast<uint8_t>(fles::SubsystemFormatFLES::Uninitialized));
+  fles::CombineContentsFilter filter2;
+
+  fles::MicrosliceInputArchive source("example2.msa");
+
+  fles::MicrosliceFilterChain chain(source);
+  chain.add(filter1, 2);
+  chain.add(filter2);
+
+  std::size_t count = 0;
+  while (auto item = chain.get()) {
+    BOOST_CHECK_EQUAL(item->desc().sys_id,
+                      static_cast<uint8_t>(fles::SubsystemIdentifier::FLES));
+    ++count;
+  }
+
+  BOOST_CHECK_EQUAL(count, 2);
+}
+
+BOOST_AUTO_TEST_CASE(filter_in_place_test) {
+  fles::DescriptorOverrideFilter filter(
+      static_cast<uint8_t>(fles::SubsystemIdentifier::FLES),
+      static_cast<uint8_t>(fles::SubsystemFormatFLES::Uninitialized));
+
+  MicrosliceGenerator source;
+  fles::FilteredMicrosliceSource filtered(source, filter);
+
+  // the microslice is handed over and modified without a copy
+  auto item = filtered.get();
+  BOOST_CHECK_EQUAL(item.get(), source.last);
+  BOOST_CHECK_EQUAL(item->desc().sys_id,
+                    static_cast<uint8_t>(fles::SubsystemIdentifier::FLES));
+}
+
+BOOST_AUTO_TEST_CASE(threaded_source_error_test) {
+  FailingCounter counter(10);
+  fles::ThreadedSource<int> source(counter, 4);
+
+  for (int i = 0; i < 10; ++i) {
+    auto item = source.get();
+    BOOST_REQUIRE(item);
+    BOOST_CHECK_EQUAL(*item, i);
+  }
+  BOOST_CHECK_THROW(source.get(), std::runtime_error);
+  BOOST_CHECK(source.eos());
+  BOOST_CHECK(!source.get());
+}
+
+BOOST_AUTO_TEST_CASE(default_batch_test) {
+  // the default adapter does not wait for further items (which might block
+  // on a live source)
+  Counter<int> source(5);
+  std::vector<std::unique_ptr<int>> items;
+  for (int i = 0; i < 5; ++i) {
+    BOOST_REQUIRE_EQUAL(source.get_batch(items, 4), 1);
+    BOOST_CHECK_EQUAL(*items.back(), i);
+  }
+  BOOST_CHECK_EQUAL(source.get_batch(items, 4), 0);
+  BOOST_CHECK_EQUAL(source.get_batch(items, 0), 0);
+}
+
+BOOST_AUTO_TEST_CASE(threaded_source_batch_test) {
+  Counter<int> counter(100);
+  fles::ThreadedSource<int> source(counter, 8);
+
+  std::vector<std::unique_ptr<int>> items;
+  std::size_t n;
+  while ((n = source.get_batch(items, 16)) != 0) {
+    BOOST_CHECK_LE(n, 16);
+  }
+  BOOST_CHECK(source.eos());
+  BOOST_REQUIRE_EQUAL(items.size(), 100);
+  for (int i = 0; i < 100; ++i) {
+    BOOST_CHECK_EQUAL(*items[i], i);
+  }
+}
@@ -0,0 +1,50 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_LatencyHistogram
+#include <boost/test/unit_test.hpp>
+
+#include "LatencyHistogram.hpp"
+
+using std::chrono::nanoseconds;
+
+BOOST_AUTO_TEST_CASE(bin_test) {
+  for (uint64_t value : {UINT64_C(0), UINT64_C(7), UINT64_C(8), UINT64_C(9),
+                         UINT64_C(1000), UINT64_C(123456789),
+                         UINT64_C(1) << 62}) {
+    size_t i = LatencyHistogram::bin(value);
+    BOOST_REQUIRE_LT(i, LatencyHistogram::num_bins);
+    BOOST_CHECK_LT(value, LatencyHistogram::bin_end(i));
+    if (i > 0) {
+      BOOST_CHECK_GE(value, LatencyHistogram::bin_end(i - 1));
+    }
+  }
+  BOOST_CHECK_EQUAL(LatencyHistogram::bin(UINT64_MAX),
+                    LatencyHistogram::num_bins - 1);
+  BOOST_CHECK_EQUAL(LatencyHistogram::bin_end(LatencyHistogram::num_bins - 1),
+                    UINT64_MAX);
+}
+
+BOOST_AUTO_TEST_CASE(quantile_test) {
+  LatencyHistogram h;
+  BOOST_CHECK_EQUAL(h.quantile(0.5).count(), 0);
+
+  for (int64_t i = 1; i <= 1000; ++i) {
+    h.add(nanoseconds(i * 1000));
+  }
+  BOOST_CHECK_EQUAL(h.count(), 1000);
+  BOOST_CHECK_EQUAL(h.max().count(), 1000000);
+  BOOST_CHECK_EQUAL(h.quantile(1.0).count(), 1000000);
+
+  // relative bin width is at most 1/8
+  auto median = static_cast<double>(h.quantile(0.5).count());
+  BOOST_CHECK_GE(median, 500000.0);
+  BOOST_CHECK_LE(median, 500000.0 * 1.125);
+  auto p99 = static_cast<double>(h.quantile(0.99).count());
+  BOOST_CHECK_GE(p99, 990000.0);
+  BOOST_CHECK_LE(p99, 1000000.0);
+
+  LatencyHistogram h2;
+  h2.add(nanoseconds(5000000));
+  h2 += h;
+  BOOST_CHECK_EQUAL(h2.count(), 1001);
+  BOOST_CHECK_EQUAL(h2.max().count(), 5000000);
+}
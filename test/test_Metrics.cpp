@@ -0,0 +1,166 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_Metrics
+#include <boost/test/unit_test.hpp>
+
+#include "Metrics.hpp"
+#include "MetricsExporter.hpp"
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+BOOST_AUTO_TEST_CASE(counter_and_gauge_test) {
+  auto& counter =
+      MetricsRegistry::get().counter("test_counter_total", {}, "A counter");
+  counter.add();
+  counter.add(41);
+  BOOST_CHECK_EQUAL(counter.value(), 42);
+
+  auto& gauge =
+      MetricsRegistry::get().gauge("test_gauge", {{"a", "1"}}, "A gauge");
+  gauge.set(0.5);
+  BOOST_CHECK_EQUAL(gauge.value(), 0.5);
+}
+
+BOOST_AUTO_TEST_CASE(registration_test) {
+  auto& a = MetricsRegistry::get().counter("test_dedup_total", {{"i", "0"}},
+                                           "Deduplicated counter");
+  auto& b = MetricsRegistry::get().counter("test_dedup_total", {{"i", "0"}},
+                                           "Deduplicated counter");
+  auto& c = MetricsRegistry::get().counter("test_dedup_total", {{"i", "1"}},
+                                           "Deduplicated counter");
+  BOOST_CHECK_EQUAL(&a, &b);
+  BOOST_CHECK_NE(&a, &c);
+  BOOST_CHECK_THROW(MetricsRegistry::get().gauge("test_dedup_total",
+                                                 {{"i", "0"}}, "Wrong type"),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(histogram_test) {
+  MetricHistogram h;
+  h.observe(std::chrono::nanoseconds(500));      // bucket 0 (1.024 us)
+  h.observe(std::chrono::microseconds(1));       // bucket 0 (1.024 us)
+  h.observe(std::chrono::microseconds(3));       // bucket 2 (4.096 us)
+  h.observe(std::chrono::milliseconds(1));       // bucket 10 (1.049 ms)
+  h.observe(std::chrono::hours(1));              // above all buckets
+  BOOST_CHECK_EQUAL(h.bucket(0), 2);
+  BOOST_CHECK_EQUAL(h.bucket(1), 0);
+  BOOST_CHECK_EQUAL(h.bucket(2), 1);
+  BOOST_CHECK_EQUAL(h.bucket(10), 1);
+  BOOST_CHECK_EQUAL(h.count(), 5);
+  BOOST_CHECK_CLOSE(h.sum(), 3600.0010045, 1e-9);
+
+  // the quantiles have the resolution of the LatencyHistogram bins
+  BOOST_CHECK_CLOSE(h.quantile(0.0), 512e-9, 1e-6);
+  BOOST_CHECK_CLOSE(h.quantile(0.5), 3072e-9, 1e-6);
+  BOOST_CHECK_CLOSE(h.quantile(1.0), 3600.0, 1e-6);
+
+  LatencyHistogram snapshot = h.snapshot();
+  BOOST_CHECK_EQUAL(snapshot.count(), 5);
+  BOOST_CHECK(snapshot.max() == std::chrono::hours(1));
+  BOOST_CHECK(snapshot.quantile(0.5) == std::chrono::nanoseconds(3072));
+}
+
+BOOST_AUTO_TEST_CASE(prometheus_format_test) {
+  MetricsRegistry::get()
+      .counter("test_prom_total", {{"kind", "x\"y"}}, "Escaped label")
+      .add(3);
+  MetricsRegistry::get()
+      .histogram("test_prom_seconds", {}, "A histogram")
+      .observe(std::chrono::microseconds(2));
+
+  std::ostringstream out;
+  MetricsRegistry::get().write_prometheus(out);
+  std::string s = out.str();
+
+  BOOST_CHECK(s.find("# TYPE test_prom_total counter\n") != std::string::npos);
+  BOOST_CHECK(s.find("test_prom_total{kind=\"x\\\"y\"} 3\n") !=
+              std::string::npos);
+  BOOST_CHECK(s.find("# TYPE test_prom_seconds histogram\n") !=
+              std::string::npos);
+  BOOST_CHECK(s.find("test_prom_seconds_bucket{le=\"1.024e-06\"} 0\n") !=
+              std::string::npos);
+  BOOST_CHECK(s.find("test_prom_seconds_bucket{le=\"2.048e-06\"} 1\n") !=
+              std::string::npos);
+  BOOST_CHECK(s.find("test_prom_seconds_bucket{le=\"+Inf\"} 1\n") !=
+              std::string::npos);
+  BOOST_CHECK(s.find("test_prom_seconds_count 1\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(influx_format_test) {
+  MetricsRegistry::get()
+      .counter("test_influx_total", {{"host", "a b"}}, "Influx counter")
+      .add(7);
+
+  std::ostringstream out;
+  MetricsRegistry::get().write_influx(
+      out, std::chrono::system_clock::time_point(std::chrono::seconds(1)));
+  BOOST_CHECK(out.str().find("test_influx_total,host=a\\ b value=7i "
+                             "1000000000\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(influx_non_finite_test) {
+  MetricsRegistry::get()
+      .histogram("test_influx_seconds", {}, "Influx histogram")
+      .observe(std::chrono::hours(1));
+  MetricsRegistry::get()
+      .gauge("test_influx_nan", {}, "Influx gauge")
+      .set(std::numeric_limits<double>::quiet_NaN());
+
+  std::ostringstream out;
+  MetricsRegistry::get().write_influx(
+      out, std::chrono::system_clock::time_point(std::chrono::seconds(1)));
+  std::string s = out.str();
+  // the quantiles are bounded by the maximum value, even above the buckets
+  BOOST_CHECK(s.find("test_influx_seconds count=1i,sum=3600,p50=3600,"
+                     "p99=3600 1000000000\n") != std::string::npos);
+  // a line without any finite field is omitted
+  BOOST_CHECK(s.find("test_influx_nan") == std::string::npos);
+  BOOST_CHECK(s.find("=inf") == std::string::npos);
+  BOOST_CHECK(s.find("nan ") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(component_metrics_test) {
+  ComponentMetrics metrics("input", 7);
+  metrics.add_timeslice(100);
+  metrics.add_timeslice(200, 2);
+  metrics.set_buffer_fill(0.25, 0.5);
+
+  std::ostringstream out;
+  MetricsRegistry::get().write_prometheus(out);
+  std::string s = out.str();
+  BOOST_CHECK(
+      s.find("flesnet_timeslices_total{component=\"input\",index=\"7\"} 3\n") !=
+      std::string::npos);
+  BOOST_CHECK(
+      s.find("flesnet_bytes_total{component=\"input\",index=\"7\"} 300\n") !=
+      std::string::npos);
+  BOOST_CHECK(s.find("flesnet_buffer_fill{component=\"input\",index=\"7\","
+                     "buffer=\"desc\"} 0.5\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(file_exporter_test) {
+  MetricsRegistry::get()
+      .counter("test_file_total", {}, "File exporter counter")
+      .add(5);
+
+  std::string path = "test_Metrics.prom";
+  {
+    auto exporter = MetricsExporter::create("file://" + path);
+  }
+  std::ifstream in(path);
+  std::stringstream content;
+  content << in.rdbuf();
+  BOOST_CHECK(content.str().find("test_file_total 5\n") != std::string::npos);
+  std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(invalid_uri_test) {
+  BOOST_CHECK_THROW(MetricsExporter::create("metrics"), std::runtime_error);
+  BOOST_CHECK_THROW(MetricsExporter::create("ftp://host:1"),
+                    std::runtime_error);
+  BOOST_CHECK_THROW(MetricsExporter::create("udp://localhost"),
+                    std::runtime_error);
+}
@@ -5,7 +5,98 @@
 #include "FlesnetPatternGenerator.hpp"
 #include "MicrosliceOutputArchive.hpp"
 #include "MicrosliceReceiver.hpp"
+#include "MicrosliceTransmitter.hpp"
+#include "RingBuffer.hpp"
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+/// In-memory buffer connecting a transmitter to a receiver.
+class LoopbackBuffer : public InputBufferReadInterface,
+                       public InputBufferWriteInterface {
+public:
+  LoopbackBuffer(std::size_t data_buffer_size_exp,
+                 std::size_t desc_buffer_size_exp)
+      : data_buffer_(data_buffer_size_exp), desc_buffer_(desc_buffer_size_exp),
+        data_buffer_view_(data_buffer_.ptr(), data_buffer_size_exp),
+        desc_buffer_view_(desc_buffer_.ptr(), desc_buffer_size_exp) {}
+
+  RingBufferView<uint8_t>& data_buffer() override { return data_buffer_view_; }
+
+  RingBufferView<fles::MicrosliceDescriptor>& desc_buffer() override {
+    return desc_buffer_view_;
+  }
+
+  DualIndex get_write_index() override { return write_index_; }
+  void set_write_index(DualIndex new_write_index) override {
+    write_index_ = new_write_index;
+    ++write_index_updates;
+  }
+
+  DualIndex get_read_index() override { return read_index_; }
+  void set_read_index(DualIndex new_read_index) override {
+    read_index_ = new_read_index;
+    ++read_index_updates;
+  }
+
+  bool get_eof() override { return eof_; }
+  void set_eof(bool eof) override { eof_ = eof; }
+
+  uint64_t write_index_updates = 0;
+  uint64_t read_index_updates = 0;
+
+private:
+  RingBuffer<uint8_t> data_buffer_;
+  RingBuffer<fles::MicrosliceDescriptor, true> desc_buffer_;
+  RingBufferView<uint8_t> data_buffer_view_;
+  RingBufferView<fles::MicrosliceDescriptor> desc_buffer_view_;
+
+  DualIndex write_index_ = {0, 0};
+  DualIndex read_index_ = {0, 0};
+  bool eof_ = false;
+};
+
+/// Loopback buffer simulating a lossy writer that releases and overwrites
+/// a microslice while the receiver reads its descriptor.
+class OverwritingBuffer : public LoopbackBuffer {
+public:
+  using LoopbackBuffer::LoopbackBuffer;
+
+  RingBufferView<fles::MicrosliceDescriptor>& desc_buffer() override {
+    if (overwrite_) {
+      overwrite_ = false;
+      set_read_index(released_);
+    }
+    return LoopbackBuffer::desc_buffer();
+  }
+
+  /// Release the data up to a given index on the next descriptor access.
+  void overwrite_on_read(DualIndex released) {
+    overwrite_ = true;
+    released_ = released;
+  }
+
+private:
+  bool overwrite_ = false;
+  DualIndex released_ = {0, 0};
+};
+
+/// Write a microslice with a given index and content size.
+void put_microslice(fles::MicrosliceTransmitter& transmitter,
+                    uint64_t idx,
+                    uint32_t size) {
+  fles::MicrosliceDescriptor desc{};
+  desc.idx = idx;
+  desc.size = size;
+  transmitter.put(std::make_shared<fles::StorableMicroslice>(
+      desc, std::vector<uint8_t>(size, 0xab)));
+}
+
+} // namespace
 
 BOOST_AUTO_TEST_CASE(usage_test) {
   uint32_t typical_content_size = 10000;
@@ -34,3 +125,88 @@ BOOST_AUTO_TEST_CASE(usage_test) {
 
   BOOST_CHECK_EQUAL(count, 1000);
 }
+
+BOOST_AUTO_TEST_CASE(batch_test) {
+  // small buffers, so that the content of some microslices wraps around
+  constexpr std::size_t data_buffer_size_exp = 16; // 64 kiB
+  constexpr std::size_t desc_buffer_size_exp = 8;  // 256 entries
+  constexpr uint32_t content_size = 1000;
+  constexpr std::size_t batch_size = 20;
+
+  FlesnetPatternGenerator reference_source(
+      data_buffer_size_exp, desc_buffer_size_exp, 0, content_size, true);
+  FlesnetPatternGenerator batch_source(
+      data_buffer_size_exp, desc_buffer_size_exp, 0, content_size, true);
+  fles::MicrosliceReceiver reference(reference_source);
+  fles::MicrosliceReceiver receiver(batch_source);
+
+  // pass the microslices through a transmitter and a loopback buffer
+  LoopbackBuffer loopback(data_buffer_size_exp, desc_buffer_size_exp);
+  fles::MicrosliceTransmitter transmitter(loopback);
+  fles::MicrosliceReceiver loopback_receiver(loopback);
+
+  std::vector<std::unique_ptr<fles::Microslice>> items;
+  std::vector<std::shared_ptr<const fles::Microslice>> batch;
+  for (int i = 0; i < 100; ++i) {
+    items.clear();
+    BOOST_REQUIRE_GT(receiver.get_batch(items, batch_size), 0);
+    batch.assign(std::make_move_iterator(items.begin()),
+                 std::make_move_iterator(items.end()));
+    transmitter.put_batch(batch);
+
+    items.clear();
+    BOOST_REQUIRE_EQUAL(loopback_receiver.get_batch(items, batch_size + 1),
+                        batch.size());
+    for (const auto& ms : items) {
+      auto expected = reference.get();
+      BOOST_REQUIRE(expected);
+      BOOST_CHECK_EQUAL(ms->desc().idx, expected->desc().idx);
+      BOOST_REQUIRE_EQUAL(ms->desc().size, expected->desc().size);
+      BOOST_CHECK(std::equal(ms->content(), ms->content() + ms->desc().size,
+                             expected->content()));
+    }
+  }
+
+  // one index update per batch
+  BOOST_CHECK_EQUAL(loopback.write_index_updates, 100);
+  BOOST_CHECK_EQUAL(loopback.read_index_updates, 100);
+
+  transmitter.end_stream();
+  items.clear();
+  BOOST_CHECK_EQUAL(loopback_receiver.get_batch(items, batch_size), 0);
+  BOOST_CHECK(loopback_receiver.eos());
+}
+
+BOOST_AUTO_TEST_CASE(overwritten_descriptor_test) {
+  OverwritingBuffer buffer(12, 4);
+  fles::MicrosliceTransmitter transmitter(buffer);
+  fles::MicrosliceReceiver receiver(buffer);
+  const uint32_t size = 100;
+
+  // single microslices: the descriptor of the first one is overwritten with
+  // a bogus size while it is read, the copy must be discarded
+  put_microslice(transmitter, 0, size);
+  put_microslice(transmitter, 1, size);
+  buffer.desc_buffer().at(0).size = UINT32_MAX;
+  buffer.overwrite_on_read({1, size});
+  auto ms = receiver.get();
+  BOOST_REQUIRE(ms);
+  BOOST_CHECK_EQUAL(ms->desc().idx, 1);
+  BOOST_CHECK_EQUAL(receiver.skipped(), 1);
+
+  // batches: the batch ends before the bogus descriptor
+  put_microslice(transmitter, 2, size);
+  put_microslice(transmitter, 3, size);
+  put_microslice(transmitter, 4, size);
+  buffer.desc_buffer().at(3).size = UINT32_MAX;
+  buffer.overwrite_on_read({4, 4 * size});
+  std::vector<std::unique_ptr<fles::Microslice>> items;
+  BOOST_REQUIRE_EQUAL(receiver.get_batch(items, 10), 1);
+  BOOST_CHECK_EQUAL(items.at(0)->desc().idx, 4);
+  BOOST_CHECK_EQUAL(receiver.skipped(), 3);
+
+  // a bogus descriptor in data that has not been released is an error
+  put_microslice(transmitter, 5, size);
+  buffer.desc_buffer().at(5).size = UINT32_MAX;
+  BOOST_CHECK_THROW(receiver.get(), std::runtime_error);
+}
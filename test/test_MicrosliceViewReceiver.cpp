@@ -0,0 +1,74 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_MicrosliceViewReceiver
+#include <boost/test/unit_test.hpp>
+
+#include "FlesnetPatternGenerator.hpp"
+#include "MicrosliceReceiver.hpp"
+#include "MicrosliceViewReceiver.hpp"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// small buffers, so that the content of some microslices wraps around
+constexpr std::size_t data_buffer_size_exp = 16; // 64 kiB
+constexpr std::size_t desc_buffer_size_exp = 8;  // 256 entries
+constexpr uint32_t content_size = 1000;
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(content_test) {
+  FlesnetPatternGenerator copy_source(data_buffer_size_exp,
+                                      desc_buffer_size_exp, 0, content_size,
+                                      true);
+  FlesnetPatternGenerator view_source(data_buffer_size_exp,
+                                      desc_buffer_size_exp, 0, content_size,
+                                      true);
+  fles::MicrosliceReceiver copy_receiver(copy_source);
+  fles::MicrosliceViewReceiver view_receiver(view_source);
+
+  for (int i = 0; i < 1000; ++i) {
+    auto expected = copy_receiver.get();
+    auto ms = view_receiver.get();
+    BOOST_REQUIRE(expected);
+    BOOST_REQUIRE(ms);
+    BOOST_CHECK_EQUAL(ms->desc().idx, expected->desc().idx);
+    BOOST_REQUIRE_EQUAL(ms->desc().size, expected->desc().size);
+    BOOST_CHECK(std::equal(ms->content(), ms->content() + ms->desc().size,
+                           expected->content()));
+  }
+
+  BOOST_CHECK_GT(view_receiver.copied(), 0);
+  BOOST_CHECK_EQUAL(view_receiver.outstanding(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(release_test) {
+  FlesnetPatternGenerator source(data_buffer_size_exp, desc_buffer_size_exp,
+                                 0, content_size, true);
+  fles::MicrosliceViewReceiver receiver(source);
+
+  std::vector<std::unique_ptr<fles::Microslice>> views;
+  for (int i = 0; i < 10; ++i) {
+    views.push_back(receiver.get());
+  }
+  BOOST_CHECK_EQUAL(receiver.copied(), 0);
+  BOOST_CHECK_EQUAL(receiver.outstanding(), 10);
+  const uint8_t* first_content = views[0]->content();
+
+  // release all but the first microslice
+  while (views.size() > 1) {
+    views.pop_back();
+  }
+  views.push_back(receiver.get());
+  BOOST_CHECK_EQUAL(receiver.outstanding(), 2);
+  BOOST_CHECK_EQUAL(source.get_read_index().desc, 0);
+  BOOST_CHECK_EQUAL(views[0]->content(), first_content);
+
+  // releasing the first microslice releases the following as well
+  views.erase(views.begin());
+  views.push_back(receiver.get());
+  BOOST_CHECK_EQUAL(source.get_read_index().desc, 10);
+  BOOST_CHECK_EQUAL(source.get_read_index().data, 10 * content_size);
+  BOOST_CHECK_EQUAL(receiver.outstanding(), 2);
+}
@@ -0,0 +1,33 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_NetworkRail
+#include <boost/test/unit_test.hpp>
+
+#include "NetworkRail.hpp"
+
+BOOST_AUTO_TEST_CASE(parse_test) {
+  NetworkRail rail("10.0.0.1@1");
+  BOOST_CHECK_EQUAL(rail.address(), "10.0.0.1");
+  BOOST_CHECK_EQUAL(rail.numa_node(), 1);
+
+  // the loopback interface is not attached to a NUMA node
+  NetworkRail loopback("127.0.0.1");
+  BOOST_CHECK_EQUAL(loopback.address(), "127.0.0.1");
+  BOOST_CHECK_EQUAL(loopback.numa_node(), -1);
+
+  BOOST_CHECK_THROW(NetworkRail("@0"), std::runtime_error);
+  BOOST_CHECK_THROW(NetworkRail("10.0.0.1@x"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(select_test) {
+  std::vector<NetworkRail> rails{NetworkRail("ib0", 0), NetworkRail("ib1", 1),
+                                 NetworkRail("ib2", 1)};
+
+  auto local = NetworkRail::select(rails, 1);
+  BOOST_REQUIRE_EQUAL(local.size(), 2);
+  BOOST_CHECK_EQUAL(local[0].address(), "ib1");
+  BOOST_CHECK_EQUAL(local[1].address(), "ib2");
+
+  // no local rail or unknown node: use all rails
+  BOOST_CHECK_EQUAL(NetworkRail::select(rails, 2).size(), 3);
+  BOOST_CHECK_EQUAL(NetworkRail::select(rails, -1).size(), 3);
+}
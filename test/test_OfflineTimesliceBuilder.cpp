@@ -0,0 +1,141 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_OfflineTimesliceBuilder
+#include <boost/test/unit_test.hpp>
+
+#include "OfflineTimesliceBuilder.hpp"
+#include "StorableMicroslice.hpp"
+#include "Timeslice.hpp"
+#include <vector>
+
+namespace {
+
+/// Microslice source returning microslices with given indices. The first
+/// content byte is the microslice index divided by the length.
+class IndexSource : public fles::MicrosliceSource {
+public:
+  IndexSource(std::vector<uint64_t> indices, uint64_t length)
+      : indices_(std::move(indices)), length_(length) {}
+
+  bool eos() const override { return next_ >= indices_.size(); }
+
+private:
+  fles::Microslice* do_get() override {
+    if (eos()) {
+      return nullptr;
+    }
+    fles::MicrosliceDescriptor desc = fles::MicrosliceDescriptor();
+    desc.idx = indices_[next_++];
+    std::vector<uint8_t> content(16, static_cast<uint8_t>(desc.idx / length_));
+    desc.size = static_cast<uint32_t>(content.size());
+    return new fles::StorableMicroslice(desc, content);
+  }
+
+  std::vector<uint64_t> indices_;
+  uint64_t length_;
+  size_t next_ = 0;
+};
+
+/// Test sink storing all received timeslices.
+class RecordingSink : public fles::TimesliceSink {
+public:
+  void put(std::shared_ptr<const fles::Timeslice> timeslice) override {
+    timeslices.push_back(std::move(timeslice));
+  }
+
+  void end_stream() override { ended = true; }
+
+  std::vector<std::shared_ptr<const fles::Timeslice>> timeslices;
+  bool ended = false;
+};
+
+/// Microslice indices from first to last (exclusive) with a given length.
+std::vector<uint64_t> range(uint64_t first, uint64_t last, uint64_t length) {
+  std::vector<uint64_t> indices;
+  for (uint64_t idx = first; idx < last; idx += length) {
+    indices.push_back(idx);
+  }
+  return indices;
+}
+
+std::unique_ptr<fles::MicrosliceSource> source(std::vector<uint64_t> indices,
+                                               uint64_t length) {
+  return std::unique_ptr<fles::MicrosliceSource>(
+      new IndexSource(std::move(indices), length));
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(alignment_test) {
+  const uint64_t length = 100;
+  std::vector<std::unique_ptr<fles::MicrosliceSource>> sources;
+  // the second input starts later, the third ends earlier
+  sources.push_back(source(range(0, 10000, length), length));
+  sources.push_back(source(range(300, 10000, length), length));
+  sources.push_back(source(range(0, 5300, length), length));
+
+  RecordingSink sink;
+  OfflineTimesliceBuilder builder(std::move(sources), sink, 10, 2, 0, 4);
+  builder.run();
+
+  BOOST_CHECK_EQUAL(builder.microslice_length(), length);
+  BOOST_CHECK_EQUAL(builder.skipped(), 6);
+  BOOST_CHECK_EQUAL(builder.missing(), 0);
+  BOOST_CHECK_EQUAL(builder.misaligned(), 0);
+  BOOST_CHECK(sink.ended);
+
+  // the third input ends at position 49 (index 5200), the overlap of
+  // timeslice 4 would end at position 51
+  BOOST_REQUIRE_EQUAL(builder.timeslices(), 4);
+  BOOST_REQUIRE_EQUAL(sink.timeslices.size(), 4);
+  for (uint64_t ts = 0; ts < 4; ++ts) {
+    const fles::Timeslice& timeslice = *sink.timeslices[ts];
+    BOOST_CHECK_EQUAL(timeslice.index(), ts);
+    BOOST_CHECK_EQUAL(timeslice.num_core_microslices(), 10);
+    BOOST_REQUIRE_EQUAL(timeslice.num_components(), 3);
+    for (uint64_t c = 0; c < 3; ++c) {
+      BOOST_REQUIRE_EQUAL(timeslice.num_microslices(c), 12);
+      for (uint64_t m = 0; m < 12; ++m) {
+        uint64_t idx = 300 + (ts * 10 + m) * length;
+        BOOST_CHECK_EQUAL(timeslice.descriptor(c, m).idx, idx);
+        BOOST_CHECK_EQUAL(timeslice.content(c, m)[15], idx / length);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(missing_test) {
+  std::vector<uint64_t> gap = range(0, 100, 1);
+  gap.erase(gap.begin() + 15, gap.begin() + 18); // missing
+  gap.insert(gap.begin() + 30, 29);              // duplicate
+
+  std::vector<std::unique_ptr<fles::MicrosliceSource>> sources;
+  sources.push_back(source(range(0, 100, 1), 1));
+  sources.push_back(source(gap, 1));
+
+  RecordingSink sink;
+  OfflineTimesliceBuilder builder(std::move(sources), sink, 10, 1, 1, 2);
+  builder.run(5);
+
+  BOOST_CHECK_EQUAL(builder.timeslices(), 5);
+  BOOST_CHECK_EQUAL(builder.missing(), 3);
+  BOOST_CHECK_EQUAL(builder.misaligned(), 1);
+  BOOST_REQUIRE_EQUAL(sink.timeslices.size(), 5);
+  BOOST_CHECK_EQUAL(sink.timeslices[1]->num_microslices(0), 11);
+  BOOST_CHECK_EQUAL(sink.timeslices[1]->num_microslices(1), 8);
+  BOOST_CHECK_EQUAL(sink.timeslices[1]->descriptor(1, 5).idx, 18);
+  BOOST_CHECK_EQUAL(sink.timeslices[2]->num_microslices(1), 11);
+}
+
+BOOST_AUTO_TEST_CASE(empty_input_test) {
+  std::vector<std::unique_ptr<fles::MicrosliceSource>> sources;
+  sources.push_back(source(range(0, 100, 1), 1));
+  sources.push_back(source({}, 1));
+
+  RecordingSink sink;
+  OfflineTimesliceBuilder builder(std::move(sources), sink, 10, 1);
+  builder.run();
+
+  BOOST_CHECK_EQUAL(builder.timeslices(), 0);
+  BOOST_CHECK(sink.timeslices.empty());
+  BOOST_CHECK(sink.ended);
+}
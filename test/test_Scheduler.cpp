@@ -0,0 +1,91 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_Scheduler
+#include <boost/test/unit_test.hpp>
+
+#include "Scheduler.hpp"
+#include <thread>
+
+namespace {
+
+void run_for(Scheduler& scheduler, std::chrono::milliseconds duration) {
+  auto end = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < end) {
+    scheduler.timer();
+  }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(one_shot_test) {
+  Scheduler scheduler;
+  int count = 0;
+  Scheduler::Timer timer([&count] { ++count; });
+
+  scheduler.add(timer, std::chrono::milliseconds(300));
+  BOOST_CHECK(timer.active());
+  run_for(scheduler, std::chrono::milliseconds(200));
+  BOOST_CHECK_EQUAL(count, 0);
+  run_for(scheduler, std::chrono::milliseconds(200));
+  BOOST_CHECK_EQUAL(count, 1);
+  BOOST_CHECK(!timer.active());
+
+  // timers are reusable
+  scheduler.add(timer, std::chrono::milliseconds(0));
+  run_for(scheduler, std::chrono::milliseconds(5));
+  BOOST_CHECK_EQUAL(count, 2);
+}
+
+BOOST_AUTO_TEST_CASE(periodic_test) {
+  Scheduler scheduler;
+  int count = 0;
+  Scheduler::Timer timer([&count] { ++count; });
+
+  scheduler.add_periodic(timer, std::chrono::milliseconds(10));
+  run_for(scheduler, std::chrono::milliseconds(205));
+  BOOST_CHECK_GE(count, 19);
+  BOOST_CHECK_LE(count, 21);
+  scheduler.cancel(timer);
+  BOOST_CHECK(!timer.active());
+  run_for(scheduler, std::chrono::milliseconds(20));
+  BOOST_CHECK_LE(count, 21);
+}
+
+BOOST_AUTO_TEST_CASE(cancel_test) {
+  Scheduler scheduler;
+  int count = 0;
+  Scheduler::Timer first([&count] { ++count; });
+  Scheduler::Timer second([&count] { count += 10; });
+  // a long-running timer in a higher level of the wheel
+  Scheduler::Timer third([&count] { count += 100; });
+
+  scheduler.add(first, std::chrono::milliseconds(1));
+  scheduler.add(second, std::chrono::milliseconds(1));
+  scheduler.add(third, std::chrono::hours(1));
+  scheduler.cancel(first);
+  run_for(scheduler, std::chrono::milliseconds(10));
+  BOOST_CHECK_EQUAL(count, 10);
+  BOOST_CHECK(third.active());
+}
+
+BOOST_AUTO_TEST_CASE(periodic_after_idle_test) {
+  Scheduler scheduler;
+  int count = 0;
+  Scheduler::Timer timer([&count] { ++count; });
+
+  // the first period starts when the timer is added, not at the last call
+  // to timer()
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  scheduler.add_periodic(timer, std::chrono::milliseconds(100));
+  scheduler.timer();
+  BOOST_CHECK_EQUAL(count, 0);
+  run_for(scheduler, std::chrono::milliseconds(150));
+  BOOST_CHECK_EQUAL(count, 1);
+
+  // missed periods are skipped after a stall
+  std::this_thread::sleep_for(std::chrono::milliseconds(250));
+  scheduler.timer();
+  BOOST_CHECK_EQUAL(count, 2);
+  scheduler.timer();
+  BOOST_CHECK_EQUAL(count, 2);
+  BOOST_CHECK(timer.active());
+}
@@ -0,0 +1,79 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_SchedulingPolicy
+#include <boost/test/unit_test.hpp>
+
+#include "SchedulingPolicy.hpp"
+
+BOOST_AUTO_TEST_CASE(round_robin_test) {
+  auto policy = SchedulingPolicy::create("round-robin", 3);
+  for (uint64_t ts = 0; ts < 10; ++ts) {
+    BOOST_CHECK_EQUAL(policy->target(ts), static_cast<int>(ts % 3));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(weighted_test) {
+  auto policy = SchedulingPolicy::create("weighted:3,1,0", 3);
+  BOOST_CHECK_EQUAL(policy->description(), "weighted:3,1,0");
+
+  std::vector<int> count(3, 0);
+  for (uint64_t ts = 0; ts < 400; ++ts) {
+    ++count.at(policy->target(ts));
+  }
+  BOOST_CHECK_EQUAL(count[0], 300);
+  BOOST_CHECK_EQUAL(count[1], 100);
+  BOOST_CHECK_EQUAL(count[2], 0);
+
+  // interleaved, not in blocks
+  BOOST_CHECK_EQUAL(WeightedPolicy::table({2, 2}).at(1), 1);
+
+  BOOST_CHECK_THROW(SchedulingPolicy::create("weighted:1,1", 3),
+                    std::runtime_error);
+  BOOST_CHECK_THROW(SchedulingPolicy::create("weighted:0,0", 2),
+                    std::runtime_error);
+  BOOST_CHECK_THROW(SchedulingPolicy::create("unknown", 2),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(occupancy_test) {
+  const uint32_t num_cn = 2;
+  const uint64_t epoch_length = OccupancyPolicy::epoch_length(num_cn);
+  auto policy_a = SchedulingPolicy::create("occupancy", num_cn);
+  auto policy_b = SchedulingPolicy::create("occupancy", num_cn);
+  auto announcer_0 = SchedulingPolicy::create_announcer("occupancy", num_cn);
+  auto announcer_1 = SchedulingPolicy::create_announcer("occupancy", num_cn);
+  BOOST_REQUIRE(announcer_0 && announcer_1);
+  BOOST_CHECK(!SchedulingPolicy::create_announcer("round-robin", num_cn));
+
+  // the first epochs are known in advance
+  const uint64_t first_unknown = OccupancyPolicy::lookahead * epoch_length;
+  for (uint64_t ts = 0; ts < first_unknown; ++ts) {
+    BOOST_CHECK_EQUAL(policy_a->target(ts), static_cast<int>(ts % num_cn));
+  }
+  BOOST_CHECK_EQUAL(policy_a->target(first_unknown), -1);
+
+  // node 0 is empty, node 1 is full
+  announcer_0->update(0, 0.0);
+  announcer_1->update(0, 1.0);
+  BOOST_CHECK_EQUAL(announcer_0->announcement().weight[0],
+                    OccupancyPolicy::max_weight);
+  BOOST_CHECK_EQUAL(announcer_1->announcement().weight[0], 1);
+
+  // the schedule waits for all nodes
+  policy_a->on_announcement(0, announcer_0->announcement());
+  BOOST_CHECK_EQUAL(policy_a->target(first_unknown), -1);
+  policy_a->on_announcement(1, announcer_1->announcement());
+
+  // a later change does not affect announced epochs
+  policy_b->on_announcement(1, announcer_1->announcement());
+  announcer_0->update(epoch_length, 1.0);
+  policy_b->on_announcement(0, announcer_0->announcement());
+
+  std::vector<int> count(num_cn, 0);
+  for (uint64_t ts = first_unknown; ts < first_unknown + epoch_length; ++ts) {
+    int target = policy_a->target(ts);
+    BOOST_CHECK_EQUAL(policy_b->target(ts), target);
+    ++count.at(target);
+  }
+  BOOST_CHECK(count[1] > 0);
+  BOOST_CHECK(count[0] > 4 * count[1]);
+}
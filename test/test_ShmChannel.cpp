@@ -0,0 +1,91 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_ShmChannel
+#include <boost/test/unit_test.hpp>
+
+#include "shm_channel_client.hpp"
+#include "shm_device_client.hpp"
+#include "shm_device_provider.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace {
+
+const std::string shm_identifier = "test_ShmChannel";
+
+using channel_client = shm_channel_client<fles::MicrosliceDescriptor, uint8_t>;
+
+void check_index(DualIndex index, uint64_t desc, uint64_t data) {
+  BOOST_CHECK_EQUAL(index.desc, desc);
+  BOOST_CHECK_EQUAL(index.data, data);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(several_readers_test) {
+  flib_shm_device_provider provider(shm_identifier, 1, 16, 8);
+  auto* channel = provider.channels().at(0);
+  channel->set_write_index({100, 10000});
+
+  auto device = std::make_shared<flib_shm_device_client>(shm_identifier);
+  std::unique_ptr<channel_client> fast(new channel_client(device, 0));
+  std::unique_ptr<channel_client> slow(new channel_client(device, 0));
+  channel_client tap(device, 0, true);
+  check_index(channel->get_read_index(), 0, 0);
+
+  // the read index follows the slower required reader
+  fast->set_read_index({40, 4000});
+  slow->set_read_index({20, 2000});
+  check_index(channel->get_read_index(), 20, 2000);
+  slow->set_read_index({60, 6000});
+  check_index(channel->get_read_index(), 40, 4000);
+
+  // the lossy reader never holds back the read index, it is advanced to the
+  // released data once it falls behind
+  check_index(tap.get_read_index(), 40, 4000);
+  tap.set_read_index({100, 10000});
+  check_index(channel->get_read_index(), 40, 4000);
+  check_index(tap.get_read_index(), 100, 10000);
+
+  // a disconnecting reader releases the data it has consumed
+  fast.reset();
+  check_index(channel->get_read_index(), 60, 6000);
+  slow->set_read_index({80, 8000});
+  slow.reset();
+  check_index(channel->get_read_index(), 80, 8000);
+
+  // a new reader starts at the oldest data not yet released
+  channel_client late(device, 0);
+  check_index(late.get_read_index(), 80, 8000);
+}
+
+BOOST_AUTO_TEST_CASE(connect_during_update_test) {
+  flib_shm_device_provider provider(shm_identifier, 1, 16, 8);
+  auto* channel = provider.channels().at(0);
+  channel->set_write_index({1 << 20, 1 << 20});
+
+  auto device = std::make_shared<flib_shm_device_client>(shm_identifier);
+  channel_client leader(device, 0);
+
+  // the writer updates the read index continuously, without the lock
+  std::atomic<bool> stop{false};
+  std::thread writer([&] {
+    while (!stop) {
+      channel->get_read_index();
+    }
+  });
+
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    leader.set_read_index({i * 2, i * 2});
+    channel_client reader(device, 0);
+    DualIndex start = reader.get_read_index();
+    leader.set_read_index({i * 2 + 1, i * 2 + 1});
+    // the data of the new reader must not have been released
+    DualIndex released = channel->get_read_index();
+    BOOST_REQUIRE_LE(released.desc, start.desc);
+    BOOST_REQUIRE_LE(released.data, start.data);
+  }
+
+  stop = true;
+  writer.join();
+}
@@ -0,0 +1,87 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_ShmTransport
+#include <boost/test/unit_test.hpp>
+
+#include "ComponentSenderShm.hpp"
+#include "FlesnetPatternGenerator.hpp"
+#include "TimesliceBuilderShm.hpp"
+#include "TimesliceReceiver.hpp"
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const std::string shm_identifier = "test_ShmTransport_";
+
+const uint32_t timeslice_size = 10;
+const uint32_t overlap_size = 1;
+const uint32_t max_timeslice_number = 20;
+
+/// Receive timeslices, check their contents and return their number.
+uint64_t consume(const std::string& identifier, uint32_t num_inputs) {
+  fles::TimesliceReceiver receiver(identifier);
+  uint64_t count = 0;
+  while (auto ts = receiver.get()) {
+    BOOST_REQUIRE_EQUAL(ts->num_components(), num_inputs);
+    for (uint64_t c = 0; c < num_inputs; ++c) {
+      BOOST_REQUIRE_EQUAL(ts->num_microslices(c),
+                          timeslice_size + overlap_size);
+      for (uint64_t m = 0; m < ts->num_microslices(c); ++m) {
+        BOOST_CHECK_EQUAL(ts->descriptor(c, m).idx,
+                          ts->index() * timeslice_size + m);
+        auto* content = reinterpret_cast<const uint64_t*>(ts->content(c, m));
+        BOOST_CHECK_EQUAL(content[0], c << 48);
+      }
+    }
+    ++count;
+  }
+  return count;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(transport_test) {
+  const uint32_t num_inputs = 2;
+  const uint32_t num_builders = 2;
+  volatile sig_atomic_t signal_status = 0;
+
+  ShmTransport transport(num_inputs, num_builders, timeslice_size);
+  std::vector<std::unique_ptr<InputBufferReadInterface>> sources;
+  for (uint32_t i = 0; i < num_inputs; ++i) {
+    sources.emplace_back(new FlesnetPatternGenerator(16, 8, i, 1024, true));
+    transport.set_input(i, *sources.back(), overlap_size);
+  }
+
+  std::vector<std::unique_ptr<TimesliceBuffer>> buffers;
+  std::vector<std::unique_ptr<TimesliceBuilderShm>> builders;
+  for (uint32_t b = 0; b < num_builders; ++b) {
+    buffers.emplace_back(new TimesliceBuffer(
+        shm_identifier + std::to_string(b), 17, 6, num_inputs));
+    builders.emplace_back(new TimesliceBuilderShm(
+        b, *buffers.back(), transport, max_timeslice_number, &signal_status));
+  }
+  std::vector<std::unique_ptr<ComponentSenderShm>> senders;
+  for (uint32_t i = 0; i < num_inputs; ++i) {
+    senders.emplace_back(new ComponentSenderShm(
+        i, transport, max_timeslice_number, &signal_status));
+  }
+
+  std::vector<uint64_t> received(num_builders);
+  std::vector<std::thread> threads;
+  for (uint32_t b = 0; b < num_builders; ++b) {
+    threads.emplace_back([b, &received] {
+      received[b] = consume(shm_identifier + std::to_string(b), num_inputs);
+    });
+    threads.emplace_back(std::ref(*builders[b]));
+  }
+  for (auto& sender : senders) {
+    threads.emplace_back(std::ref(*sender));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(received.at(0) + received.at(1), max_timeslice_number);
+  BOOST_CHECK_EQUAL(transport.acked_timeslices(), max_timeslice_number);
+}
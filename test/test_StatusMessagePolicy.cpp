@@ -0,0 +1,40 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_StatusMessagePolicy
+#include <boost/test/unit_test.hpp>
+
+#include "StatusMessagePolicy.hpp"
+
+namespace {
+const auto no_delay = std::chrono::steady_clock::duration::zero();
+const auto long_delay = std::chrono::seconds(1);
+} // namespace
+
+BOOST_AUTO_TEST_CASE(idle_test) {
+  StatusMessagePolicy policy;
+  StatusMessagePolicy::Positions desc{10, 10, 10, 64};
+  StatusMessagePolicy::Positions data{1000, 1000, 1000, 4096};
+  BOOST_CHECK(!policy.due(desc, data, no_delay));
+  BOOST_CHECK(!policy.due(desc, data, long_delay));
+}
+
+BOOST_AUTO_TEST_CASE(threshold_test) {
+  StatusMessagePolicy policy;
+  StatusMessagePolicy::Positions desc{12, 10, 10, 64};
+  StatusMessagePolicy::Positions data{1200, 1000, 1000, 4096};
+  BOOST_CHECK(!policy.due(desc, data, no_delay));
+  BOOST_CHECK(policy.due(desc, data, long_delay));
+  desc.written = 10 + policy.desc_threshold;
+  BOOST_CHECK(policy.due(desc, data, no_delay));
+}
+
+BOOST_AUTO_TEST_CASE(low_space_test) {
+  StatusMessagePolicy policy;
+  // announced, but unacknowledged data: poll for acks after max_delay
+  StatusMessagePolicy::Positions desc{12, 12, 10, 64};
+  StatusMessagePolicy::Positions data{1200, 1200, 1000, 4096};
+  BOOST_CHECK(!policy.due(desc, data, no_delay));
+  BOOST_CHECK(policy.due(desc, data, long_delay));
+  // almost full data buffer: update on every turn
+  data.written = data.sent = 1000 + 4000;
+  BOOST_CHECK(policy.due(desc, data, no_delay));
+}
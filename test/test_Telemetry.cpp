@@ -0,0 +1,59 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_Telemetry
+#include <boost/test/unit_test.hpp>
+
+#include "Telemetry.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+BOOST_AUTO_TEST_CASE(buffer_test) {
+  TelemetryBuffer b;
+  b.set(100, 164, 256);
+  BOOST_CHECK_EQUAL(b.read.load(), 100);
+  BOOST_CHECK_EQUAL(b.write.load(), 164);
+  BOOST_CHECK_EQUAL(b.fill.load(), 0.25);
+}
+
+BOOST_AUTO_TEST_CASE(view_test) {
+  TelemetryChannel& c = Telemetry::get().add_channel("input 3");
+  c.add(1000, 2);
+  c.stalls.fetch_add(1);
+  c.desc.set(0, 8, 16);
+
+  std::string name = Telemetry::segment_name(getpid());
+  auto names = Telemetry::segment_names();
+  BOOST_CHECK(std::find(names.begin(), names.end(), name) != names.end());
+
+  TelemetryView view(name);
+  BOOST_CHECK(view.alive());
+  BOOST_CHECK_EQUAL(view.header().version, Telemetry::version);
+  BOOST_CHECK_EQUAL(view.header().pid, getpid());
+  BOOST_REQUIRE_GE(view.num_channels(), 1);
+
+  const TelemetryChannel& v = view.channel(view.num_channels() - 1);
+  BOOST_CHECK_EQUAL(std::strcmp(v.name, "input 3"), 0);
+  BOOST_CHECK_EQUAL(v.items.load(), 2);
+  BOOST_CHECK_EQUAL(v.bytes.load(), 1000);
+  BOOST_CHECK_EQUAL(v.stalls.load(), 1);
+  BOOST_CHECK_EQUAL(v.desc.fill.load(), 0.5);
+
+  // updates by the owner are visible through the view
+  c.outstanding.store(5);
+  BOOST_CHECK_EQUAL(v.outstanding.load(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(long_name_test) {
+  std::string long_name(100, 'x');
+  Telemetry::get().add_channel(long_name);
+  TelemetryView view(Telemetry::segment_name(getpid()));
+  const TelemetryChannel& v = view.channel(view.num_channels() - 1);
+  BOOST_CHECK_EQUAL(std::string(v.name),
+                    long_name.substr(0, TelemetryChannel::max_name_length - 1));
+}
+
+BOOST_AUTO_TEST_CASE(missing_segment_test) {
+  BOOST_CHECK_THROW(TelemetryView("flesmon.nonexistent"), std::exception);
+}
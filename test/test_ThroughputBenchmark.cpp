@@ -0,0 +1,106 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_ThroughputBenchmark
+#include <boost/test/unit_test.hpp>
+
+#include "SyntheticTimesliceSource.hpp"
+#include "ThroughputBenchmark.hpp"
+#include <vector>
+
+namespace {
+
+/// Test sink recording the indices of all received timeslices.
+class RecordingSink : public fles::TimesliceSink {
+public:
+  void put(std::shared_ptr<const fles::Timeslice> timeslice) override {
+    indices.push_back(timeslice->index());
+  }
+
+  void end_stream() override { ended = true; }
+
+  std::vector<uint64_t> indices;
+  bool ended = false;
+};
+
+SyntheticTimesliceParameters test_parameters() {
+  SyntheticTimesliceParameters par;
+  par.num_components = 3;
+  par.microslice_size = 1000;
+  par.core_microslices = 10;
+  par.overlap_microslices = 2;
+  par.num_timeslices = 5;
+  return par;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(synthetic_source_test) {
+  SyntheticTimesliceSource source(test_parameters());
+
+  for (uint64_t i = 0; i < 5; ++i) {
+    BOOST_REQUIRE(!source.eos());
+    auto timeslice = source.get();
+    BOOST_REQUIRE(timeslice);
+    BOOST_CHECK_EQUAL(timeslice->index(), i);
+    BOOST_CHECK_EQUAL(timeslice->num_components(), 3);
+    BOOST_CHECK_EQUAL(timeslice->num_core_microslices(), 10);
+    BOOST_CHECK_EQUAL(item_size(*timeslice), source.timeslice_size());
+    for (uint64_t c = 0; c < timeslice->num_components(); ++c) {
+      BOOST_REQUIRE_EQUAL(timeslice->num_microslices(c), 12);
+      for (uint64_t m = 0; m < 12; ++m) {
+        const auto& desc = timeslice->descriptor(c, m);
+        BOOST_CHECK_EQUAL(desc.eq_id, c);
+        BOOST_CHECK_EQUAL(desc.idx, i * 10 + m);
+        BOOST_CHECK_EQUAL(desc.size, 1000);
+        BOOST_CHECK_EQUAL(timeslice->content(c, m)[999], 999 % 256);
+      }
+    }
+  }
+  BOOST_CHECK(source.eos());
+  BOOST_CHECK(!source.get());
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_source_test) {
+  SyntheticTimesliceSource source(test_parameters());
+
+  ThroughputResult result = benchmark_source(source);
+  BOOST_CHECK_EQUAL(result.items, 5);
+  BOOST_CHECK_EQUAL(result.bytes, 5 * source.timeslice_size());
+  BOOST_CHECK_EQUAL(result.latency_histogram.count(), 5);
+  BOOST_CHECK_GT(result.items_per_second(), 0);
+  BOOST_CHECK_GT(result.gigabytes_per_second(), 0);
+
+  SyntheticTimesliceSource limited_source(test_parameters());
+  BOOST_CHECK_EQUAL(benchmark_source(limited_source, 2).items, 2);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_sink_test) {
+  SyntheticTimesliceSource generator(test_parameters());
+  RecordingSink sink;
+
+  ThroughputResult result = benchmark_sink(sink, generator, 4);
+  BOOST_CHECK_EQUAL(result.items, 4);
+  BOOST_CHECK_EQUAL(result.bytes, 4 * generator.timeslice_size());
+  BOOST_REQUIRE_EQUAL(sink.indices.size(), 4);
+  for (uint64_t i = 0; i < 4; ++i) {
+    BOOST_CHECK_EQUAL(sink.indices[i], i);
+  }
+  BOOST_CHECK(sink.ended);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_batch_test) {
+  SyntheticTimesliceSource source(test_parameters());
+  ThroughputResult result = benchmark_source(source, 4, 3);
+  BOOST_CHECK_EQUAL(result.items, 4);
+  BOOST_CHECK_EQUAL(result.bytes, 4 * source.timeslice_size());
+  BOOST_CHECK_EQUAL(result.latency_histogram.count(), 4);
+
+  SyntheticTimesliceSource generator(test_parameters());
+  RecordingSink sink;
+  result = benchmark_sink(sink, generator, UINT64_MAX, 2);
+  BOOST_CHECK_EQUAL(result.items, 5);
+  BOOST_REQUIRE_EQUAL(sink.indices.size(), 5);
+  for (uint64_t i = 0; i < 5; ++i) {
+    BOOST_CHECK_EQUAL(sink.indices[i], i);
+  }
+  BOOST_CHECK(sink.ended);
+}
@@ -0,0 +1,172 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TimesliceBuffer
+#include <boost/test/unit_test.hpp>
+
+#include "TimesliceBuffer.hpp"
+#include "TimesliceReceiver.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+const std::string shm_identifier = "test_TimesliceBuffer_";
+
+fles::TimesliceWorkItem work_item(TimesliceBuffer& tsb, uint64_t ts_pos) {
+  fles::TimesliceComponentDescriptor& desc = tsb.get_desc(0, ts_pos);
+  desc.ts_num = ts_pos;
+  desc.offset = 0;
+  desc.size = 0;
+  desc.num_microslices = 0;
+  return {{ts_pos, ts_pos, 1, 1},
+          tsb.get_data_size_exp(),
+          tsb.get_desc_size_exp()};
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(shared_queue_test) {
+  TimesliceBuffer tsb(shm_identifier, 10, 4, 1);
+  fles::TimesliceReceiver receiver(shm_identifier);
+
+  tsb.send_work_item(work_item(tsb, 0));
+  tsb.send_end_work_item();
+
+  auto ts = receiver.get();
+  BOOST_REQUIRE(ts);
+  BOOST_CHECK_EQUAL(ts->index(), 0);
+  ts.reset();
+
+  fles::TimesliceCompletion c;
+  BOOST_REQUIRE(tsb.try_receive_completion(c));
+  BOOST_CHECK_EQUAL(c.ts_pos, 0);
+  BOOST_CHECK_EQUAL(c.consumer_index, UINT32_MAX);
+  BOOST_CHECK_EQUAL(tsb.latency_histogram().count(), 1);
+
+  BOOST_CHECK(!receiver.get());
+  BOOST_CHECK(receiver.eos());
+}
+
+BOOST_AUTO_TEST_CASE(work_stealing_test) {
+  TimesliceBuffer tsb(shm_identifier, 10, 4, 1, 2, 1);
+  fles::TimesliceReceiver receiver(shm_identifier, 1);
+
+  // one item per consumer, the third one is held back
+  for (uint64_t ts_pos = 0; ts_pos < 3; ++ts_pos) {
+    tsb.send_work_item(work_item(tsb, ts_pos));
+  }
+  BOOST_CHECK_EQUAL(tsb.get_num_work_items(), 3);
+  BOOST_CHECK_EQUAL(tsb.consumer_statistics().at(0).in_flight, 1);
+  BOOST_CHECK_EQUAL(tsb.consumer_statistics().at(1).in_flight, 1);
+
+  // own queue first
+  auto ts = receiver.get();
+  BOOST_REQUIRE(ts);
+  BOOST_CHECK_EQUAL(ts->index(), 1);
+  ts.reset();
+
+  // the completion frees the consumer for the held back item
+  fles::TimesliceCompletion c;
+  BOOST_REQUIRE(tsb.try_receive_completion(c));
+  BOOST_CHECK_EQUAL(c.consumer_index, 1);
+  BOOST_CHECK_EQUAL(tsb.consumer_statistics().at(1).in_flight, 1);
+  BOOST_CHECK_EQUAL(tsb.consumer_statistics().at(1).dispatched, 2);
+
+  // then the other consumer's queue
+  std::vector<uint64_t> indices;
+  for (int i = 0; i < 2; ++i) {
+    ts = receiver.get();
+    BOOST_REQUIRE(ts);
+    indices.push_back(ts->index());
+    ts.reset();
+  }
+  BOOST_CHECK_EQUAL(indices.at(0), 2);
+  BOOST_CHECK_EQUAL(indices.at(1), 0);
+
+  int completions = 0;
+  while (tsb.try_receive_completion(c)) {
+    BOOST_CHECK_EQUAL(c.consumer_index, 1);
+    ++completions;
+  }
+  BOOST_CHECK_EQUAL(completions, 2);
+
+  const auto& stats = tsb.consumer_statistics();
+  BOOST_CHECK_EQUAL(stats.at(0).in_flight, 0);
+  BOOST_CHECK_EQUAL(stats.at(0).completed, 0);
+  BOOST_CHECK_EQUAL(stats.at(1).in_flight, 0);
+  BOOST_CHECK_EQUAL(stats.at(1).completed, 3);
+  BOOST_CHECK_EQUAL(stats.at(1).stolen, 1);
+
+  tsb.send_end_work_item();
+  BOOST_CHECK(!receiver.get());
+  BOOST_CHECK(receiver.eos());
+}
+
+BOOST_AUTO_TEST_CASE(in_flight_limit_test) {
+  const uint64_t num_items = 10;
+  TimesliceBuffer tsb(shm_identifier, 10, 4, 1, 2, 2);
+  fles::TimesliceReceiver receiver(shm_identifier, 0);
+
+  for (uint64_t ts_pos = 0; ts_pos < num_items; ++ts_pos) {
+    tsb.send_work_item(work_item(tsb, ts_pos));
+  }
+  BOOST_CHECK_EQUAL(tsb.get_num_work_items(), num_items);
+
+  // a single consumer works through all items, the limit holds throughout
+  uint64_t completions = 0;
+  while (completions < num_items) {
+    for (const auto& cs : tsb.consumer_statistics()) {
+      BOOST_CHECK_LE(cs.in_flight, 2);
+    }
+    auto ts = receiver.get();
+    BOOST_REQUIRE(ts);
+    ts.reset();
+    fles::TimesliceCompletion c;
+    while (tsb.try_receive_completion(c)) {
+      ++completions;
+    }
+  }
+
+  const auto& stats = tsb.consumer_statistics();
+  BOOST_CHECK_EQUAL(stats.at(0).completed, num_items);
+  BOOST_CHECK_EQUAL(stats.at(0).stolen, stats.at(1).dispatched);
+  BOOST_CHECK_EQUAL(stats.at(0).dispatched + stats.at(1).dispatched,
+                    num_items);
+  BOOST_CHECK_EQUAL(tsb.get_num_work_items(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(unindexed_receiver_test) {
+  const uint64_t num_items = 4;
+  TimesliceBuffer tsb(shm_identifier, 10, 4, 1, 2, 1);
+  fles::TimesliceReceiver receiver(shm_identifier);
+
+  for (uint64_t ts_pos = 0; ts_pos < num_items; ++ts_pos) {
+    tsb.send_work_item(work_item(tsb, ts_pos));
+  }
+
+  // a receiver without consumer index takes work from all consumer queues
+  std::vector<uint64_t> indices;
+  while (indices.size() < num_items) {
+    auto ts = receiver.get();
+    BOOST_REQUIRE(ts);
+    indices.push_back(ts->index());
+    ts.reset();
+    fles::TimesliceCompletion c;
+    while (tsb.try_receive_completion(c)) {
+      BOOST_CHECK_EQUAL(c.consumer_index, UINT32_MAX);
+    }
+  }
+  std::sort(indices.begin(), indices.end());
+  for (uint64_t ts_pos = 0; ts_pos < num_items; ++ts_pos) {
+    BOOST_CHECK_EQUAL(indices.at(ts_pos), ts_pos);
+  }
+
+  const auto& stats = tsb.consumer_statistics();
+  BOOST_CHECK_EQUAL(stats.at(0).completed + stats.at(1).completed,
+                    num_items);
+  BOOST_CHECK_EQUAL(stats.at(0).stolen + stats.at(1).stolen, 0);
+  BOOST_CHECK_EQUAL(tsb.get_num_work_items(), 0);
+
+  tsb.send_end_work_item();
+  BOOST_CHECK(!receiver.get());
+  BOOST_CHECK(receiver.eos());
+}
@@ -0,0 +1,97 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TimesliceProcessor
+#include <boost/test/unit_test.hpp>
+
+#include "TimesliceBuffer.hpp"
+#include "TimesliceProcessor.hpp"
+#include "TimesliceSinkRegistry.hpp"
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+const std::string shm_identifier = "test_TimesliceProcessor_";
+
+std::atomic<uint64_t> counted_timeslices{0};
+
+/// A sink counting the timeslices it receives.
+class CountingSink : public fles::TimesliceSink {
+public:
+  CountingSink(uint64_t increment, std::ostream& out)
+      : increment_(increment), out_(out) {}
+
+  void put(std::shared_ptr<const fles::Timeslice> item) override {
+    counted_timeslices += increment_;
+    out_ << "timeslice " << item->index() << std::endl;
+  }
+
+private:
+  uint64_t increment_;
+  std::ostream& out_;
+};
+
+TimesliceSinkRegistration
+    counter("counter", [](const std::string& args, uint32_t /* worker_index */,
+                          std::ostream& out) {
+      uint64_t increment = args.empty() ? 1 : std::stoull(args);
+      return std::unique_ptr<fles::TimesliceSink>(
+          new CountingSink(increment, out));
+    });
+
+fles::TimesliceWorkItem work_item(TimesliceBuffer& tsb, uint64_t ts_pos) {
+  fles::TimesliceComponentDescriptor& desc = tsb.get_desc(0, ts_pos);
+  desc.ts_num = ts_pos;
+  desc.offset = 0;
+  desc.size = 0;
+  desc.num_microslices = 0;
+  return {{ts_pos, ts_pos, 1, 1},
+          tsb.get_data_size_exp(),
+          tsb.get_desc_size_exp()};
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(registry_test) {
+  auto& registry = TimesliceSinkRegistry::get();
+  BOOST_CHECK(registry.contains("analyzer"));
+  BOOST_CHECK(registry.contains("counter"));
+
+  counted_timeslices = 0;
+  std::ostringstream out;
+  auto sink = registry.create("counter:3", 0, out);
+  BOOST_REQUIRE(sink);
+
+  BOOST_CHECK_EXCEPTION(
+      registry.create("no_such_sink:1", 0, out), std::runtime_error,
+      [](const std::runtime_error& e) {
+        return std::string(e.what()) == "unknown timeslice sink: no_such_sink";
+      });
+}
+
+BOOST_AUTO_TEST_CASE(processor_test) {
+  const uint64_t num_timeslices = 10;
+  TimesliceBuffer tsb(shm_identifier, 10, 4, 1);
+
+  counted_timeslices = 0;
+  TimesliceProcessor processor(shm_identifier, 0, "counter:2");
+  std::thread thread(std::ref(processor));
+
+  for (uint64_t ts_pos = 0; ts_pos < num_timeslices; ++ts_pos) {
+    tsb.send_work_item(work_item(tsb, ts_pos));
+  }
+  tsb.send_end_work_item();
+  thread.join();
+
+  BOOST_CHECK_EQUAL(processor.timeslice_count(), num_timeslices);
+  BOOST_CHECK_EQUAL(counted_timeslices, 2 * num_timeslices);
+
+  // all timeslices have been completed
+  uint64_t completions = 0;
+  fles::TimesliceCompletion c;
+  while (tsb.try_receive_completion(c)) {
+    ++completions;
+  }
+  BOOST_CHECK_EQUAL(completions, num_timeslices);
+}
@@ -0,0 +1,176 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TimesliceSinkPipeline
+#include <boost/test/unit_test.hpp>
+
+#include "StorableTimeslice.hpp"
+#include "TimesliceSinkPipeline.hpp"
+#include "log.hpp"
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Test sink recording the indices of all received timeslices.
+class RecordingSink : public fles::TimesliceSink {
+public:
+  RecordingSink(std::vector<uint64_t>& indices,
+                bool& ended,
+                std::chrono::microseconds delay)
+      : indices_(indices), ended_(ended), delay_(delay) {}
+
+  void put(std::shared_ptr<const fles::Timeslice> timeslice) override {
+    std::this_thread::sleep_for(delay_);
+    indices_.push_back(timeslice->index());
+  }
+
+  void end_stream() override { ended_ = true; }
+
+private:
+  std::vector<uint64_t>& indices_;
+  bool& ended_;
+  std::chrono::microseconds delay_;
+};
+
+/// Test sink failing on a given timeslice.
+class FailingSink : public fles::TimesliceSink {
+public:
+  explicit FailingSink(uint64_t fail_index) : fail_index_(fail_index) {}
+
+  void put(std::shared_ptr<const fles::Timeslice> timeslice) override {
+    if (timeslice->index() == fail_index_) {
+      throw std::runtime_error("sink failed");
+    }
+  }
+
+private:
+  uint64_t fail_index_;
+};
+
+/// Test sink writing a log line for each timeslice.
+class LoggingSink : public fles::TimesliceSink {
+public:
+  LoggingSink(std::ostream& out, std::string name)
+      : out_(out), name_(std::move(name)) {}
+
+  void put(std::shared_ptr<const fles::Timeslice> timeslice) override {
+    out_ << name_ << ": timeslice " << timeslice->index() << std::endl;
+    ++count_;
+  }
+
+  uint64_t count() const { return count_; }
+
+private:
+  std::ostream& out_;
+  std::string name_;
+  uint64_t count_ = 0;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(bounded_queue_test) {
+  BoundedQueue<int> queue(2);
+  BOOST_CHECK(queue.push(1));
+  BOOST_CHECK(queue.push(2));
+  BOOST_CHECK_EQUAL(queue.size(), 2);
+
+  std::thread consumer([&queue] {
+    int item;
+    queue.pop(item);
+  });
+  BOOST_CHECK(queue.push(3)); // waits for the consumer
+  consumer.join();
+
+  queue.close();
+  BOOST_CHECK(!queue.push(4));
+  int item = 0;
+  BOOST_CHECK(queue.pop(item));
+  BOOST_CHECK_EQUAL(item, 2);
+  BOOST_CHECK(queue.pop(item));
+  BOOST_CHECK_EQUAL(item, 3);
+  BOOST_CHECK(!queue.pop(item));
+}
+
+BOOST_AUTO_TEST_CASE(pipeline_test) {
+  std::vector<uint64_t> fast_indices;
+  std::vector<uint64_t> slow_indices;
+  bool fast_ended = false;
+  bool slow_ended = false;
+  std::weak_ptr<const fles::Timeslice> last;
+
+  TimesliceSinkPipeline pipeline(2, "test");
+  pipeline.add(std::unique_ptr<fles::TimesliceSink>(new RecordingSink(
+                   fast_indices, fast_ended, std::chrono::microseconds(0))),
+               "fast");
+  pipeline.add(std::unique_ptr<fles::TimesliceSink>(new RecordingSink(
+                   slow_indices, slow_ended, std::chrono::microseconds(500))),
+               "slow");
+  BOOST_CHECK_EQUAL(pipeline.size(), 2);
+
+  const uint64_t n = 20;
+  for (uint64_t i = 0; i < n; ++i) {
+    std::shared_ptr<const fles::Timeslice> ts =
+        std::make_shared<fles::StorableTimeslice>(1, i);
+    last = ts;
+    pipeline.put(ts);
+  }
+  pipeline.end_stream();
+
+  // the timeslices are released once all sinks are done with them
+  BOOST_CHECK(last.expired());
+  BOOST_REQUIRE_EQUAL(fast_indices.size(), n);
+  BOOST_REQUIRE_EQUAL(slow_indices.size(), n);
+  for (uint64_t i = 0; i < n; ++i) {
+    BOOST_CHECK_EQUAL(fast_indices[i], i);
+    BOOST_CHECK_EQUAL(slow_indices[i], i);
+  }
+  BOOST_CHECK(fast_ended);
+  BOOST_CHECK(slow_ended);
+}
+
+BOOST_AUTO_TEST_CASE(error_test) {
+  std::vector<uint64_t> indices;
+  bool ended = false;
+
+  TimesliceSinkPipeline pipeline(1, "test");
+  pipeline.add(std::unique_ptr<fles::TimesliceSink>(new RecordingSink(
+                   indices, ended, std::chrono::microseconds(0))),
+               "ok");
+  pipeline.add(std::unique_ptr<fles::TimesliceSink>(new FailingSink(3)),
+               "failing");
+
+  // the error is reported by a later put() or by close()
+  auto run = [&pipeline] {
+    for (uint64_t i = 0; i < 100; ++i) {
+      pipeline.put(std::make_shared<fles::StorableTimeslice>(1, i));
+    }
+    pipeline.close();
+  };
+  BOOST_CHECK_THROW(run(), std::runtime_error);
+  BOOST_CHECK_GE(indices.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(logging_sinks_test) {
+  // the sinks run concurrently, so each needs its own log stream
+  logging::OstreamLog log_a(debug);
+  logging::OstreamLog log_b(debug);
+  auto* sink_a = new LoggingSink(log_a.stream, "a");
+  auto* sink_b = new LoggingSink(log_b.stream, "b");
+
+  TimesliceSinkPipeline pipeline(4, "test");
+  pipeline.add(std::unique_ptr<fles::TimesliceSink>(sink_a), "a");
+  pipeline.add(std::unique_ptr<fles::TimesliceSink>(sink_b), "b");
+
+  const uint64_t n = 200;
+  for (uint64_t i = 0; i < n; ++i) {
+    pipeline.put(std::make_shared<fles::StorableTimeslice>(1, i));
+  }
+  pipeline.end_stream();
+
+  BOOST_CHECK_EQUAL(sink_a->count(), n);
+  BOOST_CHECK_EQUAL(sink_b->count(), n);
+}
@@ -0,0 +1,75 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TraceRecorder
+#include <boost/test/unit_test.hpp>
+
+#include "TraceRecorder.hpp"
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+BOOST_AUTO_TEST_CASE(write_read_test) {
+  std::string file = TraceRecorder::filename("test_TraceRecorder", "i0");
+  BOOST_CHECK_EQUAL(file, "test_TraceRecorder.i0.trace");
+  {
+    TraceRecorder trace(file);
+    trace.record(0, TraceStage::InputWritten, 3);
+    trace.record(0, TraceStage::SendPosted, 3);
+    trace.flush();
+    trace.record(1, TraceStage::SendCompleted, 3);
+  }
+  auto records = TraceRecorder::read(file);
+  BOOST_REQUIRE_EQUAL(records.size(), 3);
+  BOOST_CHECK_EQUAL(records[0].timeslice, 0);
+  BOOST_CHECK_EQUAL(records[0].stage,
+                    static_cast<uint32_t>(TraceStage::InputWritten));
+  BOOST_CHECK_EQUAL(records[0].component, 3);
+  BOOST_CHECK_EQUAL(records[2].timeslice, 1);
+  BOOST_CHECK_EQUAL(records[2].stage,
+                    static_cast<uint32_t>(TraceStage::SendCompleted));
+  BOOST_CHECK(records[0].time <= records[1].time);
+  BOOST_CHECK(records[1].time <= records[2].time);
+  std::remove(file.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(sampling_and_capacity_test) {
+  std::string file = TraceRecorder::filename("test_TraceRecorder", "c0");
+  {
+    TraceRecorder trace(file, 4, 3);
+    BOOST_CHECK(trace.enabled(0));
+    BOOST_CHECK(!trace.enabled(3));
+    BOOST_CHECK(trace.enabled(8));
+    for (uint64_t ts = 0; ts < 20; ++ts) {
+      trace.record(ts, TraceStage::BuilderComplete, 0);
+    }
+  }
+  auto records = TraceRecorder::read(file);
+  BOOST_REQUIRE_EQUAL(records.size(), 3);
+  BOOST_CHECK_EQUAL(records[0].timeslice, 0);
+  BOOST_CHECK_EQUAL(records[1].timeslice, 4);
+  BOOST_CHECK_EQUAL(records[2].timeslice, 8);
+  std::remove(file.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(periodic_flush_test) {
+  std::string file = TraceRecorder::filename("test_TraceRecorder", "c1");
+  {
+    TraceRecorder trace(file, 1, 4);
+    for (uint64_t ts = 0; ts < 20; ++ts) {
+      trace.record(ts, TraceStage::WorkItemQueued, 1);
+      if (trace.should_flush()) {
+        trace.flush();
+      }
+    }
+  }
+  auto records = TraceRecorder::read(file);
+  BOOST_REQUIRE_EQUAL(records.size(), 20);
+  for (uint64_t ts = 0; ts < 20; ++ts) {
+    BOOST_CHECK_EQUAL(records[ts].timeslice, ts);
+  }
+  std::remove(file.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(invalid_file_test) {
+  BOOST_CHECK_THROW(TraceRecorder::read("test_TraceRecorder.nonexistent"),
+                    std::runtime_error);
+}
@@ -0,0 +1,81 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_WorkerGroup
+#include <boost/test/unit_test.hpp>
+
+#include "WorkerGroup.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+class CountingWorker : public ConnectionGroupWorker {
+public:
+  CountingWorker(int steps, std::string& trace, char id)
+      : steps_(steps), trace_(trace), id_(id) {}
+
+  void operator()() override {
+    start();
+    while (step()) {
+    }
+    stop();
+  }
+
+  void start() override { started = true; }
+
+  bool step() override {
+    trace_ += id_;
+    if (--steps_ == 0) {
+      throw_if_requested();
+    }
+    return steps_ > 0;
+  }
+
+  void stop() override { stopped = true; }
+
+  bool started = false;
+  bool stopped = false;
+  bool fail = false;
+
+private:
+  void throw_if_requested() const {
+    if (fail) {
+      throw std::runtime_error("worker failed");
+    }
+  }
+
+  int steps_;
+  std::string& trace_;
+  char id_;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(interleave_test) {
+  std::string trace;
+  CountingWorker a(3, trace, 'a');
+  CountingWorker b(1, trace, 'b');
+  WorkerGroup group;
+  group.add(a);
+  group.add(b);
+  BOOST_CHECK_EQUAL(group.size(), 2);
+
+  group();
+  BOOST_CHECK_EQUAL(trace, "abaa");
+  BOOST_CHECK(a.started && a.stopped);
+  BOOST_CHECK(b.started && b.stopped);
+}
+
+BOOST_AUTO_TEST_CASE(exception_test) {
+  std::string trace;
+  CountingWorker a(2, trace, 'a');
+  CountingWorker b(3, trace, 'b');
+  a.fail = true;
+  WorkerGroup group;
+  group.add(a);
+  group.add(b);
+
+  group();
+  BOOST_CHECK_EQUAL(trace, "ababb");
+  BOOST_CHECK(!a.stopped);
+  BOOST_CHECK(b.stopped);
+}
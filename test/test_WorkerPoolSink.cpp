@@ -0,0 +1,128 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_WorkerPoolSink
+#include <boost/test/unit_test.hpp>
+
+#include "WorkerPoolSink.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// Worker sink with an item-dependent processing time.
+class SlowSink : public fles::Sink<int> {
+public:
+  SlowSink(std::atomic<int>& processed, int fail_item = -1)
+      : processed_(processed), fail_item_(fail_item) {}
+
+  void put(std::shared_ptr<const int> item) override {
+    if (*item == fail_item_) {
+      throw std::runtime_error("worker failed");
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds((*item % 7) * 100));
+    ++processed_;
+  }
+
+private:
+  std::atomic<int>& processed_;
+  int fail_item_;
+};
+
+/// Ordered sink recording the received items.
+class RecordingSink : public fles::Sink<int> {
+public:
+  RecordingSink(std::vector<int>& items, bool& ended)
+      : items_(items), ended_(ended) {}
+
+  void put(std::shared_ptr<const int> item) override {
+    items_.push_back(*item);
+  }
+
+  void end_stream() override { ended_ = true; }
+
+private:
+  std::vector<int>& items_;
+  bool& ended_;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(reorder_test) {
+  std::atomic<int> processed{0};
+  std::vector<int> items;
+  bool ended = false;
+  const int n = 200;
+  const size_t window = 8;
+
+  fles::WorkerPoolSink<int> pool(
+      4,
+      [&processed](uint32_t) {
+        return std::unique_ptr<fles::Sink<int>>(new SlowSink(processed));
+      },
+      window);
+  pool.set_ordered_sink(
+      std::unique_ptr<fles::Sink<int>>(new RecordingSink(items, ended)));
+  BOOST_CHECK_EQUAL(pool.size(), 4);
+
+  for (int i = 0; i < n; ++i) {
+    pool.put(std::make_shared<const int>(i));
+  }
+  pool.end_stream();
+
+  BOOST_CHECK_EQUAL(processed, n);
+  BOOST_REQUIRE_EQUAL(items.size(), n);
+  for (int i = 0; i < n; ++i) {
+    BOOST_CHECK_EQUAL(items[static_cast<size_t>(i)], i);
+  }
+  BOOST_CHECK(ended);
+  BOOST_CHECK_LE(pool.max_reorder_depth(), window);
+}
+
+BOOST_AUTO_TEST_CASE(unordered_test) {
+  std::atomic<int> processed{0};
+  {
+    fles::WorkerPoolSink<int> pool(
+        3,
+        [&processed](uint32_t) {
+          return std::unique_ptr<fles::Sink<int>>(new SlowSink(processed));
+        },
+        0);
+    for (int i = 0; i < 50; ++i) {
+      pool.put(std::make_shared<const int>(i));
+    }
+    pool.close();
+  }
+  BOOST_CHECK_EQUAL(processed, 50);
+}
+
+BOOST_AUTO_TEST_CASE(error_test) {
+  std::atomic<int> processed{0};
+  std::vector<int> items;
+  bool ended = false;
+
+  fles::WorkerPoolSink<int> pool(
+      2,
+      [&processed](uint32_t) {
+        return std::unique_ptr<fles::Sink<int>>(new SlowSink(processed, 10));
+      },
+      4);
+  pool.set_ordered_sink(
+      std::unique_ptr<fles::Sink<int>>(new RecordingSink(items, ended)));
+
+  // the error is reported by a later put() or by close()
+  auto run = [&pool] {
+    for (int i = 0; i < 100; ++i) {
+      pool.put(std::make_shared<const int>(i));
+    }
+    pool.end_stream();
+  };
+  BOOST_CHECK_THROW(run(), std::runtime_error);
+  BOOST_CHECK(!ended);
+  BOOST_CHECK_LE(items.size(), 10);
+  for (size_t i = 0; i < items.size(); ++i) {
+    BOOST_CHECK_EQUAL(items[i], static_cast<int>(i));
+  }
+}
@@ -0,0 +1,26 @@
+#!/bin/bash
+
+# run flib_server on an emulated FLIB and read from it using mstool
+
+set -o errexit
+set -o pipefail
+
+./flib_server --emulate 2 --emu-rate 100000 -o test_flib_server_emu \
+	--data-buffer-size-exp 20 --desc-buffer-size-exp 10 &
+server_pid=$!
+sleep 0.5
+
+N=`./mstool -I test_flib_server_emu -c 1 -n 1000 -a 2>&1 | grep total | sed -e 's/.* //'`
+echo "microslices read from emulated link: $N"
+
+kill -INT $server_pid
+echo "waiting for server..."
+wait $server_pid
+
+if [ "$N" -ne 1000 ]; then
+	echo "not ok"
+	exit 1
+else
+	echo "ok"
+	exit 0
+fi
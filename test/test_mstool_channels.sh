@@ -0,0 +1,21 @@
+#!/bin/bash
+
+set -o errexit
+set -o pipefail
+
+# record three pattern generator channels to per-channel archives
+./mstool -p 1 -c 0 1 2 -n 1000 -o test_mstool_channels_%c.msa
+
+# read them back in a single process
+N=`./mstool -i test_mstool_channels_%c.msa -c 0 1 2 -a 2>&1 | grep total | sed -e 's/.* //'`
+echo "microslices in output files: $N"
+
+rm -f test_mstool_channels_?.msa
+
+if [ "$N" -ne 3000 ]; then
+	echo "not ok"
+	exit 1
+else
+	echo "ok"
+	exit 0
+fi